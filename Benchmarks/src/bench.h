@@ -0,0 +1,71 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+/**
+ * @file bench.h
+ * @brief Minimal benchmark registry and timing helpers of the engine benchmarks.
+ *
+ * Benchmarks are free functions declared with GEM_BENCHMARK, registered before main() runs.
+ * Each one prints its own table; build them in Release, the numbers of a Debug build are meaningless.
+ */
+
+namespace Gem {
+    namespace Bench {
+
+        /**
+         * @struct Benchmark
+         * @brief A registered benchmark.
+         */
+        struct Benchmark {
+            const char* name;   ///< Name printed in the report and matched by the filter.
+            void (*run)();      ///< Benchmark body.
+        };
+
+        /**
+         * @brief Gets every registered benchmark, in registration order.
+         */
+        std::vector<Benchmark>& getBenchmarks();
+
+        /**
+         * @brief Registers a benchmark from a static initializer, see GEM_BENCHMARK.
+         */
+        struct Registrar {
+            Registrar(const char* name, void (*run)()) {
+                getBenchmarks().push_back({ name, run });
+            }
+        };
+
+        /**
+         * @brief Times a function several times and keeps the fastest run, the least disturbed by the system.
+         * @param function The function to time.
+         * @param repeats The number of runs.
+         * @return The fastest run, in milliseconds.
+         */
+        template<typename Function>
+        double measureMillis(Function&& function, int repeats = 5) {
+            double best = std::numeric_limits<double>::max();
+
+            for (int i = 0; i < repeats; ++i) {
+                const auto start = std::chrono::steady_clock::now();
+                function();
+                const auto end = std::chrono::steady_clock::now();
+
+                const double millis = std::chrono::duration<double, std::milli>(end - start).count();
+                if (millis < best) {
+                    best = millis;
+                }
+            }
+            return best;
+        }
+
+    } // namespace Bench
+} // namespace Gem
+
+#define GEM_BENCHMARK(name) \
+    static void name(); \
+    static const ::Gem::Bench::Registrar name##Registrar_(#name, &name); \
+    static void name()
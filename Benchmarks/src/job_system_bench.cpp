@@ -0,0 +1,95 @@
+#include "bench.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include <Gem/Core/job_system.h>
+
+using namespace Gem::Core;
+
+namespace {
+
+    /**
+     * Gets the worker counts to compare, from one to one per hardware core.
+     */
+    unsigned int getMaxWorkers() {
+        const unsigned int cores = std::thread::hardware_concurrency();
+        return (cores > 0) ? cores : 1;
+    }
+
+} // namespace
+
+/**
+ * Splits a compute-bound loop with parallelFor and reports the speedup over one worker.
+ * The thread waiting on the jobs helps, so each run uses one thread more than its workers.
+ */
+GEM_BENCHMARK(JobSystemParallelForScaling) {
+    constexpr size_t COUNT = size_t(1) << 20;
+    constexpr size_t BATCH = 4096;
+
+    std::vector<double> values(COUNT);
+    double baseline = 0.0;
+
+    std::printf("%8s %10s %8s %11s\n", "workers", "ms", "speedup", "efficiency");
+    for (unsigned int workers = 1; workers <= getMaxWorkers(); ++workers) {
+        JobSystem jobs(workers);
+
+        const double millis = Gem::Bench::measureMillis([&]() {
+            const JobHandle handle = jobs.parallelFor(COUNT, BATCH, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    double x = static_cast<double>(i);
+                    for (int k = 0; k < 16; ++k) {
+                        x = std::sqrt(x + k);
+                    }
+                    values[i] = x;
+                }
+            });
+            jobs.wait(handle);
+        });
+
+        if (workers == 1) {
+            baseline = millis;
+        }
+        // Efficiency compares the speedup to the threads added: the baseline already runs on two
+        const double speedup = baseline / millis;
+        const double efficiency = speedup * 2.0 / (workers + 1);
+        std::printf("%8u %10.2f %8.2f %10.0f%%\n", workers, millis, speedup, 100.0 * efficiency);
+    }
+}
+
+/**
+ * Runs independent chains of dependent jobs and reports the cost per job.
+ * Each job only starts once the previous one of its chain is done, so this measures the
+ * scheduling and dependency overhead rather than the work.
+ */
+GEM_BENCHMARK(JobSystemDependencyChains) {
+    constexpr int CHAINS = 64;
+    constexpr int LENGTH = 256;
+
+    std::printf("%8s %10s %12s\n", "workers", "ms", "us per job");
+    for (unsigned int workers = 1; workers <= getMaxWorkers(); ++workers) {
+        JobSystem jobs(workers);
+        std::atomic<int> executed{ 0 };
+
+        const double millis = Gem::Bench::measureMillis([&]() {
+            std::vector<JobHandle> tails;
+            tails.reserve(CHAINS);
+
+            for (int chain = 0; chain < CHAINS; ++chain) {
+                JobHandle previous;
+                for (int link = 0; link < LENGTH; ++link) {
+                    previous = jobs.schedule([&executed]() {
+                        executed.fetch_add(1, std::memory_order_relaxed);
+                    }, previous);
+                }
+                tails.push_back(previous);
+            }
+
+            jobs.wait(jobs.schedule([]() {}, tails));
+        });
+
+        std::printf("%8u %10.2f %12.3f\n", workers, millis, 1000.0 * millis / (CHAINS * LENGTH));
+    }
+}
@@ -0,0 +1,34 @@
+#include "bench.h"
+
+#include <cstring>
+#include <iostream>
+
+namespace Gem {
+    namespace Bench {
+
+        std::vector<Benchmark>& getBenchmarks() {
+            static std::vector<Benchmark> benchmarks;
+            return benchmarks;
+        }
+
+    } // namespace Bench
+} // namespace Gem
+
+/**
+ * Runs every registered benchmark, or only those whose name contains the first argument.
+ */
+int main(int argc, char* argv[]) {
+    const char* filter = (argc > 1) ? argv[1] : nullptr;
+
+    for (const Gem::Bench::Benchmark& benchmark : Gem::Bench::getBenchmarks()) {
+        if (filter && !std::strstr(benchmark.name, filter)) {
+            continue;
+        }
+
+        std::cout << "== " << benchmark.name << std::endl;
+        benchmark.run();
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
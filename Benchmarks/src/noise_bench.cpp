@@ -0,0 +1,123 @@
+#include "bench.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+#include <glm/gtc/noise.hpp>
+#include <Gem/Math/noise.h>
+
+using namespace Gem::Math;
+
+namespace {
+
+    constexpr size_t SAMPLE_COUNT = 65536;
+    constexpr uint32_t GRID_LENGTH = 16;
+    constexpr int GRID_REPEATS = 64;
+
+    const char* getName(NoiseType type) {
+        switch (type) {
+        case NoiseType::Perlin:
+            return "perlin";
+        case NoiseType::Simplex:
+            return "simplex";
+        default:
+            return "value";
+        }
+    }
+
+    /**
+     * Converts a timed run into millions of samples per second. Everything runs on the calling
+     * thread, so this is also the throughput of one core.
+     */
+    double getMegaSamples(size_t samples, double millis) {
+        return static_cast<double>(samples) / (millis * 1000.0);
+    }
+
+} // namespace
+
+/**
+ * Times the batched noise functions against one sample at a time and against glm, on random
+ * positions and on chunk-sized fBm grids. Only speed is measured, NoiseBatchesMatchGlm checks the values.
+ */
+GEM_BENCHMARK(NoiseSamplesPerSecondPerCore) {
+    const Noise noise;
+
+    std::mt19937 random(3);
+    std::uniform_real_distribution<float> coordinate(-300.0f, 300.0f);
+
+    std::vector<float> x(SAMPLE_COUNT);
+    std::vector<float> y(SAMPLE_COUNT);
+    std::vector<float> z(SAMPLE_COUNT);
+    std::vector<float> out(SAMPLE_COUNT);
+    for (size_t i = 0; i < SAMPLE_COUNT; ++i) {
+        x[i] = coordinate(random);
+        y[i] = coordinate(random);
+        z[i] = coordinate(random);
+    }
+
+    std::printf("%s, %u lanes, Msamples/s on one core\n", Noise::getInstructionSet(), Noise::getLaneCount());
+    std::printf("%-8s %10s %10s %10s %10s %10s %10s\n", "type", "batch 2D", "batch 3D", "single 3D", "glm 3D", "grid fBm1", "grid fBm4");
+
+    float checksum = 0.0f;
+    for (NoiseType type : { NoiseType::Perlin, NoiseType::Simplex, NoiseType::Value }) {
+        const double batch2 = Gem::Bench::measureMillis([&]() {
+            noise.sample(type, x.data(), y.data(), out.data(), SAMPLE_COUNT);
+        });
+        checksum += out[0];
+
+        const double batch3 = Gem::Bench::measureMillis([&]() {
+            noise.sample(type, x.data(), y.data(), z.data(), out.data(), SAMPLE_COUNT);
+        });
+        checksum += out[0];
+
+        const double single3 = Gem::Bench::measureMillis([&]() {
+            for (size_t i = 0; i < SAMPLE_COUNT; ++i) {
+                out[i] = noise.sample(type, glm::vec3(x[i], y[i], z[i]));
+            }
+        });
+        checksum += out[0];
+
+        // glm has no value noise, leave its column empty
+        double glm3 = 0.0;
+        if (type != NoiseType::Value) {
+            glm3 = Gem::Bench::measureMillis([&]() {
+                for (size_t i = 0; i < SAMPLE_COUNT; ++i) {
+                    const glm::vec3 position(x[i], y[i], z[i]);
+                    out[i] = (type == NoiseType::Perlin) ? glm::perlin(position) : glm::simplex(position);
+                }
+            });
+            checksum += out[0];
+        }
+
+        double grid[2] = { 0.0, 0.0 };
+        std::vector<float> cells(GRID_LENGTH * GRID_LENGTH * GRID_LENGTH);
+        for (uint32_t octaves : { 1u, 4u }) {
+            FractalSettings settings;
+            settings.type = type;
+            settings.octaves = octaves;
+            settings.frequency = 0.03f;
+
+            grid[octaves == 1 ? 0 : 1] = Gem::Bench::measureMillis([&]() {
+                for (int repeat = 0; repeat < GRID_REPEATS; ++repeat) {
+                    const glm::vec3 origin(static_cast<float>(repeat * GRID_LENGTH), 0.0f, 0.0f);
+                    noise.fillGrid(origin, glm::vec3(1.0f), glm::uvec3(GRID_LENGTH), settings, cells.data());
+                }
+            });
+            checksum += cells[0];
+        }
+
+        // fBm grids count one sample per cell whatever the octaves, the rate a generator sees
+        const size_t gridSamples = size_t(GRID_REPEATS) * GRID_LENGTH * GRID_LENGTH * GRID_LENGTH;
+        std::printf("%-8s %10.1f %10.1f %10.1f ", getName(type),
+            getMegaSamples(SAMPLE_COUNT, batch2), getMegaSamples(SAMPLE_COUNT, batch3), getMegaSamples(SAMPLE_COUNT, single3));
+        if (glm3 > 0.0) {
+            std::printf("%10.1f ", getMegaSamples(SAMPLE_COUNT, glm3));
+        }
+        else {
+            std::printf("%10s ", "-");
+        }
+        std::printf("%10.1f %10.1f\n", getMegaSamples(gridSamples, grid[0]), getMegaSamples(gridSamples, grid[1]));
+    }
+
+    std::printf("checksum %g\n", checksum);
+}
@@ -0,0 +1,91 @@
+#include "bench.h"
+
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+#include <Gem/Voxel/physics.h>
+
+using namespace Gem::Voxel;
+
+namespace {
+
+    constexpr size_t BODY_COUNT = 20000;
+    constexpr int STEP_COUNT = 20;
+    constexpr float STEP_SECONDS = 0.05f;
+
+} // namespace
+
+/**
+ * Steps a crowd of walking bodies over rough ground, on the calling thread then on every core,
+ * and reports the bodies moved per millisecond.
+ */
+GEM_BENCHMARK(PhysicsBodiesPerMillisecond) {
+    const BlockRegistry blocks = BlockRegistry::createDefault();
+    const uint16_t stone = blocks.getId("stone");
+    const uint16_t slab = blocks.getId("planks_slab");
+
+    ChunkManager world;
+    world.setGenerator([=](const ChunkCoord& coord, Chunk& chunk) {
+        if (coord.y < 0) {
+            chunk.fill(Voxel(stone));
+            return;
+        }
+        if (coord.y > 0) {
+            return;
+        }
+
+        std::mt19937 random(coord.x * 31 + coord.z * 3 + 5);
+        for (uint32_t z = 0; z < CHUNK_BOUNDARY; ++z) {
+            for (uint32_t x = 0; x < CHUNK_BOUNDARY; ++x) {
+                const uint32_t pick = random() % 16;
+                if (pick < 2) {
+                    chunk.setVoxel(x, 0, z, Voxel(pick == 0 ? stone : slab));
+                }
+            }
+        }
+    });
+    world.setLoadRadius(4, 1);
+    world.setMaxLoadsPerFrame(1000);
+    world.update(glm::vec3(8.0f));
+
+    Physics physics(world, &blocks);
+
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> coordinate(-40.0f, 40.0f);
+    std::uniform_real_distribution<float> speed(-6.0f, 6.0f);
+
+    std::vector<PhysicsBody> start(BODY_COUNT);
+    for (PhysicsBody& body : start) {
+        body.position.x = coordinate(random);
+        body.position.y = 2.0f;
+        body.position.z = coordinate(random);
+        body.velocity.x = speed(random);
+        body.velocity.z = speed(random);
+    }
+
+    const unsigned int cores = std::thread::hardware_concurrency();
+    Gem::Core::JobSystem jobs((cores > 1) ? cores - 1 : 1);
+
+    std::printf("%u bodies, %d steps\n", static_cast<unsigned int>(BODY_COUNT), STEP_COUNT);
+    std::printf("%-8s %8s %12s %10s\n", "threads", "ms/step", "bodies/ms", "skipped");
+
+    for (Gem::Core::JobSystem* pool : { static_cast<Gem::Core::JobSystem*>(nullptr), &jobs }) {
+        std::vector<PhysicsBody> bodies = start;
+
+        double best = 0.0;
+        double millis = 0.0;
+        for (int step = 0; step < STEP_COUNT; ++step) {
+            physics.step(bodies, STEP_SECONDS, pool);
+
+            const PhysicsStats stats = physics.getStats();
+            if (stats.bodiesPerMillisecond > best) {
+                best = stats.bodiesPerMillisecond;
+                millis = stats.lastMillis;
+            }
+        }
+
+        const unsigned int threads = pool ? pool->getWorkerCount() + 1 : 1;
+        std::printf("%-8u %8.3f %12.0f %10zu\n", threads, millis, best, physics.getStats().lastSkipped);
+    }
+}
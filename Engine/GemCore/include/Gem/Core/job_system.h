@@ -0,0 +1,226 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file job_system.h
+ * @brief Declaration of the JobSystem class and its JobHandle.
+ */
+
+namespace Gem {
+
+    namespace Core {
+
+        class JobSystem;
+
+        /**
+         * @class JobHandle
+         * @brief Tracks the completion of one or more scheduled jobs.
+         *
+         * Handles are cheap to copy. A default-constructed handle is considered done,
+         * so it can be passed as an empty dependency.
+         */
+        class JobHandle {
+        public:
+            JobHandle() = default;
+
+            /**
+             * @brief Checks whether every job tracked by the handle has finished.
+             * @return True if the jobs are done or the handle is empty.
+             */
+            [[nodiscard]] bool isDone() const noexcept;
+
+            /**
+             * @brief Checks whether the handle tracks any job.
+             * @return True if the handle was returned by a JobSystem.
+             */
+            [[nodiscard]] bool isValid() const noexcept;
+
+        private:
+            friend class JobSystem;
+
+            /**
+             * @brief Shared completion state of a group of jobs.
+             */
+            struct Counter {
+                std::atomic<uint32_t> remaining{ 0 };                   ///< Jobs still running or queued.
+                std::mutex mutex;                                       ///< Protects the fields below.
+                bool done = false;                                      ///< Set once remaining reached zero.
+                std::vector<std::function<void()>> continuations;       ///< Run once done, used for dependencies.
+            };
+
+            explicit JobHandle(std::shared_ptr<Counter> counter) noexcept;
+
+            std::shared_ptr<Counter> counter_;  ///< Completion state, null for an empty handle.
+        };
+
+        /**
+         * @class JobSystem
+         * @brief Work-stealing thread pool for moving work off the frame thread.
+         *
+         * Each worker owns a deque: it pushes and pops its own jobs at the back (LIFO, cache friendly)
+         * while idle workers steal from the front of other deques (FIFO, oldest and usually largest work).
+         * Threads that are not workers, such as the render thread, share one extra deque.
+         *
+         * Jobs can depend on other jobs through their handles, and wait() keeps the calling
+         * thread busy with queued jobs instead of blocking.
+         *
+         * Jobs must not throw; exceptions are caught and logged so the handle still completes.
+         */
+        class JobSystem {
+        public:
+            using Job = std::function<void()>;
+            using RangeJob = std::function<void(size_t begin, size_t end)>;
+
+            /**
+             * @brief Starts the worker threads.
+             * @param workerCount Number of worker threads. 0 uses one thread per hardware core minus one,
+             *                    leaving a core for the thread that waits on the jobs.
+             */
+            explicit JobSystem(unsigned int workerCount = 0);
+
+            /**
+             * @brief Stops the workers. Jobs still queued are discarded.
+             */
+            ~JobSystem();
+
+            /**
+             * @brief Schedules a job.
+             * @param job The function to run.
+             * @return A handle completing when the job has run.
+             */
+            JobHandle schedule(Job job);
+
+            /**
+             * @brief Schedules a job after another one has completed.
+             * @param job The function to run.
+             * @param dependency The handle to wait for.
+             * @return A handle completing when the job has run.
+             */
+            JobHandle schedule(Job job, const JobHandle& dependency);
+
+            /**
+             * @brief Schedules a job after several others have completed.
+             * @param job The function to run.
+             * @param dependencies The handles to wait for.
+             * @return A handle completing when the job has run.
+             */
+            JobHandle schedule(Job job, std::initializer_list<JobHandle> dependencies);
+
+            /**
+             * @brief Schedules a job after several others have completed.
+             * @param job The function to run.
+             * @param dependencies The handles to wait for.
+             * @return A handle completing when the job has run.
+             */
+            JobHandle schedule(Job job, const std::vector<JobHandle>& dependencies);
+
+            /**
+             * @brief Splits a range into batches and runs them in parallel.
+             * @param count The number of items.
+             * @param batchSize The number of items per job.
+             * @param job Called with [begin, end) for each batch.
+             * @param dependency Optional handle to wait for before starting.
+             * @return A single handle completing when every batch has run.
+             */
+            JobHandle parallelFor(size_t count, size_t batchSize, RangeJob job, const JobHandle& dependency = JobHandle());
+
+            /**
+             * @brief Waits for a handle while running queued jobs on the calling thread.
+             * @param handle The handle to wait for.
+             */
+            void wait(const JobHandle& handle);
+
+            /**
+             * @brief Gets the number of worker threads.
+             * @return The worker count.
+             */
+            [[nodiscard]] unsigned int getWorkerCount() const noexcept;
+
+            // Delete copy and move, workers keep a pointer to the system
+            JobSystem(const JobSystem&) = delete;
+            JobSystem& operator=(const JobSystem&) = delete;
+            JobSystem(JobSystem&&) = delete;
+            JobSystem& operator=(JobSystem&&) = delete;
+
+        private:
+
+            /**
+             * @brief A queued function and the counter it completes.
+             */
+            struct Task {
+                Job function;
+                std::shared_ptr<JobHandle::Counter> counter;
+            };
+
+            /**
+             * @brief A deque of tasks owned by one thread and stolen from by the others.
+             */
+            struct WorkQueue {
+                std::mutex mutex;
+                std::deque<Task> tasks;
+            };
+
+            /**
+             * @brief Main loop of a worker thread.
+             */
+            void workerLoop(unsigned int index);
+
+            /**
+             * @brief Gets the queue owned by the calling thread.
+             */
+            [[nodiscard]] unsigned int currentQueue() const noexcept;
+
+            /**
+             * @brief Pushes a task on the queue of the calling thread and wakes a worker.
+             */
+            void submit(Task task);
+
+            /**
+             * @brief Runs one task, taken from the given queue or stolen from another one.
+             * @return True if a task was run.
+             */
+            bool runOne(unsigned int index);
+
+            /**
+             * @brief Pops the newest task of a queue.
+             */
+            bool pop(unsigned int index, Task& task);
+
+            /**
+             * @brief Steals the oldest task of any queue other than the given one.
+             */
+            bool steal(unsigned int index, Task& task);
+
+            /**
+             * @brief Marks one job of a counter as finished and releases its dependents.
+             */
+            void finish(const std::shared_ptr<JobHandle::Counter>& counter);
+
+            /**
+             * @brief Runs a callback once a handle is done, immediately if it already is.
+             */
+            static void onDone(const JobHandle& handle, std::function<void()> callback);
+
+        private:
+            std::vector<std::thread> workers_;                  ///< Worker threads.
+            std::vector<std::unique_ptr<WorkQueue>> queues_;    ///< One queue per worker plus one shared by other threads.
+
+            std::atomic<bool> running_{ true };                 ///< Cleared to stop the workers.
+            std::atomic<size_t> queuedTasks_{ 0 };              ///< Tasks pushed but not yet taken.
+
+            std::mutex sleepMutex_;                             ///< Protects idle workers going to sleep.
+            std::condition_variable wakeCondition_;             ///< Wakes idle workers when work arrives.
+        };
+
+    } // namespace Core
+
+} // namespace Gem
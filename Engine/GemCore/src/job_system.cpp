@@ -0,0 +1,305 @@
+#include <Gem/Core/job_system.h>
+#include <algorithm>
+#include <exception>
+#include <iostream>
+
+namespace Gem {
+
+	namespace Core {
+
+		namespace {
+
+			// Identifies the worker running on the current thread, if any
+			thread_local const JobSystem* tlsSystem = nullptr;
+			thread_local unsigned int tlsQueue = 0;
+
+		} // namespace
+
+		// JobHandle
+
+		JobHandle::JobHandle(std::shared_ptr<Counter> counter) noexcept
+			: counter_(std::move(counter)) {
+		}
+
+		bool JobHandle::isDone() const noexcept {
+			return !counter_ || counter_->remaining.load(std::memory_order_acquire) == 0;
+		}
+
+		bool JobHandle::isValid() const noexcept {
+			return counter_ != nullptr;
+		}
+
+		// JobSystem
+
+		JobSystem::JobSystem(unsigned int workerCount) {
+			if (workerCount == 0) {
+				const unsigned int cores = std::thread::hardware_concurrency();
+				workerCount = (cores > 1) ? cores - 1 : 1;
+			}
+
+			// Queues 0..workerCount-1 belong to the workers, the last one is shared by other threads
+			for (unsigned int i = 0; i <= workerCount; ++i) {
+				queues_.push_back(std::make_unique<WorkQueue>());
+			}
+
+			workers_.reserve(workerCount);
+			for (unsigned int i = 0; i < workerCount; ++i) {
+				workers_.emplace_back(&JobSystem::workerLoop, this, i);
+			}
+		}
+
+		JobSystem::~JobSystem() {
+			{
+				std::lock_guard<std::mutex> lock(sleepMutex_);
+				running_ = false;
+			}
+			wakeCondition_.notify_all();
+
+			for (std::thread& worker : workers_) {
+				if (worker.joinable()) {
+					worker.join();
+				}
+			}
+		}
+
+		JobHandle JobSystem::schedule(Job job) {
+			auto counter = std::make_shared<JobHandle::Counter>();
+			counter->remaining = 1;
+
+			submit({ std::move(job), counter });
+			return JobHandle(counter);
+		}
+
+		JobHandle JobSystem::schedule(Job job, const JobHandle& dependency) {
+			if (dependency.isDone()) {
+				return schedule(std::move(job));
+			}
+
+			auto counter = std::make_shared<JobHandle::Counter>();
+			counter->remaining = 1;
+
+			onDone(dependency, [this, job = std::move(job), counter]() mutable {
+				submit({ std::move(job), counter });
+			});
+
+			return JobHandle(counter);
+		}
+
+		JobHandle JobSystem::schedule(Job job, std::initializer_list<JobHandle> dependencies) {
+			return schedule(std::move(job), std::vector<JobHandle>(dependencies));
+		}
+
+		JobHandle JobSystem::schedule(Job job, const std::vector<JobHandle>& dependencies) {
+			std::vector<JobHandle> pending;
+			for (const JobHandle& dependency : dependencies) {
+				if (!dependency.isDone()) {
+					pending.push_back(dependency);
+				}
+			}
+
+			if (pending.empty()) {
+				return schedule(std::move(job));
+			}
+			if (pending.size() == 1) {
+				return schedule(std::move(job), pending.front());
+			}
+
+			auto counter = std::make_shared<JobHandle::Counter>();
+			counter->remaining = 1;
+
+			// The last dependency to complete submits the job
+			struct Gate {
+				std::atomic<size_t> remaining;
+				Job job;
+			};
+			auto gate = std::make_shared<Gate>();
+			gate->remaining = pending.size();
+			gate->job = std::move(job);
+
+			for (const JobHandle& dependency : pending) {
+				onDone(dependency, [this, gate, counter]() {
+					if (gate->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+						submit({ std::move(gate->job), counter });
+					}
+				});
+			}
+
+			return JobHandle(counter);
+		}
+
+		JobHandle JobSystem::parallelFor(size_t count, size_t batchSize, RangeJob job, const JobHandle& dependency) {
+			batchSize = std::max<size_t>(batchSize, 1);
+			const size_t batches = (count + batchSize - 1) / batchSize;
+
+			auto counter = std::make_shared<JobHandle::Counter>();
+			if (batches == 0) {
+				return JobHandle(counter);
+			}
+			counter->remaining = static_cast<uint32_t>(batches);
+
+			auto shared = std::make_shared<RangeJob>(std::move(job));
+
+			auto submitBatches = [this, shared, counter, count, batchSize, batches]() {
+				for (size_t batch = 0; batch < batches; ++batch) {
+					const size_t begin = batch * batchSize;
+					const size_t end = std::min(begin + batchSize, count);
+
+					submit({ [shared, begin, end]() { (*shared)(begin, end); }, counter });
+				}
+			};
+
+			if (dependency.isDone()) {
+				submitBatches();
+			}
+			else {
+				onDone(dependency, submitBatches);
+			}
+
+			return JobHandle(counter);
+		}
+
+		void JobSystem::wait(const JobHandle& handle) {
+			const unsigned int queue = currentQueue();
+
+			while (!handle.isDone()) {
+				// Help with the work instead of blocking
+				if (!runOne(queue)) {
+					std::this_thread::yield();
+				}
+			}
+		}
+
+		unsigned int JobSystem::getWorkerCount() const noexcept {
+			return static_cast<unsigned int>(workers_.size());
+		}
+
+		void JobSystem::workerLoop(unsigned int index) {
+			tlsSystem = this;
+			tlsQueue = index;
+
+			while (running_) {
+				if (runOne(index)) {
+					continue;
+				}
+
+				// Nothing to run or steal, sleep until a job is submitted
+				std::unique_lock<std::mutex> lock(sleepMutex_);
+				wakeCondition_.wait(lock, [this]() {
+					return !running_ || queuedTasks_.load(std::memory_order_acquire) > 0;
+				});
+			}
+		}
+
+		unsigned int JobSystem::currentQueue() const noexcept {
+			if (tlsSystem == this) {
+				return tlsQueue;
+			}
+
+			return static_cast<unsigned int>(queues_.size() - 1);
+		}
+
+		void JobSystem::submit(Task task) {
+			WorkQueue& queue = *queues_[currentQueue()];
+
+			// Count first so a thief taking the task right away never sees the counter underflow
+			queuedTasks_.fetch_add(1, std::memory_order_release);
+			{
+				std::lock_guard<std::mutex> lock(queue.mutex);
+				queue.tasks.push_back(std::move(task));
+			}
+
+			// Take the sleep lock so a worker cannot miss the wake-up between its check and its wait
+			{
+				std::lock_guard<std::mutex> lock(sleepMutex_);
+			}
+			wakeCondition_.notify_one();
+		}
+
+		bool JobSystem::runOne(unsigned int index) {
+			Task task;
+			if (!pop(index, task) && !steal(index, task)) {
+				return false;
+			}
+
+			queuedTasks_.fetch_sub(1, std::memory_order_acq_rel);
+
+			try {
+				task.function();
+			}
+			catch (const std::exception& e) {
+				std::cerr << "ERROR::JobSystem::runOne: Job threw an exception: " << e.what() << std::endl;
+			}
+			catch (...) {
+				std::cerr << "ERROR::JobSystem::runOne: Job threw an unknown exception." << std::endl;
+			}
+
+			finish(task.counter);
+			return true;
+		}
+
+		bool JobSystem::pop(unsigned int index, Task& task) {
+			WorkQueue& queue = *queues_[index];
+			std::lock_guard<std::mutex> lock(queue.mutex);
+
+			if (queue.tasks.empty()) {
+				return false;
+			}
+
+			task = std::move(queue.tasks.back());
+			queue.tasks.pop_back();
+			return true;
+		}
+
+		bool JobSystem::steal(unsigned int index, Task& task) {
+			const size_t count = queues_.size();
+
+			// Start from the next queue so thieves spread over different victims
+			for (size_t offset = 1; offset < count; ++offset) {
+				WorkQueue& queue = *queues_[(index + offset) % count];
+
+				std::unique_lock<std::mutex> lock(queue.mutex, std::try_to_lock);
+				if (!lock.owns_lock() || queue.tasks.empty()) {
+					continue;
+				}
+
+				task = std::move(queue.tasks.front());
+				queue.tasks.pop_front();
+				return true;
+			}
+
+			return false;
+		}
+
+		void JobSystem::finish(const std::shared_ptr<JobHandle::Counter>& counter) {
+			if (counter->remaining.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+				return;
+			}
+
+			std::vector<std::function<void()>> continuations;
+			{
+				std::lock_guard<std::mutex> lock(counter->mutex);
+				counter->done = true;
+				continuations.swap(counter->continuations);
+			}
+
+			for (auto& continuation : continuations) {
+				continuation();
+			}
+		}
+
+		void JobSystem::onDone(const JobHandle& handle, std::function<void()> callback) {
+			{
+				std::lock_guard<std::mutex> lock(handle.counter_->mutex);
+				if (!handle.counter_->done) {
+					handle.counter_->continuations.push_back(std::move(callback));
+					return;
+				}
+			}
+
+			// Completed in the meantime
+			callback();
+		}
+
+	} // namespace Core
+
+} // namespace Gem
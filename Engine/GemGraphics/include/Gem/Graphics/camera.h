@@ -9,6 +9,7 @@
 #include <Gem/Graphics/shader.h>
 #include <Gem/Input/inputs.h>
 #include <Gem/Graphics/buffer.h>
+#include <Gem/Graphics/frustum.h>
 
 namespace Gem {
 
@@ -48,9 +49,10 @@ namespace Gem {
             /**
              * @brief Updates and sends the view and projection matrices to the shader.
              *
-             * Calculates the view and projection matrices based on the camera's current state.
+             * Calculates the view and projection matrices based on the camera's current state,
+             * and extracts the frustum planes from them.
              */
-            void update_matrices() const;
+            void update_matrices();
 
             /**
              * @brief Handles camera input processing.
@@ -104,6 +106,29 @@ namespace Gem {
              */
             [[nodiscard]] glm::vec3 get_position() const noexcept;
 
+            /**
+             * @brief Gets the view matrix computed by the last update_matrices() call.
+             *
+             * @return The view matrix.
+             */
+            [[nodiscard]] const glm::mat4& get_view_matrix() const noexcept;
+
+            /**
+             * @brief Gets the projection matrix computed by the last update_matrices() call.
+             *
+             * @return The projection matrix.
+             */
+            [[nodiscard]] const glm::mat4& get_projection_matrix() const noexcept;
+
+            /**
+             * @brief Gets the frustum extracted by the last update_matrices() call.
+             *
+             * Use Frustum::cull_boxes() to test many bounding boxes at once before issuing draw calls.
+             *
+             * @return The frustum, which contains everything until the matrices are first updated.
+             */
+            [[nodiscard]] const Frustum& get_frustum() const noexcept;
+
             /**
              * @brief Equality operator.
              *
@@ -171,6 +196,10 @@ namespace Gem {
             float near_plane_{ 0.1f };                      ///< Near clipping plane.
             float far_plane_{ 1000.0f };                    ///< Far clipping plane.
 
+            glm::mat4 view_{ 1.0f };                        ///< View matrix of the last update.
+            glm::mat4 projection_{ 1.0f };                  ///< Projection matrix of the last update.
+            Frustum frustum_;                               ///< Frustum planes of the last update.
+
 			Gem::Graphics::Shader* shader_{ nullptr };      ///< Pointer to the Shader object.
 
 			Graphics::Buffer matrices_ubo_{ GL_UNIFORM_BUFFER }; ///< Buffer for matrices UBO
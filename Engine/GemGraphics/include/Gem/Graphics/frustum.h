@@ -0,0 +1,120 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+/**
+ * @file frustum.h
+ * @brief Declaration of the Frustum class and the BoundingBoxes it tests.
+ */
+
+namespace Gem {
+    namespace Graphics {
+
+        /**
+         * @brief Axis-aligned boxes stored as structure-of-arrays, one array per coordinate.
+         *
+         * Keeping each coordinate contiguous lets Frustum::cull_boxes() load several boxes per register.
+         */
+        struct BoundingBoxes {
+            std::vector<float> min_x, min_y, min_z;     ///< Lowest corners.
+            std::vector<float> max_x, max_y, max_z;     ///< Highest corners.
+
+            /**
+             * @brief Appends a box.
+             *
+             * @param min The lowest corner.
+             * @param max The highest corner.
+             */
+            void add(const glm::vec3& min, const glm::vec3& max);
+
+            /**
+             * @brief Removes every box, keeping the allocated memory.
+             */
+            void clear() noexcept;
+
+            /**
+             * @brief Reserves memory for a number of boxes.
+             *
+             * @param count The number of boxes.
+             */
+            void reserve(size_t count);
+
+            /**
+             * @brief Gets the number of boxes.
+             *
+             * @return The box count.
+             */
+            [[nodiscard]] size_t size() const noexcept { return min_x.size(); }
+        };
+
+        /**
+         * @brief The six planes bounding the volume seen by a camera.
+         *
+         * Planes are extracted from a view-projection matrix and point inwards, so a point is inside the
+         * frustum when its distance to every plane is positive. Box tests are conservative: a box crossing
+         * a corner of the frustum can be reported visible, a visible box is never reported hidden.
+         */
+        class Frustum {
+        public:
+            static constexpr size_t PLANE_COUNT = 6;
+
+            /**
+             * @brief Constructs a frustum that contains everything.
+             */
+            Frustum() noexcept;
+
+            /**
+             * @brief Extracts the planes of a view-projection matrix.
+             *
+             * Expects the OpenGL clip space, with depth from -1 to 1.
+             *
+             * @param view_projection The projection matrix multiplied by the view matrix.
+             */
+            void set_matrix(const glm::mat4& view_projection) noexcept;
+
+            /**
+             * @brief Tests a single box.
+             *
+             * @param min The lowest corner.
+             * @param max The highest corner.
+             * @return False if the box is entirely outside the frustum.
+             */
+            [[nodiscard]] bool contains_box(const glm::vec3& min, const glm::vec3& max) const noexcept;
+
+            /**
+             * @brief Tests many boxes at once, several per SIMD register where available.
+             *
+             * @param boxes The boxes.
+             * @param visible Receives 1 for each box touching the frustum and 0 for the others, boxes.size() entries.
+             * @return The number of visible boxes.
+             */
+            size_t cull_boxes(const BoundingBoxes& boxes, uint8_t* visible) const noexcept;
+
+            /**
+             * @brief Gets a plane.
+             *
+             * @param index The plane index: left, right, bottom, top, near then far.
+             * @return The plane, normal in xyz and offset in w.
+             */
+            [[nodiscard]] glm::vec4 get_plane(size_t index) const noexcept;
+
+            /**
+             * @brief Gets the instruction set used by cull_boxes().
+             *
+             * @return "AVX", "SSE2" or "Scalar".
+             */
+            [[nodiscard]] static const char* get_instruction_set() noexcept;
+
+        private:
+            // Plane components as structure-of-arrays, broadcast once per batch
+            std::array<float, PLANE_COUNT> normal_x_{};
+            std::array<float, PLANE_COUNT> normal_y_{};
+            std::array<float, PLANE_COUNT> normal_z_{};
+            std::array<float, PLANE_COUNT> offset_{};
+        };
+
+    } // namespace Graphics
+} // namespace Gem
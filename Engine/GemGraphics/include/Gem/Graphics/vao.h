@@ -67,6 +67,22 @@ namespace Gem {
              */
             void link_attrib(const Buffer& VBO, GLuint layout, GLint numComponents, GLenum type, GLsizei stride, const void* offset, GLboolean normalized = GL_FALSE);
 
+            /**
+             * @brief Links a VBO to the VAO as an integer attribute.
+             *
+             * Unlike link_attrib(), the values are not converted to floats: the shader reads them
+             * as int, uint or ivec/uvec inputs, which lets it decode packed vertices bit by bit.
+             * The VBO must be bound before calling this method.
+             *
+             * @param VBO The VBO to link.
+             * @param layout The layout location of the attribute.
+             * @param numComponents The number of components per vertex attribute.
+             * @param type The integer data type of each component (e.g., GL_UNSIGNED_INT).
+             * @param stride The byte offset between consecutive vertex attributes.
+             * @param offset The offset of the first component of the first attribute.
+             */
+            void link_attrib_integer(const Buffer& VBO, GLuint layout, GLint numComponents, GLenum type, GLsizei stride, const void* offset);
+
             /**
              * @brief Deletes the VAO.
              *
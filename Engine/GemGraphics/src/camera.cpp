@@ -63,12 +63,15 @@ namespace Gem {
         }
 
         // Update and send matrices to the shader
-        void Camera::update_matrices() const {
+        void Camera::update_matrices() {
 			// Calculate view matrix
-			glm::mat4 view = glm::lookAt(position_, position_ + orientation_, up_);
+			view_ = glm::lookAt(position_, position_ + orientation_, up_);
 
 			// Calculate projection matrix
-			glm::mat4 projection = glm::perspective(glm::radians(fov_), static_cast<float>(width_) / height_, near_plane_, far_plane_);
+			projection_ = glm::perspective(glm::radians(fov_), static_cast<float>(width_) / height_, near_plane_, far_plane_);
+
+			// Keep the frustum in sync for culling
+			frustum_.set_matrix(projection_ * view_);
 
 			// Update the UBO with the matrices using the Buffer class
 
@@ -76,10 +79,10 @@ namespace Gem {
 			matrices_ubo_.bind();
 
 			// Update the projection matrix (offset 0)
-			glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), glm::value_ptr(projection));
+			glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), glm::value_ptr(projection_));
 
 			// Update the view matrix (offset sizeof(mat4))
-			glBufferSubData(GL_UNIFORM_BUFFER, sizeof(glm::mat4), sizeof(glm::mat4), glm::value_ptr(view));
+			glBufferSubData(GL_UNIFORM_BUFFER, sizeof(glm::mat4), sizeof(glm::mat4), glm::value_ptr(view_));
 
 			// Unbind the buffer
 			matrices_ubo_.unbind();
@@ -214,6 +217,21 @@ namespace Gem {
             return position_;
         }
 
+        // Get view matrix
+        [[nodiscard]] const glm::mat4& Camera::get_view_matrix() const noexcept {
+            return view_;
+        }
+
+        // Get projection matrix
+        [[nodiscard]] const glm::mat4& Camera::get_projection_matrix() const noexcept {
+            return projection_;
+        }
+
+        // Get frustum
+        [[nodiscard]] const Frustum& Camera::get_frustum() const noexcept {
+            return frustum_;
+        }
+
         // Equality operator
         bool Camera::operator==(const Camera& other) const noexcept {
             return position_ == other.position_ && orientation_ == other.orientation_;
@@ -0,0 +1,218 @@
+#include <Gem/Graphics/frustum.h>
+#include <cmath>
+
+#if defined(__AVX__)
+#define GEM_FRUSTUM_AVX
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GEM_FRUSTUM_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Gem {
+    namespace Graphics {
+
+        namespace {
+
+            // Lane types
+            //
+            // cull_boxes() is written once against these types. outside() returns a bit per lane, set where
+            // the distance is negative.
+
+            struct ScalarLanes {
+                static constexpr size_t WIDTH = 1;
+
+                float v;
+
+                static ScalarLanes load(const float* p) { return { *p }; }
+                static ScalarLanes broadcast(float f) { return { f }; }
+
+                friend ScalarLanes operator+(ScalarLanes a, ScalarLanes b) { return { a.v + b.v }; }
+                friend ScalarLanes operator*(ScalarLanes a, ScalarLanes b) { return { a.v * b.v }; }
+
+                uint32_t outside() const { return v < 0.0f ? 1u : 0u; }
+            };
+
+#if defined(GEM_FRUSTUM_SSE2)
+
+            struct WideLanes {
+                static constexpr size_t WIDTH = 4;
+
+                __m128 v;
+
+                static WideLanes load(const float* p) { return { _mm_loadu_ps(p) }; }
+                static WideLanes broadcast(float f) { return { _mm_set1_ps(f) }; }
+
+                friend WideLanes operator+(WideLanes a, WideLanes b) { return { _mm_add_ps(a.v, b.v) }; }
+                friend WideLanes operator*(WideLanes a, WideLanes b) { return { _mm_mul_ps(a.v, b.v) }; }
+
+                uint32_t outside() const { return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmplt_ps(v, _mm_setzero_ps()))); }
+            };
+
+            constexpr const char* INSTRUCTION_SET = "SSE2";
+
+#elif defined(GEM_FRUSTUM_AVX)
+
+            struct WideLanes {
+                static constexpr size_t WIDTH = 8;
+
+                __m256 v;
+
+                static WideLanes load(const float* p) { return { _mm256_loadu_ps(p) }; }
+                static WideLanes broadcast(float f) { return { _mm256_set1_ps(f) }; }
+
+                friend WideLanes operator+(WideLanes a, WideLanes b) { return { _mm256_add_ps(a.v, b.v) }; }
+                friend WideLanes operator*(WideLanes a, WideLanes b) { return { _mm256_mul_ps(a.v, b.v) }; }
+
+                uint32_t outside() const { return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(v, _mm256_setzero_ps(), _CMP_LT_OQ))); }
+            };
+
+            constexpr const char* INSTRUCTION_SET = "AVX";
+
+#else
+
+            using WideLanes = ScalarLanes;
+            constexpr const char* INSTRUCTION_SET = "Scalar";
+
+#endif
+
+            /**
+             * @brief The box arrays holding the corner farthest along a plane normal, picked once per plane.
+             */
+            struct PlaneCorner {
+                const float* x;
+                const float* y;
+                const float* z;
+            };
+
+            /**
+             * @brief Tests boxes from first to last, a multiple of the lane width apart.
+             */
+            template<typename Lanes>
+            size_t cullRange(const float* normal_x, const float* normal_y, const float* normal_z, const float* offset,
+                             const PlaneCorner* corners, size_t first, size_t last, uint8_t* visible) {
+                size_t count = 0;
+
+                for (size_t i = first; i + Lanes::WIDTH <= last; i += Lanes::WIDTH) {
+                    uint32_t outside = 0;
+                    for (size_t p = 0; p < Frustum::PLANE_COUNT; ++p) {
+                        const Lanes distance = Lanes::broadcast(normal_x[p]) * Lanes::load(corners[p].x + i)
+                            + Lanes::broadcast(normal_y[p]) * Lanes::load(corners[p].y + i)
+                            + Lanes::broadcast(normal_z[p]) * Lanes::load(corners[p].z + i)
+                            + Lanes::broadcast(offset[p]);
+                        outside |= distance.outside();
+                    }
+
+                    for (size_t lane = 0; lane < Lanes::WIDTH; ++lane) {
+                        const uint8_t inside = ((outside >> lane) & 1u) ? 0 : 1;
+                        visible[i + lane] = inside;
+                        count += inside;
+                    }
+                }
+
+                return count;
+            }
+
+        } // namespace
+
+        void BoundingBoxes::add(const glm::vec3& min, const glm::vec3& max) {
+            min_x.push_back(min.x);
+            min_y.push_back(min.y);
+            min_z.push_back(min.z);
+            max_x.push_back(max.x);
+            max_y.push_back(max.y);
+            max_z.push_back(max.z);
+        }
+
+        void BoundingBoxes::clear() noexcept {
+            min_x.clear();
+            min_y.clear();
+            min_z.clear();
+            max_x.clear();
+            max_y.clear();
+            max_z.clear();
+        }
+
+        void BoundingBoxes::reserve(size_t count) {
+            min_x.reserve(count);
+            min_y.reserve(count);
+            min_z.reserve(count);
+            max_x.reserve(count);
+            max_y.reserve(count);
+            max_z.reserve(count);
+        }
+
+        Frustum::Frustum() noexcept {
+            // Null normals and a positive offset put every point inside
+            offset_.fill(1.0f);
+        }
+
+        void Frustum::set_matrix(const glm::mat4& view_projection) noexcept {
+            // Gribb-Hartmann: each plane is the last row of the matrix plus or minus one of the others.
+            // glm is column-major, so row r is (m[0][r], m[1][r], m[2][r], m[3][r]).
+            const auto row = [&view_projection](int r) {
+                return glm::vec4(view_projection[0][r], view_projection[1][r], view_projection[2][r], view_projection[3][r]);
+            };
+
+            const glm::vec4 planes[PLANE_COUNT] = {
+                row(3) + row(0),    // Left
+                row(3) - row(0),    // Right
+                row(3) + row(1),    // Bottom
+                row(3) - row(1),    // Top
+                row(3) + row(2),    // Near
+                row(3) - row(2),    // Far
+            };
+
+            for (size_t p = 0; p < PLANE_COUNT; ++p) {
+                const float length = glm::length(glm::vec3(planes[p]));
+                const glm::vec4 plane = (length > 0.0f) ? planes[p] / length : planes[p];
+
+                normal_x_[p] = plane.x;
+                normal_y_[p] = plane.y;
+                normal_z_[p] = plane.z;
+                offset_[p] = plane.w;
+            }
+        }
+
+        bool Frustum::contains_box(const glm::vec3& min, const glm::vec3& max) const noexcept {
+            for (size_t p = 0; p < PLANE_COUNT; ++p) {
+                // The corner farthest along the normal is the last one to leave the plane
+                const float x = (normal_x_[p] >= 0.0f) ? max.x : min.x;
+                const float y = (normal_y_[p] >= 0.0f) ? max.y : min.y;
+                const float z = (normal_z_[p] >= 0.0f) ? max.z : min.z;
+
+                if (normal_x_[p] * x + normal_y_[p] * y + normal_z_[p] * z + offset_[p] < 0.0f) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        size_t Frustum::cull_boxes(const BoundingBoxes& boxes, uint8_t* visible) const noexcept {
+            const size_t count = boxes.size();
+
+            // The farthest corner depends on the plane only, so pick its arrays once rather than per box
+            PlaneCorner corners[PLANE_COUNT];
+            for (size_t p = 0; p < PLANE_COUNT; ++p) {
+                corners[p].x = (normal_x_[p] >= 0.0f) ? boxes.max_x.data() : boxes.min_x.data();
+                corners[p].y = (normal_y_[p] >= 0.0f) ? boxes.max_y.data() : boxes.min_y.data();
+                corners[p].z = (normal_z_[p] >= 0.0f) ? boxes.max_z.data() : boxes.min_z.data();
+            }
+
+            const size_t wide = count - count % WideLanes::WIDTH;
+
+            size_t result = cullRange<WideLanes>(normal_x_.data(), normal_y_.data(), normal_z_.data(), offset_.data(), corners, 0, wide, visible);
+            result += cullRange<ScalarLanes>(normal_x_.data(), normal_y_.data(), normal_z_.data(), offset_.data(), corners, wide, count, visible);
+            return result;
+        }
+
+        glm::vec4 Frustum::get_plane(size_t index) const noexcept {
+            return glm::vec4(normal_x_[index], normal_y_[index], normal_z_[index], offset_[index]);
+        }
+
+        const char* Frustum::get_instruction_set() noexcept {
+            return INSTRUCTION_SET;
+        }
+
+    } // namespace Graphics
+} // namespace Gem
@@ -65,6 +65,18 @@ namespace Gem {
             // unbind();
         }
 
+        // Link a VBO to the VAO as an integer attribute
+        void VAO::link_attrib_integer(const Buffer& VBO, GLuint layout, GLint numComponents, GLenum type, GLsizei stride, const void* offset) {
+            VBO.bind();
+            bind();
+
+            // Integer pointer, the values are not converted to floats
+            GL::vertex_attrib_i_pointer(layout, numComponents, type, stride, offset);
+            GL::enable_vertex_attrib_array(layout);
+
+            VBO.unbind();
+        }
+
         // Delete the VAO
         void VAO::cleanup() {
             if (is_generated_) {
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <glm/glm.hpp>
+
+/**
+ * @file noise.h
+ * @brief Declaration of the Noise class, batched gradient and value noise.
+ */
+
+namespace Gem {
+    namespace Math {
+
+        /**
+         * @brief The noise functions available to Noise.
+         */
+        enum class NoiseType : uint8_t {
+            Perlin,     ///< Classic Perlin noise, same as glm::perlin.
+            Simplex,    ///< Simplex noise, same as glm::simplex.
+            Value       ///< Interpolated random values on the integer lattice, cheapest of the three.
+        };
+
+        /**
+         * @struct FractalSettings
+         * @brief Parameters of fractal Brownian motion (fBm), a sum of noise octaves.
+         *
+         * Each octave multiplies the frequency by the lacunarity and the amplitude by the gain.
+         * The sum is divided by the total amplitude, so the result stays within [-1, 1].
+         */
+        struct FractalSettings {
+            NoiseType type = NoiseType::Perlin; ///< Noise function of every octave.
+            uint32_t octaves = 1;               ///< Number of octaves.
+            float frequency = 1.0f;             ///< Frequency of the first octave.
+            float lacunarity = 2.0f;            ///< Frequency multiplier between octaves.
+            float gain = 0.5f;                  ///< Amplitude multiplier between octaves.
+        };
+
+        /**
+         * @class Noise
+         * @brief Gradient and value noise evaluated several samples at a time.
+         *
+         * Perlin and simplex noise follow the same algorithm as glm::perlin and glm::simplex
+         * (gtc/noise.inl) and match them within floating point rounding, but the batched functions
+         * evaluate 8 samples per instruction with AVX2, 4 with SSE2 and fall back to scalar code otherwise.
+         * The instruction set is chosen at compile time. Products are never fused into multiply-adds, as
+         * that picks other Perlin gradients near lattice symmetries; glm must be built the same way
+         * (no FP contraction) for its values to compare.
+         *
+         * Like glm, the lattice repeats every 289 units. The seed offsets the lattice, a seed of 0 gives
+         * exactly the glm values.
+         *
+         * Grids are written x first, then y, then z, the same order as Chunk.
+         * A Noise is immutable, so it can be shared between threads.
+         */
+        class Noise {
+        public:
+            /**
+             * @brief Constructs a noise source.
+             * @param seed Selects a different lattice offset. 0 matches glm.
+             */
+            explicit Noise(uint32_t seed = 0);
+
+            /**
+             * @brief Evaluates one sample.
+             * @param type The noise function.
+             * @param position The sample position.
+             * @return The noise value, roughly within [-1, 1].
+             */
+            [[nodiscard]] float sample(NoiseType type, const glm::vec2& position) const;
+
+            /**
+             * @brief Evaluates one sample.
+             * @param type The noise function.
+             * @param position The sample position.
+             * @return The noise value, roughly within [-1, 1].
+             */
+            [[nodiscard]] float sample(NoiseType type, const glm::vec3& position) const;
+
+            /**
+             * @brief Evaluates one fBm sample.
+             * @param position The sample position.
+             * @param settings The octaves to sum.
+             * @return The noise value, roughly within [-1, 1].
+             */
+            [[nodiscard]] float fractal(const glm::vec2& position, const FractalSettings& settings) const;
+
+            /**
+             * @brief Evaluates one fBm sample.
+             * @param position The sample position.
+             * @param settings The octaves to sum.
+             * @return The noise value, roughly within [-1, 1].
+             */
+            [[nodiscard]] float fractal(const glm::vec3& position, const FractalSettings& settings) const;
+
+            /**
+             * @brief Evaluates arbitrary 2D positions given as separate coordinate arrays.
+             * @param type The noise function.
+             * @param x The x-coordinates.
+             * @param y The y-coordinates.
+             * @param out Receives count values.
+             * @param count The number of samples.
+             */
+            void sample(NoiseType type, const float* x, const float* y, float* out, size_t count) const;
+
+            /**
+             * @brief Evaluates arbitrary 3D positions given as separate coordinate arrays.
+             * @param type The noise function.
+             * @param x The x-coordinates.
+             * @param y The y-coordinates.
+             * @param z The z-coordinates.
+             * @param out Receives count values.
+             * @param count The number of samples.
+             */
+            void sample(NoiseType type, const float* x, const float* y, const float* z, float* out, size_t count) const;
+
+            /**
+             * @brief Fills a regular 2D grid with fBm.
+             * @param origin Position of the first sample.
+             * @param step Distance between two samples along each axis.
+             * @param size Number of samples along each axis.
+             * @param settings The octaves to sum.
+             * @param out Receives size.x * size.y values, x first.
+             */
+            void fillGrid(const glm::vec2& origin, const glm::vec2& step, const glm::uvec2& size, const FractalSettings& settings, float* out) const;
+
+            /**
+             * @brief Fills a regular 3D grid with fBm.
+             * @param origin Position of the first sample.
+             * @param step Distance between two samples along each axis.
+             * @param size Number of samples along each axis.
+             * @param settings The octaves to sum.
+             * @param out Receives size.x * size.y * size.z values, x first, then y, then z.
+             */
+            void fillGrid(const glm::vec3& origin, const glm::vec3& step, const glm::uvec3& size, const FractalSettings& settings, float* out) const;
+
+            /**
+             * @brief Gets the seed.
+             * @return The seed given at construction.
+             */
+            [[nodiscard]] uint32_t getSeed() const noexcept;
+
+            /**
+             * @brief Gets the number of samples evaluated per instruction.
+             * @return 8 with AVX2, 4 with SSE2, 1 otherwise.
+             */
+            [[nodiscard]] static uint32_t getLaneCount() noexcept;
+
+            /**
+             * @brief Gets the name of the instruction set used by the batched functions.
+             * @return "AVX2", "SSE2" or "Scalar".
+             */
+            [[nodiscard]] static const char* getInstructionSet() noexcept;
+
+        private:
+            uint32_t seed_;         ///< Seed given at construction.
+            glm::vec3 offset_;      ///< Lattice offset derived from the seed.
+        };
+
+    } // namespace Math
+} // namespace Gem
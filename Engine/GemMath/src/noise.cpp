@@ -0,0 +1,783 @@
+#include <Gem/Math/noise.h>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+
+#if defined(__AVX2__)
+#define GEM_NOISE_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GEM_NOISE_SSE2
+#include <emmintrin.h>
+#if defined(__SSE4_1__) || defined(__AVX__)
+#include <smmintrin.h>
+#endif
+#endif
+
+// Perlin gradients are picked by the sign of values that are often zero up to rounding (see
+// PerlinKernel::corner3D), so fused multiply-adds would pick other gradients than glm. Keep every
+// product rounded, on FMA targets too, so all instruction sets give the same values.
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#elif defined(_MSC_VER)
+#pragma fp_contract(off)
+#endif
+
+namespace Gem {
+    namespace Math {
+
+        namespace {
+
+            // Lane types
+            //
+            // The noise functions below are written once against these types, which all expose the same
+            // arithmetic: +, -, *, floor, abs, min, max and step. Only step() and floor() hide branches.
+
+            /**
+             * @brief A single float, used for scalar evaluation and for the tail of the batches.
+             */
+            struct ScalarLanes {
+                static constexpr size_t WIDTH = 1;
+
+                float v;
+
+                static ScalarLanes load(const float* p) { return { *p }; }
+                static ScalarLanes broadcast(float f) { return { f }; }
+                static ScalarLanes iota(float start, float) { return { start }; }
+                void store(float* p) const { *p = v; }
+
+                friend ScalarLanes operator+(ScalarLanes a, ScalarLanes b) { return { a.v + b.v }; }
+                friend ScalarLanes operator-(ScalarLanes a, ScalarLanes b) { return { a.v - b.v }; }
+                friend ScalarLanes operator*(ScalarLanes a, ScalarLanes b) { return { a.v * b.v }; }
+                friend ScalarLanes operator/(ScalarLanes a, ScalarLanes b) { return { a.v / b.v }; }
+
+                friend ScalarLanes floor(ScalarLanes a) { return { std::floor(a.v) }; }
+                friend ScalarLanes abs(ScalarLanes a) { return { std::fabs(a.v) }; }
+                friend ScalarLanes min(ScalarLanes a, ScalarLanes b) { return { a.v < b.v ? a.v : b.v }; }
+                friend ScalarLanes max(ScalarLanes a, ScalarLanes b) { return { a.v > b.v ? a.v : b.v }; }
+
+                // Same as glm::step: 0 if x < edge, 1 otherwise
+                friend ScalarLanes step(ScalarLanes edge, ScalarLanes x) { return { x.v < edge.v ? 0.0f : 1.0f }; }
+            };
+
+#if defined(GEM_NOISE_SSE2) || defined(GEM_NOISE_AVX2)
+
+            /**
+             * @brief Four floats in an SSE register.
+             */
+            struct SseLanes {
+                static constexpr size_t WIDTH = 4;
+
+                __m128 v;
+
+                static SseLanes load(const float* p) { return { _mm_loadu_ps(p) }; }
+                static SseLanes broadcast(float f) { return { _mm_set1_ps(f) }; }
+                static SseLanes iota(float start, float step) {
+                    return { _mm_add_ps(_mm_set1_ps(start), _mm_mul_ps(_mm_set1_ps(step), _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f))) };
+                }
+                void store(float* p) const { _mm_storeu_ps(p, v); }
+
+                friend SseLanes operator+(SseLanes a, SseLanes b) { return { _mm_add_ps(a.v, b.v) }; }
+                friend SseLanes operator-(SseLanes a, SseLanes b) { return { _mm_sub_ps(a.v, b.v) }; }
+                friend SseLanes operator*(SseLanes a, SseLanes b) { return { _mm_mul_ps(a.v, b.v) }; }
+                friend SseLanes operator/(SseLanes a, SseLanes b) { return { _mm_div_ps(a.v, b.v) }; }
+
+                friend SseLanes floor(SseLanes a) {
+#if defined(__SSE4_1__) || defined(__AVX__)
+                    return { _mm_floor_ps(a.v) };
+#else
+                    // Truncate, then step down where truncation rounded up (negative values).
+                    // Exact for |a| < 2^31, far beyond the 289 period of the lattice.
+                    const __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(a.v));
+                    const __m128 correction = _mm_and_ps(_mm_cmpgt_ps(truncated, a.v), _mm_set1_ps(1.0f));
+                    return { _mm_sub_ps(truncated, correction) };
+#endif
+                }
+                friend SseLanes abs(SseLanes a) { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v) }; }
+                friend SseLanes min(SseLanes a, SseLanes b) { return { _mm_min_ps(a.v, b.v) }; }
+                friend SseLanes max(SseLanes a, SseLanes b) { return { _mm_max_ps(a.v, b.v) }; }
+
+                friend SseLanes step(SseLanes edge, SseLanes x) {
+                    return { _mm_and_ps(_mm_cmpge_ps(x.v, edge.v), _mm_set1_ps(1.0f)) };
+                }
+            };
+
+#endif
+
+#if defined(GEM_NOISE_AVX2)
+
+            /**
+             * @brief Eight floats in an AVX register.
+             */
+            struct AvxLanes {
+                static constexpr size_t WIDTH = 8;
+
+                __m256 v;
+
+                static AvxLanes load(const float* p) { return { _mm256_loadu_ps(p) }; }
+                static AvxLanes broadcast(float f) { return { _mm256_set1_ps(f) }; }
+                static AvxLanes iota(float start, float step) {
+                    const __m256 index = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+                    return { _mm256_add_ps(_mm256_set1_ps(start), _mm256_mul_ps(_mm256_set1_ps(step), index)) };
+                }
+                void store(float* p) const { _mm256_storeu_ps(p, v); }
+
+                friend AvxLanes operator+(AvxLanes a, AvxLanes b) { return { _mm256_add_ps(a.v, b.v) }; }
+                friend AvxLanes operator-(AvxLanes a, AvxLanes b) { return { _mm256_sub_ps(a.v, b.v) }; }
+                friend AvxLanes operator*(AvxLanes a, AvxLanes b) { return { _mm256_mul_ps(a.v, b.v) }; }
+                friend AvxLanes operator/(AvxLanes a, AvxLanes b) { return { _mm256_div_ps(a.v, b.v) }; }
+
+                friend AvxLanes floor(AvxLanes a) { return { _mm256_floor_ps(a.v) }; }
+                friend AvxLanes abs(AvxLanes a) { return { _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v) }; }
+                friend AvxLanes min(AvxLanes a, AvxLanes b) { return { _mm256_min_ps(a.v, b.v) }; }
+                friend AvxLanes max(AvxLanes a, AvxLanes b) { return { _mm256_max_ps(a.v, b.v) }; }
+
+                friend AvxLanes step(AvxLanes edge, AvxLanes x) {
+                    return { _mm256_and_ps(_mm256_cmp_ps(x.v, edge.v, _CMP_GE_OQ), _mm256_set1_ps(1.0f)) };
+                }
+            };
+
+            using WideLanes = AvxLanes;
+            constexpr const char* INSTRUCTION_SET = "AVX2";
+
+#elif defined(GEM_NOISE_SSE2)
+
+            using WideLanes = SseLanes;
+            constexpr const char* INSTRUCTION_SET = "SSE2";
+
+#else
+
+            using WideLanes = ScalarLanes;
+            constexpr const char* INSTRUCTION_SET = "Scalar";
+
+#endif
+
+            // Helpers shared with glm (detail/_noise.hpp)
+
+            template<typename L>
+            inline L constant(float f) {
+                return L::broadcast(f);
+            }
+
+            template<typename L>
+            inline L fract(L x) {
+                return x - floor(x);
+            }
+
+            template<typename L>
+            inline L mod289(L x) {
+                return x - floor(x * constant<L>(1.0f / 289.0f)) * constant<L>(289.0f);
+            }
+
+            // glm::mod(x, 289), which divides where mod289 multiplies
+            template<typename L>
+            inline L mod289Div(L x) {
+                return x - constant<L>(289.0f) * floor(x / constant<L>(289.0f));
+            }
+
+            template<typename L>
+            inline L permute(L x) {
+                return mod289(((x * constant<L>(34.0f)) + constant<L>(1.0f)) * x);
+            }
+
+            template<typename L>
+            inline L taylorInvSqrt(L r) {
+                return constant<L>(1.79284291400159f) - constant<L>(0.85373472095314f) * r;
+            }
+
+            template<typename L>
+            inline L fade(L t) {
+                return (t * t * t) * (t * (t * constant<L>(6.0f) - constant<L>(15.0f)) + constant<L>(10.0f));
+            }
+
+            template<typename L>
+            inline L mix(L x, L y, L a) {
+                return x * (constant<L>(1.0f) - a) + y * a;
+            }
+
+            // Noise functions
+
+            /**
+             * @brief Classic Perlin noise, port of glm::perlin(vec2).
+             */
+            struct PerlinKernel {
+
+                template<typename L>
+                static L evaluate(L x, L y) {
+                    const L one = constant<L>(1.0f);
+
+                    const L ix0 = mod289Div(floor(x));
+                    const L iy0 = mod289Div(floor(y));
+                    const L ix1 = mod289Div(floor(x) + one);
+                    const L iy1 = mod289Div(floor(y) + one);
+
+                    const L fx0 = fract(x);
+                    const L fy0 = fract(y);
+                    const L fx1 = fx0 - one;
+                    const L fy1 = fy0 - one;
+
+                    const L px0 = permute(ix0);
+                    const L px1 = permute(ix1);
+
+                    const L n00 = corner2D(permute(px0 + iy0), fx0, fy0);
+                    const L n10 = corner2D(permute(px1 + iy0), fx1, fy0);
+                    const L n01 = corner2D(permute(px0 + iy1), fx0, fy1);
+                    const L n11 = corner2D(permute(px1 + iy1), fx1, fy1);
+
+                    const L fadeX = fade(fx0);
+                    const L fadeY = fade(fy0);
+
+                    const L nx0 = mix(n00, n10, fadeX);
+                    const L nx1 = mix(n01, n11, fadeX);
+                    return constant<L>(2.3f) * mix(nx0, nx1, fadeY);
+                }
+
+                template<typename L>
+                static L evaluate(L x, L y, L z) {
+                    const L one = constant<L>(1.0f);
+
+                    const L ix[2] = { mod289(floor(x)), mod289(floor(x) + one) };
+                    const L iy[2] = { mod289(floor(y)), mod289(floor(y) + one) };
+                    const L iz[2] = { mod289(floor(z)), mod289(floor(z) + one) };
+
+                    const L fx[2] = { fract(x), fract(x) - one };
+                    const L fy[2] = { fract(y), fract(y) - one };
+                    const L fz[2] = { fract(z), fract(z) - one };
+
+                    const L px[2] = { permute(ix[0]), permute(ix[1]) };
+
+                    // n[c][b][a] is the corner at x offset a, y offset b and z offset c
+                    L n[2][2][2] = {};
+                    for (int b = 0; b < 2; ++b) {
+                        for (int a = 0; a < 2; ++a) {
+                            const L ixy = permute(px[a] + iy[b]);
+                            for (int c = 0; c < 2; ++c) {
+                                n[c][b][a] = corner3D(permute(ixy + iz[c]), fx[a], fy[b], fz[c]);
+                            }
+                        }
+                    }
+
+                    const L fadeX = fade(fx[0]);
+                    const L fadeY = fade(fy[0]);
+                    const L fadeZ = fade(fz[0]);
+
+                    const L nz00 = mix(n[0][0][0], n[1][0][0], fadeZ);
+                    const L nz10 = mix(n[0][0][1], n[1][0][1], fadeZ);
+                    const L nz01 = mix(n[0][1][0], n[1][1][0], fadeZ);
+                    const L nz11 = mix(n[0][1][1], n[1][1][1], fadeZ);
+
+                    const L nyz0 = mix(nz00, nz01, fadeY);
+                    const L nyz1 = mix(nz10, nz11, fadeY);
+                    return constant<L>(2.2f) * mix(nyz0, nyz1, fadeX);
+                }
+
+            private:
+
+                // Gradient of a 2D corner: 41 points on a line mapped onto a diamond
+                template<typename L>
+                static L corner2D(L hash, L fx, L fy) {
+                    const L half = constant<L>(0.5f);
+
+                    L gx = constant<L>(2.0f) * fract(hash / constant<L>(41.0f)) - constant<L>(1.0f);
+                    const L gy = abs(gx) - half;
+                    gx = gx - floor(gx + half);
+
+                    const L norm = taylorInvSqrt(gx * gx + gy * gy);
+                    return (gx * norm) * fx + (gy * norm) * fy;
+                }
+
+                // Gradient of a 3D corner: 7x7 points on a square mapped onto an octahedron
+                template<typename L>
+                static L corner3D(L hash, L fx, L fy, L fz) {
+                    const L zero = constant<L>(0.0f);
+                    const L half = constant<L>(0.5f);
+                    const L seventh = constant<L>(static_cast<float>(1.0 / 7.0));
+
+                    L gx = hash * seventh;
+                    L gy = fract(floor(gx) * seventh) - half;
+                    gx = fract(gx);
+                    const L gz = half - abs(gx) - abs(gy);
+                    const L sz = step(gz, zero);
+                    gx = gx - sz * (step(zero, gx) - half);
+                    gy = gy - sz * (step(zero, gy) - half);
+
+                    const L norm = taylorInvSqrt(gx * gx + gy * gy + gz * gz);
+                    return (gx * norm) * fx + (gy * norm) * fy + (gz * norm) * fz;
+                }
+            };
+
+            /**
+             * @brief Simplex noise, port of glm::simplex(vec2) and glm::simplex(vec3).
+             */
+            struct SimplexKernel {
+
+                template<typename L>
+                static L evaluate(L x, L y) {
+                    const L cx = constant<L>(0.211324865405187f);   // (3.0 -  sqrt(3.0)) / 6.0
+                    const L cy = constant<L>(0.366025403784439f);   //  0.5 * (sqrt(3.0)  - 1.0)
+                    const L cz = constant<L>(-0.577350269189626f);  // -1.0 + 2.0 * C.x
+                    const L zero = constant<L>(0.0f);
+                    const L one = constant<L>(1.0f);
+                    const L half = constant<L>(0.5f);
+
+                    // First corner
+                    const L skew = x * cy + y * cy;
+                    L ix = floor(x + skew);
+                    L iy = floor(y + skew);
+                    const L unskew = ix * cx + iy * cx;
+                    const L x0 = x - ix + unskew;
+                    const L y0 = y - iy + unskew;
+
+                    // Other corners, i1 = (1, 0) if x0 > y0, (0, 1) otherwise
+                    const L i1x = one - step(x0, y0);
+                    const L i1y = one - i1x;
+
+                    const L x1 = x0 + cx - i1x;
+                    const L y1 = y0 + cx - i1y;
+                    const L x2 = x0 + cz;
+                    const L y2 = y0 + cz;
+
+                    // Permutations
+                    ix = mod289Div(ix);
+                    iy = mod289Div(iy);
+                    const L p0 = permute(permute(iy) + ix);
+                    const L p1 = permute(permute(iy + i1y) + ix + i1x);
+                    const L p2 = permute(permute(iy + one) + ix + one);
+
+                    L m0 = max(half - (x0 * x0 + y0 * y0), zero);
+                    L m1 = max(half - (x1 * x1 + y1 * y1), zero);
+                    L m2 = max(half - (x2 * x2 + y2 * y2), zero);
+                    m0 = m0 * m0; m0 = m0 * m0;
+                    m1 = m1 * m1; m1 = m1 * m1;
+                    m2 = m2 * m2; m2 = m2 * m2;
+
+                    return constant<L>(130.0f) * (corner2D(p0, m0, x0, y0) + corner2D(p1, m1, x1, y1) + corner2D(p2, m2, x2, y2));
+                }
+
+                template<typename L>
+                static L evaluate(L x, L y, L z) {
+                    const L cx = constant<L>(1.0f / 6.0f);
+                    const L cy = constant<L>(1.0f / 3.0f);
+                    const L zero = constant<L>(0.0f);
+                    const L one = constant<L>(1.0f);
+                    const L half = constant<L>(0.5f);
+
+                    // First corner
+                    const L skew = x * cy + y * cy + z * cy;
+                    L ix = floor(x + skew);
+                    L iy = floor(y + skew);
+                    L iz = floor(z + skew);
+                    const L unskew = ix * cx + iy * cx + iz * cx;
+                    const L x0[3] = { x - ix + unskew, y - iy + unskew, z - iz + unskew };
+
+                    // Other corners
+                    const L g[3] = { step(x0[1], x0[0]), step(x0[2], x0[1]), step(x0[0], x0[2]) };
+                    const L l[3] = { one - g[0], one - g[1], one - g[2] };
+                    const L i1[3] = { min(g[0], l[2]), min(g[1], l[0]), min(g[2], l[1]) };
+                    const L i2[3] = { max(g[0], l[2]), max(g[1], l[0]), max(g[2], l[1]) };
+
+                    L corners[4][3];
+                    for (int a = 0; a < 3; ++a) {
+                        corners[0][a] = x0[a];
+                        corners[1][a] = x0[a] - i1[a] + cx;
+                        corners[2][a] = x0[a] - i2[a] + cy;
+                        corners[3][a] = x0[a] - half;
+                    }
+
+                    // Permutations
+                    ix = mod289(ix);
+                    iy = mod289(iy);
+                    iz = mod289(iz);
+
+                    const L offsets[4][3] = {
+                        { zero, zero, zero },
+                        { i1[0], i1[1], i1[2] },
+                        { i2[0], i2[1], i2[2] },
+                        { one, one, one }
+                    };
+
+                    L sum = zero;
+                    for (int k = 0; k < 4; ++k) {
+                        const L p = permute(permute(permute(iz + offsets[k][2]) + iy + offsets[k][1]) + ix + offsets[k][0]);
+                        const L* c = corners[k];
+
+                        L m = max(constant<L>(0.6f) - (c[0] * c[0] + c[1] * c[1] + c[2] * c[2]), zero);
+                        m = m * m;
+                        sum = sum + (m * m) * corner3D(p, c[0], c[1], c[2]);
+                    }
+
+                    return constant<L>(42.0f) * sum;
+                }
+
+            private:
+
+                // Gradients: 41 points uniformly over a line, mapped onto a diamond
+                template<typename L>
+                static L corner2D(L hash, L m, L x, L y) {
+                    const L half = constant<L>(0.5f);
+                    const L cw = constant<L>(0.024390243902439f); // 1.0 / 41.0
+
+                    const L gx = constant<L>(2.0f) * fract(hash * cw) - constant<L>(1.0f);
+                    const L h = abs(gx) - half;
+                    const L a0 = gx - floor(gx + half);
+
+                    // Normalise gradients implicitly by scaling m
+                    m = m * (constant<L>(1.79284291400159f) - constant<L>(0.85373472095314f) * (a0 * a0 + h * h));
+                    return m * (a0 * x + h * y);
+                }
+
+                // Gradients: 7x7 points over a square, mapped onto an octahedron
+                template<typename L>
+                static L corner3D(L p, L x, L y, L z) {
+                    const L zero = constant<L>(0.0f);
+                    const L one = constant<L>(1.0f);
+                    const L two = constant<L>(2.0f);
+
+                    const L n = constant<L>(0.142857142857f); // 1.0/7.0
+                    const L nsx = n * two;
+                    const L nsy = n * constant<L>(0.5f) - one;
+                    const L nsz = n * one;
+
+                    const L j = p - constant<L>(49.0f) * floor(p * nsz * nsz); // mod(p,7*7)
+
+                    const L gridX = floor(j * nsz);
+                    const L gridY = floor(j - constant<L>(7.0f) * gridX); // mod(j,N)
+
+                    L gx = gridX * nsx + nsy;
+                    L gy = gridY * nsx + nsy;
+                    const L gz = one - abs(gx) - abs(gy);
+
+                    const L sh = zero - step(gz, zero);
+                    gx = gx + (floor(gx) * two + one) * sh;
+                    gy = gy + (floor(gy) * two + one) * sh;
+
+                    const L norm = taylorInvSqrt(gx * gx + gy * gy + gz * gz);
+                    return (gx * norm) * x + (gy * norm) * y + (gz * norm) * z;
+                }
+            };
+
+            /**
+             * @brief Value noise: a random value per lattice point, blended with the Perlin fade curve.
+             */
+            struct ValueKernel {
+
+                template<typename L>
+                static L evaluate(L x, L y) {
+                    const L one = constant<L>(1.0f);
+
+                    const L ix0 = mod289(floor(x));
+                    const L iy0 = mod289(floor(y));
+                    const L ix1 = mod289(floor(x) + one);
+                    const L iy1 = mod289(floor(y) + one);
+
+                    const L px0 = permute(ix0);
+                    const L px1 = permute(ix1);
+
+                    const L fadeX = fade(fract(x));
+                    const L fadeY = fade(fract(y));
+
+                    const L v0 = mix(corner(permute(px0 + iy0)), corner(permute(px1 + iy0)), fadeX);
+                    const L v1 = mix(corner(permute(px0 + iy1)), corner(permute(px1 + iy1)), fadeX);
+                    return mix(v0, v1, fadeY);
+                }
+
+                template<typename L>
+                static L evaluate(L x, L y, L z) {
+                    const L one = constant<L>(1.0f);
+
+                    const L ix[2] = { mod289(floor(x)), mod289(floor(x) + one) };
+                    const L iy[2] = { mod289(floor(y)), mod289(floor(y) + one) };
+                    const L iz[2] = { mod289(floor(z)), mod289(floor(z) + one) };
+
+                    const L px[2] = { permute(ix[0]), permute(ix[1]) };
+
+                    const L fadeX = fade(fract(x));
+                    const L fadeY = fade(fract(y));
+                    const L fadeZ = fade(fract(z));
+
+                    L vz[2];
+                    for (int c = 0; c < 2; ++c) {
+                        L vy[2];
+                        for (int b = 0; b < 2; ++b) {
+                            const L v0 = corner(permute(permute(px[0] + iy[b]) + iz[c]));
+                            const L v1 = corner(permute(permute(px[1] + iy[b]) + iz[c]));
+                            vy[b] = mix(v0, v1, fadeX);
+                        }
+                        vz[c] = mix(vy[0], vy[1], fadeY);
+                    }
+
+                    return mix(vz[0], vz[1], fadeZ);
+                }
+
+            private:
+
+                // Maps a permutation value in [0, 289) to [-1, 1]
+                template<typename L>
+                static L corner(L hash) {
+                    return hash * constant<L>(2.0f / 288.0f) - constant<L>(1.0f);
+                }
+            };
+
+            // Batched evaluation
+
+            template<typename Kernel>
+            void sampleArrays(const float* x, const float* y, const glm::vec3& offset, float* out, size_t count) {
+                const WideLanes ox = WideLanes::broadcast(offset.x);
+                const WideLanes oy = WideLanes::broadcast(offset.y);
+
+                size_t i = 0;
+                for (; i + WideLanes::WIDTH <= count; i += WideLanes::WIDTH) {
+                    Kernel::evaluate(WideLanes::load(x + i) + ox, WideLanes::load(y + i) + oy).store(out + i);
+                }
+                for (; i < count; ++i) {
+                    out[i] = Kernel::evaluate(ScalarLanes{ x[i] + offset.x }, ScalarLanes{ y[i] + offset.y }).v;
+                }
+            }
+
+            template<typename Kernel>
+            void sampleArrays(const float* x, const float* y, const float* z, const glm::vec3& offset, float* out, size_t count) {
+                const WideLanes ox = WideLanes::broadcast(offset.x);
+                const WideLanes oy = WideLanes::broadcast(offset.y);
+                const WideLanes oz = WideLanes::broadcast(offset.z);
+
+                size_t i = 0;
+                for (; i + WideLanes::WIDTH <= count; i += WideLanes::WIDTH) {
+                    Kernel::evaluate(WideLanes::load(x + i) + ox, WideLanes::load(y + i) + oy, WideLanes::load(z + i) + oz).store(out + i);
+                }
+                for (; i < count; ++i) {
+                    out[i] = Kernel::evaluate(ScalarLanes{ x[i] + offset.x }, ScalarLanes{ y[i] + offset.y }, ScalarLanes{ z[i] + offset.z }).v;
+                }
+            }
+
+            /**
+             * @brief Precomputed frequency, amplitude and lattice offset of each octave.
+             */
+            struct Octave {
+                float frequency;
+                float amplitude;
+                glm::vec3 offset;
+            };
+
+            std::vector<Octave> buildOctaves(const FractalSettings& settings, const glm::vec3& offset) {
+                std::vector<Octave> octaves;
+
+                float frequency = settings.frequency;
+                float amplitude = 1.0f;
+                float total = 0.0f;
+
+                for (uint32_t o = 0; o < std::max(settings.octaves, 1u); ++o) {
+                    // Shift each octave so their lattices do not line up at the origin
+                    const glm::vec3 shift = offset + glm::vec3(31.7f, 47.3f, 59.1f) * static_cast<float>(o);
+
+                    octaves.push_back({ frequency, amplitude, shift });
+                    total += amplitude;
+
+                    frequency *= settings.lacunarity;
+                    amplitude *= settings.gain;
+                }
+
+                // Normalise so the sum stays within the range of a single octave
+                for (Octave& octave : octaves) {
+                    octave.amplitude /= total;
+                }
+
+                return octaves;
+            }
+
+            /**
+             * @brief Fills one row of a grid, along x, with fBm.
+             * @param y The y-coordinate of the row, before scaling.
+             * @param z The z-coordinate of the row, before scaling. Ignored by 2D grids.
+             */
+            template<typename Kernel, bool Is3D>
+            void fillRow(float originX, float stepX, uint32_t width, float y, float z, const std::vector<Octave>& octaves, float* out) {
+                uint32_t x = 0;
+
+                for (; x + WideLanes::WIDTH <= width; x += WideLanes::WIDTH) {
+                    const WideLanes px = WideLanes::iota(originX + stepX * x, stepX);
+
+                    WideLanes sum = WideLanes::broadcast(0.0f);
+                    for (const Octave& octave : octaves) {
+                        const WideLanes frequency = WideLanes::broadcast(octave.frequency);
+                        const WideLanes sx = px * frequency + WideLanes::broadcast(octave.offset.x);
+                        const WideLanes sy = WideLanes::broadcast(y * octave.frequency + octave.offset.y);
+
+                        WideLanes value;
+                        if constexpr (Is3D) {
+                            value = Kernel::evaluate(sx, sy, WideLanes::broadcast(z * octave.frequency + octave.offset.z));
+                        }
+                        else {
+                            value = Kernel::evaluate(sx, sy);
+                        }
+
+                        sum = sum + value * WideLanes::broadcast(octave.amplitude);
+                    }
+
+                    sum.store(out + x);
+                }
+
+                for (; x < width; ++x) {
+                    const float px = originX + stepX * x;
+
+                    float sum = 0.0f;
+                    for (const Octave& octave : octaves) {
+                        const ScalarLanes sx{ px * octave.frequency + octave.offset.x };
+                        const ScalarLanes sy{ y * octave.frequency + octave.offset.y };
+
+                        float value;
+                        if constexpr (Is3D) {
+                            value = Kernel::evaluate(sx, sy, ScalarLanes{ z * octave.frequency + octave.offset.z }).v;
+                        }
+                        else {
+                            value = Kernel::evaluate(sx, sy).v;
+                        }
+
+                        sum += value * octave.amplitude;
+                    }
+
+                    out[x] = sum;
+                }
+            }
+
+            template<typename Kernel>
+            void fillGrid2D(const glm::vec2& origin, const glm::vec2& step, const glm::uvec2& size, const std::vector<Octave>& octaves, float* out) {
+                for (uint32_t y = 0; y < size.y; ++y) {
+                    fillRow<Kernel, false>(origin.x, step.x, size.x, origin.y + step.y * y, 0.0f, octaves, out + size_t(y) * size.x);
+                }
+            }
+
+            template<typename Kernel>
+            void fillGrid3D(const glm::vec3& origin, const glm::vec3& step, const glm::uvec3& size, const std::vector<Octave>& octaves, float* out) {
+                for (uint32_t z = 0; z < size.z; ++z) {
+                    for (uint32_t y = 0; y < size.y; ++y) {
+                        float* row = out + (size_t(z) * size.y + y) * size.x;
+                        fillRow<Kernel, true>(origin.x, step.x, size.x, origin.y + step.y * y, origin.z + step.z * z, octaves, row);
+                    }
+                }
+            }
+
+            /**
+             * @brief Calls a function template with the kernel of a noise type.
+             */
+            template<typename Function>
+            auto dispatch(NoiseType type, Function&& function) {
+                switch (type) {
+                case NoiseType::Simplex:
+                    return function(SimplexKernel());
+                case NoiseType::Value:
+                    return function(ValueKernel());
+                case NoiseType::Perlin:
+                default:
+                    return function(PerlinKernel());
+                }
+            }
+
+            /**
+             * @brief Spreads the bits of a seed into a lattice offset within one period.
+             */
+            glm::vec3 seedOffset(uint32_t seed) {
+                if (seed == 0) {
+                    return glm::vec3(0.0f);
+                }
+
+                uint32_t h = seed;
+                auto next = [&h]() {
+                    // xorshift32
+                    h ^= h << 13;
+                    h ^= h >> 17;
+                    h ^= h << 5;
+                    return static_cast<float>(h % 289u);
+                };
+
+                const float x = next();
+                const float y = next();
+                const float z = next();
+                return glm::vec3(x, y, z);
+            }
+
+        } // namespace
+
+        Noise::Noise(uint32_t seed)
+            : seed_(seed), offset_(seedOffset(seed)) {
+        }
+
+        float Noise::sample(NoiseType type, const glm::vec2& position) const {
+            return dispatch(type, [&](auto kernel) {
+                return decltype(kernel)::evaluate(ScalarLanes{ position.x + offset_.x }, ScalarLanes{ position.y + offset_.y }).v;
+            });
+        }
+
+        float Noise::sample(NoiseType type, const glm::vec3& position) const {
+            return dispatch(type, [&](auto kernel) {
+                return decltype(kernel)::evaluate(ScalarLanes{ position.x + offset_.x }, ScalarLanes{ position.y + offset_.y }, ScalarLanes{ position.z + offset_.z }).v;
+            });
+        }
+
+        float Noise::fractal(const glm::vec2& position, const FractalSettings& settings) const {
+            float sum = 0.0f;
+            for (const Octave& octave : buildOctaves(settings, offset_)) {
+                const glm::vec2 p = position * octave.frequency + glm::vec2(octave.offset);
+
+                sum += octave.amplitude * dispatch(settings.type, [&](auto kernel) {
+                    return decltype(kernel)::evaluate(ScalarLanes{ p.x }, ScalarLanes{ p.y }).v;
+                });
+            }
+            return sum;
+        }
+
+        float Noise::fractal(const glm::vec3& position, const FractalSettings& settings) const {
+            float sum = 0.0f;
+            for (const Octave& octave : buildOctaves(settings, offset_)) {
+                const glm::vec3 p = position * octave.frequency + octave.offset;
+
+                sum += octave.amplitude * dispatch(settings.type, [&](auto kernel) {
+                    return decltype(kernel)::evaluate(ScalarLanes{ p.x }, ScalarLanes{ p.y }, ScalarLanes{ p.z }).v;
+                });
+            }
+            return sum;
+        }
+
+        void Noise::sample(NoiseType type, const float* x, const float* y, float* out, size_t count) const {
+            dispatch(type, [&](auto kernel) {
+                sampleArrays<decltype(kernel)>(x, y, offset_, out, count);
+            });
+        }
+
+        void Noise::sample(NoiseType type, const float* x, const float* y, const float* z, float* out, size_t count) const {
+            dispatch(type, [&](auto kernel) {
+                sampleArrays<decltype(kernel)>(x, y, z, offset_, out, count);
+            });
+        }
+
+        void Noise::fillGrid(const glm::vec2& origin, const glm::vec2& step, const glm::uvec2& size, const FractalSettings& settings, float* out) const {
+            const std::vector<Octave> octaves = buildOctaves(settings, offset_);
+
+            dispatch(settings.type, [&](auto kernel) {
+                fillGrid2D<decltype(kernel)>(origin, step, size, octaves, out);
+            });
+        }
+
+        void Noise::fillGrid(const glm::vec3& origin, const glm::vec3& step, const glm::uvec3& size, const FractalSettings& settings, float* out) const {
+            const std::vector<Octave> octaves = buildOctaves(settings, offset_);
+
+            dispatch(settings.type, [&](auto kernel) {
+                fillGrid3D<decltype(kernel)>(origin, step, size, octaves, out);
+            });
+        }
+
+        uint32_t Noise::getSeed() const noexcept {
+            return seed_;
+        }
+
+        uint32_t Noise::getLaneCount() noexcept {
+            return static_cast<uint32_t>(WideLanes::WIDTH);
+        }
+
+        const char* Noise::getInstructionSet() noexcept {
+            return INSTRUCTION_SET;
+        }
+
+    } // namespace Math
+} // namespace Gem
@@ -0,0 +1,272 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <Gem/Voxel/block_shape.h>
+#include <Gem/Voxel/chunk.h>
+#include <Gem/Voxel/chunk_coord.h>
+
+/**
+ * @file block_registry.h
+ * @brief Declaration of the BlockDefinition struct and the BlockRegistry class.
+ */
+
+namespace Gem {
+    namespace Voxel {
+
+        /**
+         * @struct BlockDefinition
+         * @brief Description of a block type, turned into table rows by BlockRegistry::add().
+         */
+        struct BlockDefinition {
+            std::string name;                               ///< Unique name of the block.
+            bool solid = true;                              ///< Blocks movement.
+            bool opaque = true;                             ///< Hides the faces behind it and stops light.
+            uint8_t emission = 0;                           ///< Block light emitted, from 0 to MAX_LIGHT.
+            std::array<std::string, FACE_COUNT> textures;   ///< Texture file of each face, indexed by Face.
+            BlockShape shape = BlockShape::cube();          ///< Geometry. Only opaque blocks hide the faces of their neighbours.
+
+            /**
+             * @brief Describes an opaque block with the same texture on every face.
+             * @param name The block name.
+             * @param texture The texture file.
+             * @return The definition.
+             */
+            static BlockDefinition cube(std::string name, const std::string& texture);
+
+            /**
+             * @brief Describes an opaque block with its own textures on the top and bottom faces.
+             * @param name The block name.
+             * @param side The texture file of the four side faces.
+             * @param top The texture file of the +y face.
+             * @param bottom The texture file of the -y face.
+             * @return The definition.
+             */
+            static BlockDefinition column(std::string name, const std::string& side, const std::string& top, const std::string& bottom);
+        };
+
+        constexpr uint8_t MAX_FLUID_LEVEL = 8;     ///< Level of fluid sources and falling fluid; flowing fluid goes from 1 to MAX_FLUID_LEVEL - 1.
+
+        /**
+         * @struct FluidDefinition
+         * @brief Description of a fluid, turned into one block per fluid state by BlockRegistry::addFluid().
+         */
+        struct FluidDefinition {
+            std::string name;           ///< Unique name of the source block, the other states get suffixes.
+            std::string texture;        ///< Texture file of every face.
+            uint8_t decay = 1;          ///< Levels lost per voxel of horizontal flow.
+            uint8_t interval = 1;       ///< Simulation ticks between two updates of the fluid, higher flows slower.
+            uint8_t emission = 0;       ///< Block light emitted, from 0 to MAX_LIGHT.
+        };
+
+        /**
+         * @class BlockRegistry
+         * @brief Assigns compact 16-bit IDs to block types and stores their properties.
+         *
+         * ID 0 is always air. Other IDs are given in registration order, so registering the same blocks in
+         * the same order gives the same IDs, which saved chunks rely on.
+         *
+         * Properties are kept as structure-of-arrays tables indexed by block ID, so hot loops read a property
+         * with a single indexed load. The property getters do not check their argument: IDs must be lower
+         * than getCount(). The tables themselves can also be fetched once and indexed directly.
+         *
+         * Textures are numbered in order of first use, which gives their layer in the texture array the
+         * chunk meshes sample (see getTextures()). A texture shared by several faces or blocks gets one layer.
+         *
+         * A registry is filled once at start-up; it can then be read from any thread as long as no block is added.
+         */
+        class BlockRegistry {
+        public:
+            static constexpr uint16_t AIR = 0;
+
+            /**
+             * @brief Constructs a registry holding air only.
+             */
+            BlockRegistry();
+
+            /**
+             * @brief Creates a registry of the blocks shipped with the game.
+             *
+             * Dirt, grass, stone, sand, log and leaves come first and keep the IDs 1 to 6 used by
+             * WorldBlocks, then planks and cobblestone, then their slabs and the planks stairs facing each
+             * horizontal direction (east is +x, south is +z), then water and the slower, glowing lava.
+             *
+             * @return The registry.
+             */
+            static BlockRegistry createDefault();
+
+            /**
+             * @brief Registers a block type.
+             * @param definition The block to add.
+             * @return The ID of the new block.
+             * @throws std::invalid_argument if the name is empty or already taken, or a face has no texture.
+             * @throws std::length_error if every ID is taken.
+             */
+            uint16_t add(const BlockDefinition& definition);
+
+            /**
+             * @brief Registers a fluid as consecutive blocks, one per state.
+             *
+             * The source comes first and keeps the fluid name, then the falling state ("_falling") and the
+             * flowing levels 1 to MAX_FLUID_LEVEL - 1 ("_1" to "_7"). Fluids neither block movement nor hide
+             * their neighbours; their height follows their level.
+             *
+             * @param definition The fluid to add.
+             * @return The ID of the source block, which also identifies the fluid.
+             * @throws std::invalid_argument if a name is already taken, the texture is empty, or decay or interval is 0.
+             * @throws std::length_error if not enough IDs are left.
+             */
+            uint16_t addFluid(const FluidDefinition& definition);
+
+            /**
+             * @brief Gets the ID of a block by name.
+             * @param name The block name.
+             * @return The block ID.
+             * @throws std::out_of_range if no block has that name.
+             */
+            [[nodiscard]] uint16_t getId(const std::string& name) const;
+
+            /**
+             * @brief Gets a voxel of a block by name.
+             * @param name The block name.
+             * @return The voxel.
+             * @throws std::out_of_range if no block has that name.
+             */
+            [[nodiscard]] Voxel getVoxel(const std::string& name) const;
+
+            /**
+             * @brief Checks whether a block name is registered.
+             * @param name The block name.
+             * @return True if a block has that name.
+             */
+            [[nodiscard]] bool contains(const std::string& name) const;
+
+            /**
+             * @brief Gets the name of a block.
+             * @param id The block ID.
+             * @return The block name.
+             * @throws std::out_of_range if the ID is not registered.
+             */
+            [[nodiscard]] const std::string& getName(uint16_t id) const;
+
+            /**
+             * @brief Gets the number of registered blocks, air included.
+             * @return One more than the highest ID.
+             */
+            [[nodiscard]] size_t getCount() const noexcept { return names_.size(); }
+
+            [[nodiscard]] bool isSolid(uint16_t id) const noexcept { return solid_[id] != 0; }
+            [[nodiscard]] bool isOpaque(uint16_t id) const noexcept { return opaque_[id] != 0; }
+            [[nodiscard]] uint8_t getEmission(uint16_t id) const noexcept { return emission_[id]; }
+            [[nodiscard]] bool isFullCube(uint16_t id) const noexcept { return fullCube_[id] != 0; }
+
+            /**
+             * @brief Gets the part of a voxel face a block hides from its neighbour.
+             * @param id The block ID, lower than getCount().
+             * @param face The face.
+             * @return The occlusion mask (see BlockShape::getOcclusion()), 0 for blocks that are not opaque.
+             */
+            [[nodiscard]] uint16_t getOcclusion(uint16_t id, Face face) const noexcept {
+                return occlusion_[size_t(id) * FACE_COUNT + static_cast<size_t>(face)];
+            }
+
+            /**
+             * @brief Gets the fluid of a block.
+             * @param id The block ID, lower than getCount().
+             * @return The ID of the fluid source, 0 for blocks that are not fluids.
+             */
+            [[nodiscard]] uint16_t getFluid(uint16_t id) const noexcept { return fluid_[id]; }
+
+            /**
+             * @brief Gets the fluid level of a block.
+             * @param id The block ID, lower than getCount().
+             * @return MAX_FLUID_LEVEL for sources and falling fluid, 1 to MAX_FLUID_LEVEL - 1 for flowing fluid, 0 for other blocks.
+             */
+            [[nodiscard]] uint8_t getFluidLevel(uint16_t id) const noexcept { return fluidLevel_[id]; }
+
+            [[nodiscard]] bool isFluidSource(uint16_t id) const noexcept { return fluid_[id] == id && id != AIR; }
+            [[nodiscard]] bool isFluidFalling(uint16_t id) const noexcept { return fluid_[id] != AIR && id == fluid_[id] + 1; }
+            [[nodiscard]] uint8_t getFluidDecay(uint16_t id) const noexcept { return fluidDecay_[id]; }
+            [[nodiscard]] uint8_t getFluidInterval(uint16_t id) const noexcept { return fluidInterval_[id]; }
+
+            /**
+             * @brief Gets the block of a fluid state.
+             * @param fluid The ID of the fluid source.
+             * @param level The level, from 1 to MAX_FLUID_LEVEL - 1 for flowing fluid. Ignored when falling.
+             * @param falling True for the falling state.
+             * @return The block ID.
+             */
+            [[nodiscard]] static constexpr uint16_t getFluidBlock(uint16_t fluid, uint8_t level, bool falling) noexcept {
+                return static_cast<uint16_t>(falling ? fluid + 1 : fluid + 1 + level);
+            }
+
+            /**
+             * @brief Gets the geometry of a block.
+             * @param id The block ID, lower than getCount().
+             * @return The shape.
+             */
+            [[nodiscard]] const BlockShape& getShape(uint16_t id) const noexcept { return shapes_[id]; }
+
+            /**
+             * @brief Gets the texture layer of a face of a block.
+             * @param id The block ID, lower than getCount().
+             * @param face The face.
+             * @return The layer, an index in getTextures(). 0 for air.
+             */
+            [[nodiscard]] uint16_t getFaceLayer(uint16_t id, Face face) const noexcept {
+                return faceLayers_[size_t(id) * FACE_COUNT + static_cast<size_t>(face)];
+            }
+
+            // Raw tables, getCount() entries each (FACE_COUNT per block for face layers and occlusion)
+            [[nodiscard]] const uint8_t* getSolidTable() const noexcept { return solid_.data(); }
+            [[nodiscard]] const uint8_t* getOpaqueTable() const noexcept { return opaque_.data(); }
+            [[nodiscard]] const uint8_t* getEmissionTable() const noexcept { return emission_.data(); }
+            [[nodiscard]] const uint16_t* getFaceLayerTable() const noexcept { return faceLayers_.data(); }
+            [[nodiscard]] const uint8_t* getFullCubeTable() const noexcept { return fullCube_.data(); }
+            [[nodiscard]] const uint16_t* getOcclusionTable() const noexcept { return occlusion_.data(); }
+            [[nodiscard]] const uint16_t* getFluidTable() const noexcept { return fluid_.data(); }
+            [[nodiscard]] const uint8_t* getFluidLevelTable() const noexcept { return fluidLevel_.data(); }
+
+            /**
+             * @brief Gets the texture files in layer order, to fill the texture array with.
+             * @return The texture files.
+             */
+            [[nodiscard]] const std::vector<std::string>& getTextures() const noexcept { return textures_; }
+
+        private:
+
+            /**
+             * @brief Registers a block without checking its definition.
+             */
+            uint16_t append(const BlockDefinition& definition, uint16_t fluid, uint8_t level, uint8_t decay, uint8_t interval);
+
+            /**
+             * @brief Gets the layer of a texture, numbering it if it is new.
+             */
+            uint16_t getLayer(const std::string& texture);
+
+        private:
+            std::vector<std::string> names_;                    ///< Block names by ID.
+            std::unordered_map<std::string, uint16_t> ids_;     ///< Block IDs by name.
+
+            std::vector<uint8_t> solid_;                        ///< 1 for solid blocks, by ID.
+            std::vector<uint8_t> opaque_;                       ///< 1 for opaque blocks, by ID.
+            std::vector<uint8_t> emission_;                     ///< Block light emitted, by ID.
+            std::vector<uint16_t> faceLayers_;                  ///< Texture layer of each face, FACE_COUNT per ID.
+            std::vector<uint8_t> fullCube_;                     ///< 1 for full cube shapes, by ID.
+            std::vector<uint16_t> occlusion_;                   ///< Occlusion mask of each face, FACE_COUNT per ID.
+            std::vector<BlockShape> shapes_;                    ///< Geometry, by ID.
+            std::vector<uint16_t> fluid_;                       ///< Fluid source ID, 0 for other blocks, by ID.
+            std::vector<uint8_t> fluidLevel_;                   ///< Fluid level, by ID.
+            std::vector<uint8_t> fluidDecay_;                   ///< Fluid levels lost per voxel of flow, by ID.
+            std::vector<uint8_t> fluidInterval_;                ///< Simulation ticks between fluid updates, by ID.
+
+            std::vector<std::string> textures_;                 ///< Texture files by layer.
+            std::unordered_map<std::string, uint16_t> layers_;  ///< Texture layers by file.
+        };
+
+    } // namespace Voxel
+} // namespace Gem
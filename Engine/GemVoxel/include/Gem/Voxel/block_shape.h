@@ -0,0 +1,144 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include <Gem/Voxel/chunk_coord.h>
+
+/**
+ * @file block_shape.h
+ * @brief Declaration of the BlockShape class and the pre-baked quads it is made of.
+ */
+
+namespace Gem {
+    namespace Voxel {
+
+        constexpr int32_t SHAPE_RESOLUTION = 16;        ///< Shape units per voxel side.
+        constexpr int32_t SHAPE_GRID = 4;               ///< Cells per side of a face occlusion mask.
+        constexpr uint16_t FULL_FACE = 0xFFFF;          ///< Occlusion mask of a fully covered face.
+
+        /**
+         * @struct ShapeBox
+         * @brief An axis-aligned box of a shape, in shape units from 0 to SHAPE_RESOLUTION.
+         */
+        struct ShapeBox {
+            glm::ivec3 min{ 0 };                        ///< Lowest corner, inclusive.
+            glm::ivec3 max{ SHAPE_RESOLUTION };         ///< Highest corner, exclusive.
+        };
+
+        /**
+         * @struct ShapeQuad
+         * @brief A quad of a shape, ready to be copied into a chunk mesh.
+         *
+         * Corners follow the chunk mesher convention: origin, origin + du, origin + du + dv and origin + dv,
+         * in shape units relative to the voxel.
+         */
+        struct ShapeQuad {
+            glm::ivec3 origin{ 0 };     ///< First corner.
+            glm::ivec3 du{ 0 };         ///< Extent along the first tangent.
+            glm::ivec3 dv{ 0 };         ///< Extent along the second tangent.
+            int axis = 0;               ///< Axis the quad is facing (0 = x, 1 = y, 2 = z), gives its normal and texture.
+            bool backFace = false;      ///< True if the quad faces the negative direction of the axis.
+            int cullFace = -1;          ///< Voxel face the quad lies on (see Face), -1 for quads inside the voxel.
+            uint16_t coverage = 0;      ///< Cells of the cull face the quad touches, see BlockShape::getOcclusion().
+        };
+
+        /**
+         * @class BlockShape
+         * @brief The geometry of a block state and how much of each voxel face it hides.
+         *
+         * Everything the mesher needs is computed when the shape is built: the quads to copy into the mesh,
+         * and for each of the six voxel faces an occlusion mask, a 4x4 grid of cells set where the shape
+         * covers the face entirely. A quad lying on a voxel face is hidden when the neighbour covers every
+         * cell it touches, which is a single AND between the quad coverage and the neighbour mask:
+         * `(coverage & ~neighbourMask) == 0`.
+         *
+         * Mask cells are numbered along the two other axes of the face, in the same order as the tangents
+         * of chunk mesh quads (u = (axis + 1) % 3, v = (axis + 2) % 3), so opposite faces of two neighbours
+         * use the same grid: bit i + j * SHAPE_GRID covers the cell i along u and j along v.
+         */
+        class BlockShape {
+        public:
+
+            /**
+             * @brief Constructs an empty shape, the shape of air.
+             */
+            BlockShape() = default;
+
+            /**
+             * @brief A full cube.
+             * @param occluding False for cubes that hide nothing behind them, such as leaves.
+             * @return The shape.
+             */
+            static BlockShape cube(bool occluding = true);
+
+            /**
+             * @brief A half-height block.
+             * @param top True for the upper half, false for the lower one.
+             * @return The shape.
+             */
+            static BlockShape slab(bool top);
+
+            /**
+             * @brief A lower half with a quarter step on top.
+             * @param facing The side of the step, one of the horizontal faces.
+             * @return The shape.
+             * @throws std::invalid_argument if facing is a vertical face.
+             */
+            static BlockShape stairs(Face facing);
+
+            /**
+             * @brief Two double-sided quads crossing along the voxel diagonals, for plants.
+             * @return The shape. It hides nothing.
+             */
+            static BlockShape cross();
+
+            /**
+             * @brief A shape made of boxes.
+             *
+             * Box faces lying against another box of the shape are dropped.
+             *
+             * @param boxes The boxes, in shape units.
+             * @param occluding False for shapes that hide nothing behind them.
+             * @return The shape.
+             * @throws std::invalid_argument if a box is empty or leaves the voxel.
+             */
+            static BlockShape fromBoxes(const std::vector<ShapeBox>& boxes, bool occluding = true);
+
+            /**
+             * @brief Checks whether the shape is a full cube, which the mesher merges greedily.
+             * @return True for cube().
+             */
+            [[nodiscard]] bool isFullCube() const noexcept { return fullCube_; }
+
+            /**
+             * @brief Gets the part of a voxel face the shape hides from its neighbour.
+             * @param face The face.
+             * @return The occlusion mask, FULL_FACE when the face is entirely covered.
+             */
+            [[nodiscard]] uint16_t getOcclusion(Face face) const noexcept {
+                return occlusion_[static_cast<size_t>(face)];
+            }
+
+            /**
+             * @brief Gets the quads of the shape.
+             * @return The quads.
+             */
+            [[nodiscard]] const std::vector<ShapeQuad>& getQuads() const noexcept { return quads_; }
+
+            /**
+             * @brief Gets the boxes the shape was built from, which are also its collision boxes.
+             * @return The boxes, empty for air and cross().
+             */
+            [[nodiscard]] const std::vector<ShapeBox>& getBoxes() const noexcept { return boxes_; }
+
+        private:
+            std::vector<ShapeQuad> quads_;                  ///< Pre-baked geometry.
+            std::vector<ShapeBox> boxes_;                   ///< Solid volume.
+            std::array<uint16_t, FACE_COUNT> occlusion_{};  ///< Occlusion mask of each face, indexed by Face.
+            bool fullCube_ = false;                         ///< True for cube().
+        };
+
+    } // namespace Voxel
+} // namespace Gem
@@ -1,32 +1,141 @@
 #pragma once
 
 #include <GlfwGlad.h>
+#include <glm/glm.hpp>
+#include <algorithm>
 #include <array>
+#include <memory>
 #include <tuple>
+#include <vector>
 #include <stdexcept>
+#include <Gem/Voxel/chunk_layout.h>
+#include <Gem/Voxel/nibble_array.h>
+#include <Gem/Voxel/occupancy_grid.h>
+#include <Gem/Voxel/palette_storage.h>
 
 namespace Gem {
     namespace Voxel {
 
         constexpr uint8_t CHUNK_BOUNDARY = 16;
 
+        /**
+         * @class Voxel
+         * @brief A single cell of a chunk, identified by its block ID.
+         *
+         * ID 0 is reserved for air (empty space); any other ID is treated as a solid block.
+         */
         class Voxel {
-            // Assume Voxel has some meaningful implementation
+        public:
+            constexpr Voxel() noexcept = default;
+
+            /**
+             * @brief Constructs a voxel of the given block type.
+             * @param id The block ID (0 = air).
+             */
+            constexpr explicit Voxel(uint16_t id) noexcept : id_(id) {}
+
+            /**
+             * @brief Gets the block ID of the voxel.
+             * @return The block ID.
+             */
+            [[nodiscard]] constexpr uint16_t getId() const noexcept { return id_; }
+
+            /**
+             * @brief Checks whether the voxel is empty space.
+             * @return True if the voxel is air, false otherwise.
+             */
+            [[nodiscard]] constexpr bool isAir() const noexcept { return id_ == 0; }
+
+            constexpr bool operator==(const Voxel& other) const noexcept { return id_ == other.id_; }
+            constexpr bool operator!=(const Voxel& other) const noexcept { return id_ != other.id_; }
+
+        private:
+            uint16_t id_ = 0;   ///< Block ID, 0 means air.
         };
 
-        class Chunk {
+        /**
+         * @brief The two light channels stored per voxel.
+         */
+        enum class LightType : uint8_t {
+            Sky = 0,    ///< Light coming from the open sky.
+            Block = 1   ///< Light emitted by blocks.
+        };
+
+        constexpr size_t LIGHT_TYPE_COUNT = 2;
+        constexpr uint8_t MAX_LIGHT = 15;
+
+        /**
+         * @brief Draws a new chunk version from the counter shared by every chunk type.
+         * @return A version never returned before.
+         */
+        uint64_t makeChunkVersion() noexcept;
+
+        /**
+         * @class BasicChunk
+         * @brief A cube of Size^3 voxels.
+         *
+         * Voxels are kept in a PaletteStorage, so a chunk made of a single block type
+         * costs a few bytes and mixed chunks only pay for the bits they need.
+         *
+         * The chunk is split into sections of getSectionLength()^3 voxels. Edits mark the sections whose
+         * mesh may have changed as dirty, so only those need to be meshed again.
+         *
+         * An OccupancyGrid mirrors which voxels are solid (not air), kept up to date by every edit, so
+         * spatial queries can skip empty space without decoding the palette.
+         *
+         * Each voxel also holds a sky and a block light level from 0 to MAX_LIGHT, packed in nibble arrays.
+         * The chunk only stores them, see LightEngine for how they are computed.
+         *
+         * The palette indices and the light levels are copy-on-write pages (see SharedPages), so copying
+         * a chunk shares them and only copies the palette, the occupancy and a few counters. An edit then
+         * clones the page it writes, 512 voxels, and leaves the copies untouched. Background jobs take a
+         * snapshot() on the thread owning the chunk rather than locking it or copying every voxel.
+         *
+         * Accessors come in two flavours: the plain ones check their coordinates and throw, the Unchecked
+         * ones trust the caller and compile down to the shifts and masks of the layout. Hot loops whose
+         * coordinates are in range by construction should use the latter.
+         *
+         * @tparam Size The number of voxels per side. A power of two from 8 to 64.
+         * @tparam VoxelT The voxel type. Must be equality comparable, default-construct to air and provide isAir().
+         * @tparam Layout The voxel ordering of the storage, see LinearLayout and MortonLayout.
+         */
+        template<uint32_t Size, typename VoxelT, typename Layout>
+        class BasicChunk {
         public:
-            Chunk();
+            using VoxelType = VoxelT;
+            using LayoutType = Layout;
+            using LightStorage = NibbleArray<size_t(Size) * Size * Size>;
+            using Occupancy = OccupancyGrid<Size>;
+
+            BasicChunk()
+                : voxels_(volume_, VoxelT()) {
+                // All voxels start as air
+                bumpVersion();
+                dirtySections_ = getAllSections();
+            }
 
             /**
              * @brief Retrieves the voxel at the specified coordinates.
              * @param x The x-coordinate.
              * @param y The y-coordinate.
              * @param z The z-coordinate.
-             * @return Reference to the Voxel at the specified position.
+             * @return The Voxel at the specified position.
              * @throws std::out_of_range if coordinates are out of bounds.
              */
-            Voxel& getVoxel(uint32_t x, uint32_t y, uint32_t z);
+            VoxelT getVoxel(uint32_t x, uint32_t y, uint32_t z) const {
+                return voxels_.get(linearize(x, y, z));
+            }
+
+            /**
+             * @brief Retrieves the voxel at the specified coordinates without checking them.
+             * @param x The x-coordinate, lower than getLength().
+             * @param y The y-coordinate, lower than getLength().
+             * @param z The z-coordinate, lower than getLength().
+             * @return The Voxel at the specified position.
+             */
+            VoxelT getVoxelUnchecked(uint32_t x, uint32_t y, uint32_t z) const {
+                return voxels_.get(Layout::index(x, y, z));
+            }
 
             /**
              * @brief Sets the voxel at the specified coordinates.
@@ -36,48 +145,435 @@ namespace Gem {
              * @param voxel The voxel to set.
              * @throws std::out_of_range if coordinates are out of bounds.
              */
-            void setVoxel(uint32_t x, uint32_t y, uint32_t z, const Voxel& voxel);
+            void setVoxel(uint32_t x, uint32_t y, uint32_t z, const VoxelT& voxel) {
+                checkBounds(x, y, z);
+                setVoxelUnchecked(x, y, z, voxel);
+            }
+
+            /**
+             * @brief Sets the voxel at the specified coordinates without checking them.
+             * @param x The x-coordinate, lower than getLength().
+             * @param y The y-coordinate, lower than getLength().
+             * @param z The z-coordinate, lower than getLength().
+             * @param voxel The voxel to set.
+             */
+            void setVoxelUnchecked(uint32_t x, uint32_t y, uint32_t z, const VoxelT& voxel) {
+                if (voxels_.set(Layout::index(x, y, z), voxel)) {
+                    bumpVersion();
+                    occupancy_.set(x, y, z, !voxel.isAir());
+
+                    // Faces of the adjacent voxels may appear or disappear too
+                    const glm::ivec3 position(x, y, z);
+                    markRegionDirty(position - 1, position + 1);
+                }
+            }
 
             /**
-             * @brief Converts 3D coordinates to a linear index.
+             * @brief Sets every voxel of the chunk to the same value.
+             *
+             * Every light level is reset to 0.
+             *
+             * @param voxel The voxel to set.
+             */
+            void fill(const VoxelT& voxel) {
+                voxels_.fill(voxel);
+                clearLight();
+                bumpVersion();
+                dirtySections_ = getAllSections();
+                occupancy_.fill(!voxel.isAir());
+            }
+
+            /**
+             * @brief Replaces every voxel with serialised palette data.
+             *
+             * Marks every section as dirty and resets the light, like fill().
+             *
+             * @param palette The palette, see PaletteStorage::getPalette().
+             * @param words The bit-packed palette indices, see PaletteStorage::getPackedIndices().
+             * @throws std::invalid_argument if the data does not describe a valid chunk.
+             */
+            void assign(std::vector<VoxelT> palette, std::vector<uint64_t> words) {
+                voxels_.assign(std::move(palette), std::move(words));
+                clearLight();
+                bumpVersion();
+                dirtySections_ = getAllSections();
+                rebuildOccupancy();
+            }
+
+            /**
+             * @brief Gets the palette-compressed voxel data, typically to serialise it.
+             * @return The voxel storage, indexed like linearize().
+             */
+            [[nodiscard]] const PaletteStorage<VoxelT>& getStorage() const noexcept {
+                return voxels_;
+            }
+
+            /**
+             * @brief Retrieves the light level of a voxel.
+             * @param type The light channel.
              * @param x The x-coordinate.
              * @param y The y-coordinate.
              * @param z The z-coordinate.
-             * @return The linear index.
+             * @return The light level, from 0 to MAX_LIGHT.
              * @throws std::out_of_range if coordinates are out of bounds.
              */
-            static constexpr size_t linearize(uint32_t x, uint32_t y, uint32_t z);
+            [[nodiscard]] uint8_t getLight(LightType type, uint32_t x, uint32_t y, uint32_t z) const {
+                return light_[static_cast<size_t>(type)].get(linearize(x, y, z));
+            }
+
+            /**
+             * @brief Retrieves the light level of a voxel without checking its coordinates.
+             * @return The light level, from 0 to MAX_LIGHT.
+             */
+            [[nodiscard]] uint8_t getLightUnchecked(LightType type, uint32_t x, uint32_t y, uint32_t z) const noexcept {
+                return light_[static_cast<size_t>(type)].get(Layout::index(x, y, z));
+            }
+
+            /**
+             * @brief Sets the light level of a voxel.
+             *
+             * Light is derived data: the version is left unchanged and no section is marked dirty.
+             *
+             * @param type The light channel.
+             * @param x The x-coordinate.
+             * @param y The y-coordinate.
+             * @param z The z-coordinate.
+             * @param level The light level, clamped to MAX_LIGHT.
+             * @throws std::out_of_range if coordinates are out of bounds.
+             */
+            void setLight(LightType type, uint32_t x, uint32_t y, uint32_t z, uint8_t level) {
+                light_[static_cast<size_t>(type)].set(linearize(x, y, z), std::min(level, MAX_LIGHT));
+            }
+
+            /**
+             * @brief Sets the light level of a voxel without checking its coordinates.
+             * @param level The light level, clamped to MAX_LIGHT.
+             */
+            void setLightUnchecked(LightType type, uint32_t x, uint32_t y, uint32_t z, uint8_t level) {
+                light_[static_cast<size_t>(type)].set(Layout::index(x, y, z), std::min(level, MAX_LIGHT));
+            }
+
+            /**
+             * @brief Gets the light levels of a channel, indexed like linearize().
+             * @param type The light channel.
+             * @return The light storage.
+             */
+            [[nodiscard]] const LightStorage& getLightStorage(LightType type) const noexcept {
+                return light_[static_cast<size_t>(type)];
+            }
+
+            /**
+             * @brief Gets the light levels of a channel, indexed like linearize(), for bulk updates.
+             * @param type The light channel.
+             * @return The light storage.
+             */
+            [[nodiscard]] LightStorage& getLightStorage(LightType type) noexcept {
+                return light_[static_cast<size_t>(type)];
+            }
+
+            /**
+             * @brief Checks whether every voxel of the chunk is identical.
+             * @return True if the chunk holds a single block type.
+             */
+            [[nodiscard]] bool isUniform() const noexcept {
+                return voxels_.isUniform();
+            }
+
+            /**
+             * @brief Estimates the memory used by the chunk, including its voxel and light storage.
+             * @return The number of bytes.
+             */
+            [[nodiscard]] size_t getMemoryUsage() const noexcept {
+                size_t usage = sizeof(BasicChunk) + voxels_.getMemoryUsage();
+                for (const LightStorage& light : light_) {
+                    usage += light.getMemoryUsage();
+                }
+                return usage;
+            }
+
+            /**
+             * @brief Takes an immutable copy of the chunk, sharing its pages until the chunk is edited.
+             *
+             * Must be called on the thread editing the chunk. The snapshot can then be read and released
+             * from any thread, whatever happens to the chunk meanwhile.
+             *
+             * @return The snapshot.
+             */
+            [[nodiscard]] std::shared_ptr<const BasicChunk> snapshot() const {
+                return std::make_shared<const BasicChunk>(*this);
+            }
+
+            /**
+             * @brief Gets the version of the chunk content.
+             *
+             * The version changes every time a voxel is modified. Versions are drawn from a
+             * global counter, so they are never reused, even by another chunk.
+             *
+             * @return The current version.
+             */
+            [[nodiscard]] uint64_t getVersion() const noexcept {
+                return version_;
+            }
 
             /**
-             * @brief Converts a linear index to 3D coordinates.
-             * @param index The linear index.
+             * @brief Gets the sections modified since the last call to takeDirtySections().
+             * @return A bit mask with one bit per section, see getSectionIndex().
+             */
+            [[nodiscard]] uint64_t getDirtySections() const noexcept {
+                return dirtySections_;
+            }
+
+            /**
+             * @brief Gets the dirty sections and marks every section as clean.
+             * @return A bit mask with one bit per section, see getSectionIndex().
+             */
+            uint64_t takeDirtySections() noexcept {
+                const uint64_t sections = dirtySections_;
+                dirtySections_ = 0;
+                return sections;
+            }
+
+            /**
+             * @brief Marks sections as dirty.
+             * @param sections A bit mask with one bit per section.
+             */
+            void markSectionsDirty(uint64_t sections) noexcept {
+                dirtySections_ |= sections & getAllSections();
+            }
+
+            /**
+             * @brief Marks every section overlapping a box of voxels as dirty.
+             *
+             * The box is clamped to the chunk, so it may extend past the borders.
+             *
+             * @param min The lowest voxel of the box, inclusive.
+             * @param max The highest voxel of the box, inclusive.
+             */
+            void markRegionDirty(const glm::ivec3& min, const glm::ivec3& max) noexcept {
+                const glm::ivec3 low = glm::max(min, glm::ivec3(0));
+                const glm::ivec3 high = glm::min(max, glm::ivec3(length_ - 1));
+
+                if (glm::any(glm::greaterThan(low, high))) {
+                    return;
+                }
+
+                const glm::uvec3 first = glm::uvec3(low) / sectionLength_;
+                const glm::uvec3 last = glm::uvec3(high) / sectionLength_;
+
+                for (uint32_t sz = first.z; sz <= last.z; ++sz) {
+                    for (uint32_t sy = first.y; sy <= last.y; ++sy) {
+                        for (uint32_t sx = first.x; sx <= last.x; ++sx) {
+                            dirtySections_ |= uint64_t(1) << (sx + sy * sectionsPerAxis_ + sz * sectionsPerAxis_ * sectionsPerAxis_);
+                        }
+                    }
+                }
+            }
+
+            /**
+             * @brief Gets which voxels are solid, with the coarser levels telling which cells are empty.
+             *
+             * Lets ray casts and other spatial queries skip empty space without reading voxels. Empty
+             * and full chunks are told apart in O(1) by OccupancyGrid::isEmpty() and isFull().
+             *
+             * @return The occupancy, indexed x first whatever the layout.
+             */
+            [[nodiscard]] const Occupancy& getOccupancy() const noexcept {
+                return occupancy_;
+            }
+
+            /**
+             * @brief Gets the sections holding at least one solid voxel, the only ones with anything to mesh.
+             * @return A bit mask with one bit per section, see getSectionIndex().
+             */
+            [[nodiscard]] uint64_t getSolidSections() const noexcept {
+                if (occupancy_.isEmpty()) {
+                    return 0;
+                }
+
+                // Sections are made of whole cells of the coarsest level
+                constexpr uint32_t level = Occupancy::LEVEL_COUNT - 1;
+                constexpr uint32_t cell = Occupancy::getCellLength(level);
+                static_assert(sectionLength_ % cell == 0, "Sections must be made of whole occupancy cells.");
+
+                uint64_t sections = 0;
+                for (uint32_t index = 0; index < sectionCount_; ++index) {
+                    const uint32_t sx = (index % sectionsPerAxis_) * sectionLength_;
+                    const uint32_t sy = (index / sectionsPerAxis_ % sectionsPerAxis_) * sectionLength_;
+                    const uint32_t sz = (index / (sectionsPerAxis_ * sectionsPerAxis_)) * sectionLength_;
+
+                    bool solid = false;
+                    for (uint32_t z = sz; z < sz + sectionLength_ && !solid; z += cell) {
+                        for (uint32_t y = sy; y < sy + sectionLength_ && !solid; y += cell) {
+                            for (uint32_t x = sx; x < sx + sectionLength_ && !solid; x += cell) {
+                                solid = occupancy_.testCell(level, x, y, z);
+                            }
+                        }
+                    }
+                    if (solid) {
+                        sections |= uint64_t(1) << index;
+                    }
+                }
+                return sections;
+            }
+
+            /**
+             * @brief Converts 3D coordinates to a storage index.
+             * @param x The x-coordinate.
+             * @param y The y-coordinate.
+             * @param z The z-coordinate.
+             * @return The storage index.
+             * @throws std::out_of_range if coordinates are out of bounds.
+             */
+            static constexpr size_t linearize(uint32_t x, uint32_t y, uint32_t z) {
+                checkBounds(x, y, z);
+                return Layout::index(x, y, z);
+            }
+
+            /**
+             * @brief Converts 3D coordinates lower than getLength() to a storage index.
+             * @return The storage index.
+             */
+            static constexpr size_t linearizeUnchecked(uint32_t x, uint32_t y, uint32_t z) noexcept {
+                return Layout::index(x, y, z);
+            }
+
+            /**
+             * @brief Converts a storage index to 3D coordinates.
+             * @param index The storage index.
              * @return A tuple containing x, y, z coordinates.
              * @throws std::out_of_range if index is out of bounds.
              */
-            static std::tuple<uint32_t, uint32_t, uint32_t> delinearize(size_t index);
+            static constexpr std::tuple<uint32_t, uint32_t, uint32_t> delinearize(size_t index) {
+                if (index >= volume_) {
+                    throw std::out_of_range("Index out of bounds in delinearize.");
+                }
+                return Layout::coords(index);
+            }
+
+            /**
+             * @brief Converts a storage index lower than getVolume() to 3D coordinates.
+             * @return A tuple containing x, y, z coordinates.
+             */
+            static constexpr std::tuple<uint32_t, uint32_t, uint32_t> delinearizeUnchecked(size_t index) noexcept {
+                return Layout::coords(index);
+            }
 
             // Accessors for chunk dimensions
             static constexpr uint32_t getLength() { return length_; }
             static constexpr uint32_t getArea() { return area_; }
             static constexpr uint32_t getVolume() { return volume_; }
 
+            // Accessors for section dimensions
+            static constexpr uint32_t getSectionLength() { return sectionLength_; }
+            static constexpr uint32_t getSectionsPerAxis() { return sectionsPerAxis_; }
+            static constexpr uint32_t getSectionCount() { return sectionCount_; }
+
+            /**
+             * @brief Gets the bit mask selecting every section.
+             * @return The mask.
+             */
+            static constexpr uint64_t getAllSections() {
+                return (sectionCount_ == 64) ? ~uint64_t(0) : (uint64_t(1) << sectionCount_) - 1;
+            }
+
+            /**
+             * @brief Gets the index of the section containing a voxel.
+             * @param x The x-coordinate.
+             * @param y The y-coordinate.
+             * @param z The z-coordinate.
+             * @return The section index, also the bit used in section masks.
+             */
+            static constexpr uint32_t getSectionIndex(uint32_t x, uint32_t y, uint32_t z) {
+                return x / sectionLength_ + (y / sectionLength_) * sectionsPerAxis_ + (z / sectionLength_) * sectionsPerAxis_ * sectionsPerAxis_;
+            }
+
             /**
              * @brief Overloads the function call operator to access voxels.
              * @param x The x-coordinate.
              * @param y The y-coordinate.
              * @param z The z-coordinate.
-             * @return Reference to the Voxel at the specified position.
+             * @return The Voxel at the specified position.
              * @throws std::out_of_range if coordinates are out of bounds.
              */
-            Voxel& operator()(uint32_t x, uint32_t y, uint32_t z);
+            VoxelT operator()(uint32_t x, uint32_t y, uint32_t z) const {
+                return getVoxel(x, y, z);
+            }
 
         private:
-            static constexpr uint32_t length_ = CHUNK_BOUNDARY;
+            static constexpr uint32_t length_ = Size;
             static constexpr uint32_t area_ = length_ * length_;
             static constexpr uint32_t volume_ = area_ * length_;
 
-            std::array<Voxel, volume_> voxels_;
+            // Up to 4 sections per axis, so their masks fit 64 bits
+            static constexpr uint32_t sectionLength_ = (length_ / 4 > 8) ? length_ / 4 : 8;
+            static constexpr uint32_t sectionsPerAxis_ = length_ / sectionLength_;
+            static constexpr uint32_t sectionCount_ = sectionsPerAxis_ * sectionsPerAxis_ * sectionsPerAxis_;
+
+            static_assert(length_ >= 8 && length_ <= 64, "Chunk sizes range from 8 to 64.");
+            static_assert(length_ % sectionLength_ == 0, "Chunk length must be a multiple of the section length.");
+            static_assert(sectionCount_ <= 64, "Section masks are limited to 64 sections.");
+
+            /**
+             * @brief Throws if coordinates lie outside the chunk.
+             * @throws std::out_of_range if coordinates are out of bounds.
+             */
+            static constexpr void checkBounds(uint32_t x, uint32_t y, uint32_t z) {
+                if (x >= length_ || y >= length_ || z >= length_) {
+                    throw std::out_of_range("Coordinates out of bounds in linearize.");
+                }
+            }
+
+            /**
+             * @brief Assigns a new version after a modification.
+             */
+            void bumpVersion() noexcept {
+                version_ = makeChunkVersion();
+            }
+
+            /**
+             * @brief Resets every light level to 0.
+             */
+            void clearLight() {
+                for (LightStorage& light : light_) {
+                    light.fill(0);
+                }
+            }
+
+            /**
+             * @brief Recomputes the whole occupancy.
+             */
+            void rebuildOccupancy() {
+                // A uniform chunk is either entirely empty or entirely solid
+                if (voxels_.isUniform()) {
+                    occupancy_.fill(!voxels_.get(0).isAir());
+                    return;
+                }
+
+                occupancy_.fill(false);
+                for (uint32_t index = 0; index < volume_; ++index) {
+                    if (!voxels_.get(index).isAir()) {
+                        const auto [x, y, z] = Layout::coords(index);
+                        occupancy_.set(x, y, z, true);
+                    }
+                }
+            }
+
+            PaletteStorage<VoxelT> voxels_;  ///< Palette-compressed voxel data.
+            std::array<LightStorage, LIGHT_TYPE_COUNT> light_{};   ///< Light levels, indexed by LightType.
+            uint64_t version_ = 0;          ///< Content version, see getVersion().
+            uint64_t dirtySections_ = 0;    ///< Sections to mesh again, one bit each.
+            Occupancy occupancy_;           ///< Solid voxels, see getOccupancy().
         };
 
+        /**
+         * @brief The chunk used throughout the engine.
+         *
+         * The lighting, meshing and storage code walks its voxel storage with constant strides,
+         * so it relies on the linear layout.
+         */
+        using Chunk = BasicChunk<CHUNK_BOUNDARY, Voxel, LinearLayout<CHUNK_BOUNDARY>>;
+
+        extern template class BasicChunk<CHUNK_BOUNDARY, Voxel, LinearLayout<CHUNK_BOUNDARY>>;
+
     } // namespace Voxel
 } // namespace Gem
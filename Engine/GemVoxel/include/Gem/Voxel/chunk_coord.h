@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <functional>
+#include <glm/glm.hpp>
+#include <Gem/Voxel/chunk.h>
+
+/**
+ * @file chunk_coord.h
+ * @brief Declaration of the ChunkCoord structure and its hash.
+ */
+
+namespace Gem {
+    namespace Voxel {
+
+        /**
+         * @brief The six axis-aligned directions, used for chunk neighbours and voxel faces.
+         *
+         * Opposite faces differ only in their lowest bit.
+         */
+        enum class Face : uint8_t {
+            PosX = 0,
+            NegX = 1,
+            PosY = 2,
+            NegY = 3,
+            PosZ = 4,
+            NegZ = 5
+        };
+
+        constexpr size_t FACE_COUNT = 6;
+
+        /**
+         * @brief Unit offset of each Face, indexed by its value.
+         */
+        constexpr int32_t FACE_OFFSETS[FACE_COUNT][3] = {
+            {  1,  0,  0 }, { -1,  0,  0 },
+            {  0,  1,  0 }, {  0, -1,  0 },
+            {  0,  0,  1 }, {  0,  0, -1 }
+        };
+
+        /**
+         * @brief Gets the face pointing the other way.
+         */
+        constexpr Face opposite(Face face) noexcept {
+            return static_cast<Face>(static_cast<uint8_t>(face) ^ 1);
+        }
+
+        /**
+         * @struct ChunkCoord
+         * @brief Integer position of a chunk in the world, in chunk units.
+         */
+        struct ChunkCoord {
+            int32_t x = 0;
+            int32_t y = 0;
+            int32_t z = 0;
+
+            /**
+             * @brief Gets the chunk containing a world-space position.
+             * @param position The world-space position.
+             * @return The chunk coordinate.
+             */
+            static ChunkCoord fromWorld(const glm::vec3& position) noexcept {
+                const float length = static_cast<float>(Chunk::getLength());
+                return {
+                    static_cast<int32_t>(std::floor(position.x / length)),
+                    static_cast<int32_t>(std::floor(position.y / length)),
+                    static_cast<int32_t>(std::floor(position.z / length))
+                };
+            }
+
+            /**
+             * @brief Gets the chunk containing a world voxel.
+             * @param voxel The world voxel coordinates.
+             * @return The chunk coordinate.
+             */
+            static ChunkCoord fromVoxel(const glm::ivec3& voxel) noexcept {
+                const int32_t length = static_cast<int32_t>(Chunk::getLength());
+                return { floorDiv(voxel.x, length), floorDiv(voxel.y, length), floorDiv(voxel.z, length) };
+            }
+
+            /**
+             * @brief Divides rounding towards negative infinity, so negative coordinates fall in the right cell.
+             * @param value The dividend.
+             * @param divisor The divisor, positive.
+             * @return The quotient, rounded down.
+             */
+            static constexpr int32_t floorDiv(int32_t value, int32_t divisor) noexcept {
+                return (value >= 0) ? value / divisor : -((-value + divisor - 1) / divisor);
+            }
+
+            /**
+             * @brief Gets the world voxel coordinates of the chunk's (0, 0, 0) voxel.
+             * @return The world voxel coordinates.
+             */
+            [[nodiscard]] glm::ivec3 getOrigin() const noexcept {
+                const int32_t length = static_cast<int32_t>(Chunk::getLength());
+                return { x * length, y * length, z * length };
+            }
+
+            /**
+             * @brief Gets the neighbouring coordinate at an offset.
+             */
+            [[nodiscard]] ChunkCoord offset(int32_t dx, int32_t dy, int32_t dz) const noexcept {
+                return { x + dx, y + dy, z + dz };
+            }
+
+            /**
+             * @brief Gets the neighbouring coordinate across a face.
+             */
+            [[nodiscard]] ChunkCoord neighbour(Face face) const noexcept {
+                const int32_t* d = FACE_OFFSETS[static_cast<uint8_t>(face)];
+                return { x + d[0], y + d[1], z + d[2] };
+            }
+
+            bool operator==(const ChunkCoord& other) const noexcept {
+                return x == other.x && y == other.y && z == other.z;
+            }
+
+            bool operator!=(const ChunkCoord& other) const noexcept {
+                return !(*this == other);
+            }
+        };
+
+        /**
+         * @struct ChunkCoordHash
+         * @brief Hash functor for using ChunkCoord as an unordered container key.
+         */
+        struct ChunkCoordHash {
+            size_t operator()(const ChunkCoord& coord) const noexcept {
+                // Spatial hash with large primes (Teschner et al.)
+                const uint64_t h = (uint64_t(uint32_t(coord.x)) * 73856093u)
+                    ^ (uint64_t(uint32_t(coord.y)) * 19349663u)
+                    ^ (uint64_t(uint32_t(coord.z)) * 83492791u);
+                return static_cast<size_t>(h);
+            }
+        };
+
+    } // namespace Voxel
+} // namespace Gem
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+
+/**
+ * @file chunk_layout.h
+ * @brief Declaration of the voxel orderings a BasicChunk can store its voxels in.
+ *
+ * A layout maps the coordinates of a voxel to its index in the chunk storage and back. Both
+ * directions are computed with shifts and masks only, so chunk sizes must be powers of two.
+ */
+
+namespace Gem {
+    namespace Voxel {
+
+        /**
+         * @brief Gets the base-2 logarithm of a power of two.
+         */
+        constexpr uint32_t log2PowerOfTwo(uint32_t value) noexcept {
+            uint32_t shift = 0;
+            while ((1u << shift) < value) {
+                ++shift;
+            }
+            return shift;
+        }
+
+        /**
+         * @struct LinearLayout
+         * @brief Row-major ordering: x varies fastest, then y, then z.
+         *
+         * Neighbours along an axis are a constant stride apart, which the flood fills and the mesher
+         * rely on to walk the storage directly.
+         *
+         * @tparam Size The number of voxels per side. Must be a power of two.
+         */
+        template<uint32_t Size>
+        struct LinearLayout {
+            static_assert(Size != 0 && (Size & (Size - 1)) == 0, "Chunk sizes must be powers of two.");
+
+            static constexpr bool IS_LINEAR = true;
+            static constexpr uint32_t SHIFT = log2PowerOfTwo(Size);
+            static constexpr uint32_t MASK = Size - 1;
+
+            /**
+             * @brief Converts coordinates to a storage index. Coordinates must be lower than Size.
+             */
+            static constexpr size_t index(uint32_t x, uint32_t y, uint32_t z) noexcept {
+                return size_t(x) | (size_t(y) << SHIFT) | (size_t(z) << (SHIFT * 2));
+            }
+
+            /**
+             * @brief Converts a storage index to coordinates. The index must be lower than Size^3.
+             */
+            static constexpr std::tuple<uint32_t, uint32_t, uint32_t> coords(size_t index) noexcept {
+                return {
+                    static_cast<uint32_t>(index & MASK),
+                    static_cast<uint32_t>((index >> SHIFT) & MASK),
+                    static_cast<uint32_t>(index >> (SHIFT * 2))
+                };
+            }
+        };
+
+        /**
+         * @struct MortonLayout
+         * @brief Z-order ordering: the bits of x, y and z are interleaved.
+         *
+         * Voxels close in space stay close in memory along every axis, and each aligned 2^k cube is
+         * contiguous, at the cost of a few more instructions per index.
+         *
+         * @tparam Size The number of voxels per side. Must be a power of two, up to 1024.
+         */
+        template<uint32_t Size>
+        struct MortonLayout {
+            static_assert(Size != 0 && (Size & (Size - 1)) == 0, "Chunk sizes must be powers of two.");
+            static_assert(Size <= 1024, "Morton indices are limited to 10 bits per axis.");
+
+            static constexpr bool IS_LINEAR = false;
+
+            /**
+             * @brief Converts coordinates to a storage index. Coordinates must be lower than Size.
+             */
+            static constexpr size_t index(uint32_t x, uint32_t y, uint32_t z) noexcept {
+                return size_t(spread(x)) | (size_t(spread(y)) << 1) | (size_t(spread(z)) << 2);
+            }
+
+            /**
+             * @brief Converts a storage index to coordinates. The index must be lower than Size^3.
+             */
+            static constexpr std::tuple<uint32_t, uint32_t, uint32_t> coords(size_t index) noexcept {
+                const uint32_t bits = static_cast<uint32_t>(index);
+                return { compact(bits), compact(bits >> 1), compact(bits >> 2) };
+            }
+
+        private:
+
+            /**
+             * @brief Inserts two zero bits between each of the low 10 bits of a value.
+             */
+            static constexpr uint32_t spread(uint32_t value) noexcept {
+                value &= 0x000003FF;
+                value = (value | (value << 16)) & 0x030000FF;
+                value = (value | (value << 8)) & 0x0300F00F;
+                value = (value | (value << 4)) & 0x030C30C3;
+                value = (value | (value << 2)) & 0x09249249;
+                return value;
+            }
+
+            /**
+             * @brief Keeps every third bit of a value, the inverse of spread().
+             */
+            static constexpr uint32_t compact(uint32_t value) noexcept {
+                value &= 0x09249249;
+                value = (value | (value >> 2)) & 0x030C30C3;
+                value = (value | (value >> 4)) & 0x0300F00F;
+                value = (value | (value >> 8)) & 0x030000FF;
+                value = (value | (value >> 16)) & 0x000003FF;
+                return value;
+            }
+        };
+
+    } // namespace Voxel
+} // namespace Gem
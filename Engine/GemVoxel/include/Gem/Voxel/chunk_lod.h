@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <Gem/Voxel/chunk.h>
+
+/**
+ * @file chunk_lod.h
+ * @brief Declaration of the ChunkLod class.
+ */
+
+namespace Gem {
+    namespace Voxel {
+
+        /**
+         * @brief The coarsest level of detail. Level l has cells of 2^l voxels per side, level 0 being the chunk itself.
+         */
+        constexpr uint32_t MAX_CHUNK_LOD = 3;
+
+        /**
+         * @class ChunkLod
+         * @brief Downsampled copies of a chunk, one per level of detail from 1 to MAX_CHUNK_LOD.
+         *
+         * Each level is built out of the one below, so the full-resolution voxels are only read once.
+         * A cell is solid as soon as one of its eight children is, which keeps coarse terrain a superset
+         * of the fine one so seams between levels never open holes; it takes the block of its highest
+         * solid child so surfaces keep their top block. Its light is the brightest of its children, sky
+         * and block light separately.
+         *
+         * Light changes do not bump the chunk version, so a copy should be rebuilt whenever the chunk has
+         * dirty sections rather than by comparing versions alone.
+         */
+        class ChunkLod {
+        public:
+            /**
+             * @brief Downsamples a chunk.
+             * @param chunk The chunk to downsample.
+             */
+            explicit ChunkLod(const Chunk& chunk);
+
+            /**
+             * @brief Gets the number of cells per side of a level.
+             * @param level The level of detail, from 0 to MAX_CHUNK_LOD.
+             * @return The cell count per side.
+             */
+            [[nodiscard]] static constexpr uint32_t getLength(uint32_t level) noexcept {
+                return static_cast<uint32_t>(CHUNK_BOUNDARY) >> level;
+            }
+
+            /**
+             * @brief Retrieves the block ID of a cell.
+             * @param level The level of detail, from 1 to MAX_CHUNK_LOD.
+             * @param x The x-coordinate, in cells.
+             * @param y The y-coordinate, in cells.
+             * @param z The z-coordinate, in cells.
+             * @return The block ID, 0 for air.
+             * @throws std::out_of_range if the level or the coordinates are out of bounds.
+             */
+            [[nodiscard]] uint16_t getBlock(uint32_t level, uint32_t x, uint32_t y, uint32_t z) const;
+
+            /**
+             * @brief Retrieves the light of a cell.
+             * @return The light, sky level in the high nibble and block level in the low one.
+             * @throws std::out_of_range if the level or the coordinates are out of bounds.
+             */
+            [[nodiscard]] uint8_t getLight(uint32_t level, uint32_t x, uint32_t y, uint32_t z) const;
+
+            /**
+             * @brief Gets the block IDs of a level, x varying fastest, then y, then z.
+             * @param level The level of detail, from 1 to MAX_CHUNK_LOD.
+             * @return getLength(level)^3 block IDs.
+             */
+            [[nodiscard]] const std::vector<uint16_t>& getBlocks(uint32_t level) const;
+
+            /**
+             * @brief Gets the light of a level, indexed like getBlocks().
+             * @param level The level of detail, from 1 to MAX_CHUNK_LOD.
+             * @return getLength(level)^3 packed light levels.
+             */
+            [[nodiscard]] const std::vector<uint8_t>& getLights(uint32_t level) const;
+
+            /**
+             * @brief Gets the version of the chunk the copies were built from.
+             * @return The chunk version.
+             */
+            [[nodiscard]] uint64_t getVersion() const noexcept;
+
+        private:
+
+            /**
+             * @brief Gets the storage slot of a level.
+             * @throws std::out_of_range if the level is not stored.
+             */
+            static size_t getSlot(uint32_t level);
+
+            /**
+             * @brief Gets the index of a cell in a level.
+             * @throws std::out_of_range if the coordinates are out of bounds.
+             */
+            static size_t getIndex(uint32_t level, uint32_t x, uint32_t y, uint32_t z);
+
+        private:
+            uint64_t version_ = 0;                                          ///< Version of the source chunk.
+            std::array<std::vector<uint16_t>, MAX_CHUNK_LOD> blocks_;       ///< Block IDs, levels 1 to MAX_CHUNK_LOD.
+            std::array<std::vector<uint8_t>, MAX_CHUNK_LOD> lights_;        ///< Packed light, levels 1 to MAX_CHUNK_LOD.
+        };
+
+    } // namespace Voxel
+} // namespace Gem
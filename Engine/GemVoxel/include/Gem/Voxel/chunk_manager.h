@@ -0,0 +1,247 @@
+#pragma once
+
+#include <array>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include <Gem/Voxel/chunk.h>
+#include <Gem/Voxel/chunk_coord.h>
+#include <Gem/Voxel/chunk_lod.h>
+#include <Gem/Voxel/chunk_pool.h>
+
+/**
+ * @file chunk_manager.h
+ * @brief Declaration of the ChunkManager class.
+ */
+
+namespace Gem {
+    namespace Voxel {
+
+        /**
+         * @struct ChunkManagerStats
+         * @brief Counters describing the streaming state of a ChunkManager.
+         */
+        struct ChunkManagerStats {
+            size_t loadedChunks = 0;    ///< Chunks currently resident.
+            size_t pendingLoads = 0;    ///< Chunks waiting to be loaded.
+            size_t totalLoads = 0;      ///< Chunks loaded since creation.
+            size_t totalUnloads = 0;    ///< Chunks unloaded since creation.
+            size_t pooledChunks = 0;    ///< Chunks allocated by the pool, used or not.
+            size_t memoryUsage = 0;     ///< Estimated bytes used by resident chunks.
+        };
+
+        /**
+         * @class ChunkManager
+         * @brief Keeps the chunks around the camera resident and streams them in and out.
+         *
+         * Chunks inside the load radius are queued nearest first and loaded at a capped rate.
+         * Chunks are only unloaded once they leave the load radius plus an unload margin,
+         * so moving back and forth across a chunk border does not thrash.
+         * Radii are measured in chunks; the horizontal radius is circular and the vertical one is separate.
+         */
+        class ChunkManager {
+        public:
+            using ChunkCallback = std::function<void(const ChunkCoord&, Chunk&)>;
+            using ChunkMap = std::unordered_map<ChunkCoord, Chunk*, ChunkCoordHash>;
+            using ChunkBatch = std::vector<std::pair<ChunkCoord, Chunk*>>;
+            using BatchCallback = std::function<void(const ChunkBatch&)>;
+            using EditCallback = std::function<void(const glm::ivec3&, const Voxel&, const Voxel&)>;
+
+            ChunkManager();
+            ~ChunkManager();
+
+            /**
+             * @brief Sets the function filling a freshly loaded chunk.
+             * @param generator Called with the chunk coordinate and an all-air chunk.
+             */
+            void setGenerator(ChunkCallback generator);
+
+            /**
+             * @brief Sets a function filling every chunk loaded by an update at once.
+             *
+             * Takes precedence over setGenerator(). The chunks are all-air and are only inserted once
+             * the function returns, so it may spread the work over several threads and wait for them.
+             *
+             * @param generator Called with the chunks loaded by an update.
+             */
+            void setBatchGenerator(BatchCallback generator);
+
+            /**
+             * @brief Sets a function called after a chunk has been loaded and generated.
+             * @param callback The callback.
+             */
+            void setLoadCallback(ChunkCallback callback);
+
+            /**
+             * @brief Sets a function called right before a chunk is unloaded.
+             * @param callback The callback.
+             */
+            void setUnloadCallback(ChunkCallback callback);
+
+            /**
+             * @brief Sets a function called after setVoxel() changed a voxel.
+             * @param callback Called with the world voxel coordinates, the previous voxel and the new one.
+             */
+            void setEditCallback(EditCallback callback);
+
+            /**
+             * @brief Sets the streaming radii.
+             * @param horizontal Horizontal load radius in chunks.
+             * @param vertical Vertical load radius in chunks.
+             */
+            void setLoadRadius(int32_t horizontal, int32_t vertical);
+
+            /**
+             * @brief Sets the hysteresis applied before unloading.
+             * @param margin Extra distance in chunks past the load radius before a chunk is unloaded.
+             */
+            void setUnloadMargin(int32_t margin);
+
+            /**
+             * @brief Caps the number of chunks loaded by a single update.
+             * @param maxLoads The maximum number of loads per update.
+             */
+            void setMaxLoadsPerFrame(size_t maxLoads);
+
+            /**
+             * @brief Sets the distances at which chunks switch to coarser levels of detail.
+             *
+             * Distances are measured in chunks from the chunk of the last update, straight-line.
+             * By default every chunk stays at level 0.
+             *
+             * @param distances The distance at which each level from 1 to MAX_CHUNK_LOD starts, increasing.
+             */
+            void setLodDistances(const std::array<int32_t, MAX_CHUNK_LOD>& distances);
+
+            /**
+             * @brief Gets the level of detail a chunk should be drawn at.
+             * @param coord The chunk coordinate, loaded or not.
+             * @return The level of detail, from 0 (full resolution) to MAX_CHUNK_LOD.
+             */
+            [[nodiscard]] uint32_t getLod(const ChunkCoord& coord) const noexcept;
+
+            /**
+             * @brief Gets the chunk containing the position of the last update.
+             * @return The chunk coordinate.
+             */
+            [[nodiscard]] const ChunkCoord& getCenter() const noexcept;
+
+            /**
+             * @brief Streams chunks around a position. Call once per frame.
+             * @param position World-space position, typically Camera::get_position().
+             */
+            void update(const glm::vec3& position);
+
+            /**
+             * @brief Unloads every chunk.
+             */
+            void clear();
+
+            /**
+             * @brief Gets a resident chunk.
+             * @param coord The chunk coordinate.
+             * @return Pointer to the chunk, or nullptr if it is not loaded.
+             */
+            [[nodiscard]] Chunk* getChunk(const ChunkCoord& coord) const;
+
+            /**
+             * @brief Retrieves a voxel by world coordinates.
+             * @param voxel The world voxel coordinates.
+             * @return The voxel, or air if its chunk is not loaded.
+             */
+            [[nodiscard]] Voxel getVoxel(const glm::ivec3& voxel) const;
+
+            /**
+             * @brief Sets a voxel by world coordinates.
+             *
+             * Marks the touched sections dirty, including those of the neighbouring chunks
+             * when the voxel lies on a chunk border.
+             *
+             * @param voxel The world voxel coordinates.
+             * @param value The voxel to set.
+             * @return True if the voxel changed, false if it already held the value or its chunk is not loaded.
+             */
+            bool setVoxel(const glm::ivec3& voxel, const Voxel& value);
+
+            /**
+             * @brief Gets all resident chunks.
+             * @return Map of chunk coordinates to chunks.
+             */
+            [[nodiscard]] const ChunkMap& getChunks() const noexcept;
+
+            /**
+             * @brief Gets the streaming counters.
+             * @return The current statistics.
+             */
+            [[nodiscard]] ChunkManagerStats getStats() const;
+
+        private:
+
+            /**
+             * @brief Rebuilds the nearest-first load queue around a chunk.
+             */
+            void rebuildQueue(const ChunkCoord& center);
+
+            /**
+             * @brief Unloads every chunk outside the unload radius of a chunk.
+             */
+            void unloadFarChunks(const ChunkCoord& center);
+
+            /**
+             * @brief Checks whether a chunk lies within a radius of another one.
+             */
+            static bool isWithin(const ChunkCoord& coord, const ChunkCoord& center, int32_t horizontal, int32_t vertical) noexcept;
+
+            /**
+             * @brief Generates a batch of chunks and inserts them into the map.
+             */
+            void loadChunks(const ChunkBatch& batch);
+
+            /**
+             * @brief Marks the sections of the neighbouring chunks touching a region of a chunk as dirty.
+             *
+             * Covers the edge and corner neighbours too, whose ambient occlusion reads the region.
+             *
+             * @param coord The chunk containing the region.
+             * @param min The lowest voxel of the region, in chunk-local coordinates.
+             * @param max The highest voxel of the region, in chunk-local coordinates.
+             */
+            void markNeighboursDirty(const ChunkCoord& coord, const glm::ivec3& min, const glm::ivec3& max);
+
+            /**
+             * @brief Removes a chunk from the map and returns it to the pool.
+             */
+            void unloadChunk(ChunkMap::iterator it);
+
+        private:
+            ChunkMap chunks_;                       ///< Resident chunks.
+            ChunkPool pool_;                        ///< Storage for resident chunks.
+
+            std::vector<ChunkCoord> loadQueue_;     ///< Chunks to load, farthest first so the nearest pop from the back.
+
+            ChunkCoord center_;                     ///< Chunk containing the position of the last update.
+            bool hasCenter_ = false;                ///< Flag indicating if update() has been called.
+
+            int32_t horizontalRadius_ = 4;          ///< Horizontal load radius in chunks.
+            int32_t verticalRadius_ = 2;            ///< Vertical load radius in chunks.
+            int32_t unloadMargin_ = 1;              ///< Hysteresis in chunks.
+            size_t maxLoadsPerFrame_ = 4;           ///< Loads allowed per update.
+
+            std::array<int32_t, MAX_CHUNK_LOD> lodDistances_;    ///< Distance at which each coarser level starts.
+
+            size_t totalLoads_ = 0;                 ///< Number of loads since creation.
+            size_t totalUnloads_ = 0;               ///< Number of unloads since creation.
+
+            ChunkCallback generator_;               ///< Fills new chunks.
+            BatchCallback batchGenerator_;          ///< Fills new chunks by batch.
+            ChunkCallback onLoad_;                  ///< Called after a load.
+            ChunkCallback onUnload_;                ///< Called before an unload.
+            EditCallback onEdit_;                   ///< Called after setVoxel() changed a voxel.
+        };
+
+    } // namespace Voxel
+} // namespace Gem
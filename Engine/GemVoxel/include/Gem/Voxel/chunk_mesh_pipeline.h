@@ -0,0 +1,186 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <Gem/Core/job_system.h>
+#include <Gem/Voxel/block_registry.h>
+#include <Gem/Voxel/chunk_lod.h>
+#include <Gem/Voxel/chunk_manager.h>
+#include <Gem/Voxel/chunk_mesher.h>
+#include <Gem/Voxel/chunk_snapshot.h>
+
+/**
+ * @file chunk_mesh_pipeline.h
+ * @brief Declaration of the ChunkMeshPipeline class.
+ */
+
+namespace Gem {
+    namespace Voxel {
+
+        /**
+         * @struct ChunkMeshPipelineStats
+         * @brief Counters describing the work done by a ChunkMeshPipeline.
+         */
+        struct ChunkMeshPipelineStats {
+            size_t inFlight = 0;            ///< Meshing jobs not yet collected.
+            size_t totalUploads = 0;        ///< Meshes handed to the render thread.
+            size_t totalDiscarded = 0;      ///< Stale results thrown away.
+            size_t remeshedSections = 0;    ///< Sections rebuilt since creation.
+            size_t remeshedFaces = 0;       ///< Quads rebuilt since creation.
+            size_t lastRemeshedFaces = 0;   ///< Quads rebuilt for the last mesh handed over.
+            size_t totalLodBuilds = 0;      ///< Downsampled copies built out of full-resolution chunks.
+        };
+
+        /**
+         * @class ChunkMeshPipeline
+         * @brief Meshes chunks on the JobSystem workers and hands the results back to the render thread.
+         *
+         * request() snapshots a chunk and its neighbours on the calling thread and schedules the meshing
+         * of its dirty sections. Finished sections wait in a queue until processResults() is called from
+         * the thread owning the OpenGL context; they are merged into the cached mesh of the chunk, which
+         * is then uploaded on that thread.
+         *
+         * Each result is tagged with the chunk version and a request sequence number. A new request for a
+         * chunk also covers the sections of the requests still in flight, so older results are simply
+         * thrown away. A result built from a chunk modified in the meantime is thrown away too, and its
+         * sections are requested again.
+         *
+         * Chunks are meshed at the level of detail given by ChunkManager::getLod(). Coarse meshes are built
+         * out of a downsampled copy of the chunk (see ChunkLod), cached until the chunk changes, so moving
+         * a chunk from one coarse level to another does not read its voxels again. updateLod() remeshes the
+         * chunks whose level changed after the camera moved.
+         *
+         * request(), updateLod() and processResults() must be called from the thread owning the ChunkManager.
+         */
+        class ChunkMeshPipeline {
+        public:
+            using UploadCallback = std::function<void(const ChunkCoord&, const ChunkMesh&)>;
+
+            /**
+             * @brief Constructs a pipeline.
+             * @param jobs The job system running the meshing jobs.
+             * @param chunks The chunks to mesh. Must outlive the pipeline.
+             * @param blocks The block types giving the face textures, see ChunkMesher::setBlockRegistry(). Must outlive the pipeline.
+             * @throws std::length_error if the block types have more textures than a chunk mesh can address.
+             */
+            ChunkMeshPipeline(Gem::Core::JobSystem& jobs, const ChunkManager& chunks, const BlockRegistry* blocks = nullptr);
+
+            /**
+             * @brief Waits for the jobs still in flight.
+             */
+            ~ChunkMeshPipeline();
+
+            /**
+             * @brief Schedules the meshing of the dirty sections of a resident chunk.
+             *
+             * Does nothing if the chunk is not loaded or has no dirty section.
+             *
+             * @param coord The chunk coordinate.
+             */
+            void request(const ChunkCoord& coord);
+
+            /**
+             * @brief Schedules the meshing of the dirty sections of a chunk and of its 26 resident neighbours.
+             *
+             * Used after a chunk is loaded or edited, since ChunkManager marks the borders of the
+             * neighbours dirty as well.
+             *
+             * @param coord The chunk coordinate.
+             */
+            void requestWithNeighbours(const ChunkCoord& coord);
+
+            /**
+             * @brief Schedules the meshing of the chunks whose level of detail changed.
+             *
+             * Cheap when the camera stays in the same chunk. Call once per frame, after ChunkManager::update().
+             */
+            void updateLod();
+
+            /**
+             * @brief Forgets the cached mesh and downsampled copy of a chunk. Call when the chunk is unloaded.
+             * @param coord The chunk coordinate.
+             */
+            void remove(const ChunkCoord& coord);
+
+            /**
+             * @brief Hands finished meshes to the render thread.
+             * @param upload Called for each up-to-date mesh, typically to upload it to the GPU.
+             * @param maxUploads Maximum number of meshes handed over in this call. Remaining ones stay queued.
+             * @return The number of meshes handed over.
+             */
+            size_t processResults(const UploadCallback& upload, size_t maxUploads = SIZE_MAX);
+
+            /**
+             * @brief Gets the pipeline counters.
+             * @return The current statistics.
+             */
+            [[nodiscard]] ChunkMeshPipelineStats getStats() const;
+
+            // The jobs keep a pointer to the pipeline
+            ChunkMeshPipeline(const ChunkMeshPipeline&) = delete;
+            ChunkMeshPipeline& operator=(const ChunkMeshPipeline&) = delete;
+
+        private:
+
+            /**
+             * @brief Rebuilt sections and what they were built from.
+             */
+            struct Result {
+                ChunkCoord coord;
+                uint64_t version = 0;
+                uint64_t sequence = 0;
+                uint64_t sections = 0;
+                uint32_t lod = 0;
+                size_t faces = 0;
+                ChunkMesh mesh;
+            };
+
+            /**
+             * @brief The latest request of a chunk still in flight.
+             */
+            struct Pending {
+                uint64_t sequence = 0;
+                uint64_t sections = 0;
+                uint32_t lod = 0;
+            };
+
+            /**
+             * @brief The mesh of a chunk handed over, and its level of detail.
+             */
+            struct CachedMesh {
+                ChunkMesh mesh;
+                uint32_t lod = 0;
+            };
+
+            /**
+             * @brief Takes a snapshot of a chunk and its neighbours.
+             */
+            std::shared_ptr<const ChunkSnapshot> snapshot(const ChunkCoord& coord, const Chunk& chunk) const;
+
+        private:
+            Gem::Core::JobSystem& jobs_;                ///< Runs the meshing jobs.
+            const ChunkManager& chunks_;                ///< Source of the chunks.
+            const BlockRegistry* blocks_;               ///< Face textures of the blocks, optional.
+
+            std::mutex resultsMutex_;                   ///< Protects results_.
+            std::vector<Result> results_;               ///< Finished meshes waiting for the render thread.
+
+            ChunkMeshPipelineStats stats_;              ///< Counters.
+            uint64_t nextSequence_ = 1;                 ///< Sequence number of the next request.
+
+            std::unordered_map<ChunkCoord, Pending, ChunkCoordHash> pending_;     ///< Latest request in flight per chunk.
+            std::unordered_map<ChunkCoord, CachedMesh, ChunkCoordHash> meshes_;   ///< Mesh of every chunk handed over, per section.
+            std::unordered_map<ChunkCoord, std::shared_ptr<const ChunkLod>, ChunkCoordHash> lods_;   ///< Downsampled copies of the chunks meshed coarse.
+
+            ChunkCoord lodCenter_;                      ///< Camera chunk the levels of detail were last checked for.
+            bool hasLodCenter_ = false;                 ///< Flag indicating if updateLod() has run.
+
+            std::vector<Gem::Core::JobHandle> handles_; ///< Jobs not yet known to be finished.
+        };
+
+    } // namespace Voxel
+} // namespace Gem
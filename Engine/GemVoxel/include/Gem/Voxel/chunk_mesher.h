@@ -0,0 +1,509 @@
+#pragma once
+
+#include <GlfwGlad.h>
+#include <Gem/Voxel/block_registry.h>
+#include <Gem/Voxel/chunk.h>
+#include <Gem/Voxel/chunk_coord.h>
+#include <Gem/Voxel/chunk_lod.h>
+#include <Gem/Voxel/chunk_neighborhood.h>
+#include <Gem/Voxel/chunk_snapshot.h>
+#include <Gem/Voxel/chunk_visibility.h>
+#include <vector>
+
+/**
+ * @file chunk_mesher.h
+ * @brief Declaration of the ChunkMesh container and the greedy ChunkMesher.
+ */
+
+namespace Gem {
+    namespace Voxel {
+
+        /**
+         * @struct ChunkVertex
+         * @brief Packing of a cube face vertex into a single 32-bit integer, decoded by chunk.vert.
+         *
+         * | Bits  | Content                                                           |
+         * |-------|-------------------------------------------------------------------|
+         * | 0-14  | Position x, y, z, 5 bits each, from 0 to the chunk length         |
+         * | 15-17 | Face the quad looks towards (see Face), giving the normal         |
+         * | 18-19 | Ambient occlusion, from 0 for an open corner to 3 for a closed one |
+         * | 20-23 | Sky light                                                         |
+         * | 24-27 | Block light                                                       |
+         * | 28-31 | Texture layer                                                     |
+         *
+         * Texture coordinates are not stored: they are the position projected on the plane of the face,
+         * which the shader computes from the position and the face, so merged quads tile the texture.
+         * Quads of other block shapes need finer positions and use ShapeVertex instead.
+         */
+        struct ChunkVertex {
+
+            static constexpr uint32_t POSITION_BITS = 5;
+            static constexpr uint32_t FACE_SHIFT = 15;
+            static constexpr uint32_t OCCLUSION_SHIFT = 18;
+            static constexpr uint32_t SKY_SHIFT = 20;
+            static constexpr uint32_t BLOCK_SHIFT = 24;
+            static constexpr uint32_t LAYER_SHIFT = 28;
+            static constexpr uint32_t MAX_LAYER = 15;
+
+            static_assert(CHUNK_BOUNDARY < (1u << POSITION_BITS), "Chunk positions must fit the packed vertex.");
+
+            /**
+             * @brief Packs a vertex.
+             * @param x The x-coordinate, from 0 to the chunk length.
+             * @param y The y-coordinate, from 0 to the chunk length.
+             * @param z The z-coordinate, from 0 to the chunk length.
+             * @param face The face the quad looks towards.
+             * @param occlusion The ambient occlusion, from 0 to 3.
+             * @param light The light, sky level in the high nibble and block level in the low one.
+             * @param layer The texture layer, from 0 to MAX_LAYER.
+             * @return The packed vertex.
+             */
+            static constexpr uint32_t pack(uint32_t x, uint32_t y, uint32_t z, Face face, uint32_t occlusion, uint8_t light, uint32_t layer) noexcept {
+                return x | (y << POSITION_BITS) | (z << (POSITION_BITS * 2))
+                    | (static_cast<uint32_t>(face) << FACE_SHIFT)
+                    | ((occlusion & 3) << OCCLUSION_SHIFT)
+                    | (static_cast<uint32_t>(light >> 4) << SKY_SHIFT)
+                    | (static_cast<uint32_t>(light & 0x0F) << BLOCK_SHIFT)
+                    | ((layer & MAX_LAYER) << LAYER_SHIFT);
+            }
+
+            /**
+             * @brief Gets one position coordinate of a packed vertex.
+             * @param vertex The packed vertex.
+             * @param axis The axis (0 = x, 1 = y, 2 = z).
+             * @return The coordinate.
+             */
+            static constexpr uint32_t getPosition(uint32_t vertex, int axis) noexcept {
+                return (vertex >> (POSITION_BITS * axis)) & ((1u << POSITION_BITS) - 1);
+            }
+
+            /**
+             * @brief Gets the face of a packed vertex.
+             */
+            static constexpr Face getFace(uint32_t vertex) noexcept {
+                return static_cast<Face>((vertex >> FACE_SHIFT) & 7);
+            }
+
+            /**
+             * @brief Gets the ambient occlusion of a packed vertex, from 0 (open) to 3.
+             */
+            static constexpr uint32_t getOcclusion(uint32_t vertex) noexcept {
+                return (vertex >> OCCLUSION_SHIFT) & 3;
+            }
+
+            /**
+             * @brief Gets the light of a packed vertex.
+             */
+            static constexpr uint8_t getLight(uint32_t vertex, LightType type) noexcept {
+                return static_cast<uint8_t>((vertex >> ((type == LightType::Sky) ? SKY_SHIFT : BLOCK_SHIFT)) & 0x0F);
+            }
+
+            /**
+             * @brief Gets the texture layer of a packed vertex.
+             */
+            static constexpr uint32_t getLayer(uint32_t vertex) noexcept {
+                return vertex >> LAYER_SHIFT;
+            }
+        };
+
+        /**
+         * @struct ShapeVertex
+         * @brief Packing of a block shape vertex into two 32-bit integers, decoded by chunk_shape.vert.
+         *
+         * | Word | Bits  | Content                                                             |
+         * |------|-------|---------------------------------------------------------------------|
+         * | 0    | 0-26  | Position x, y, z, 9 bits each, in 1/SHAPE_RESOLUTION voxel units    |
+         * | 0    | 27-29 | Face the quad looks towards (see Face), giving the normal           |
+         * | 0    | 30-31 | Ambient occlusion, from 0 for an open corner to 3 for a closed one  |
+         * | 1    | 0-3   | Sky light                                                           |
+         * | 1    | 4-7   | Block light                                                         |
+         * | 1    | 8-15  | Texture layer                                                       |
+         *
+         * Positions are finer than a voxel so block shapes such as slabs and stairs can be drawn. Shapes
+         * are rare next to cubes, so they pay for the second word rather than every cube face.
+         */
+        struct ShapeVertex {
+            uint32_t geometry = 0;  ///< Position, face and occlusion.
+            uint32_t shading = 0;   ///< Light and texture layer.
+
+            static constexpr uint32_t POSITION_BITS = 9;
+            static constexpr uint32_t FACE_SHIFT = 27;
+            static constexpr uint32_t OCCLUSION_SHIFT = 30;
+            static constexpr uint32_t SKY_SHIFT = 0;
+            static constexpr uint32_t BLOCK_SHIFT = 4;
+            static constexpr uint32_t LAYER_SHIFT = 8;
+            static constexpr uint32_t MAX_LAYER = 255;
+
+            static_assert(CHUNK_BOUNDARY * SHAPE_RESOLUTION < (1u << POSITION_BITS), "Chunk positions must fit the packed vertex.");
+
+            /**
+             * @brief Packs a vertex.
+             * @param x The x-coordinate, in 1/SHAPE_RESOLUTION voxel units.
+             * @param y The y-coordinate, in 1/SHAPE_RESOLUTION voxel units.
+             * @param z The z-coordinate, in 1/SHAPE_RESOLUTION voxel units.
+             * @param face The face the quad looks towards.
+             * @param occlusion The ambient occlusion, from 0 to 3.
+             * @param light The light, sky level in the high nibble and block level in the low one.
+             * @param layer The texture layer, from 0 to MAX_LAYER.
+             * @return The packed vertex.
+             */
+            static constexpr ShapeVertex pack(uint32_t x, uint32_t y, uint32_t z, Face face, uint32_t occlusion, uint8_t light, uint32_t layer) noexcept {
+                ShapeVertex vertex;
+                vertex.geometry = x | (y << POSITION_BITS) | (z << (POSITION_BITS * 2))
+                    | (static_cast<uint32_t>(face) << FACE_SHIFT)
+                    | ((occlusion & 3) << OCCLUSION_SHIFT);
+                vertex.shading = (static_cast<uint32_t>(light >> 4) << SKY_SHIFT)
+                    | (static_cast<uint32_t>(light & 0x0F) << BLOCK_SHIFT)
+                    | ((layer & MAX_LAYER) << LAYER_SHIFT);
+                return vertex;
+            }
+
+            /**
+             * @brief Gets one position coordinate of a packed vertex.
+             * @param vertex The packed vertex.
+             * @param axis The axis (0 = x, 1 = y, 2 = z).
+             * @return The coordinate, in 1/SHAPE_RESOLUTION voxel units.
+             */
+            static constexpr uint32_t getPosition(const ShapeVertex& vertex, int axis) noexcept {
+                return (vertex.geometry >> (POSITION_BITS * axis)) & ((1u << POSITION_BITS) - 1);
+            }
+
+            /**
+             * @brief Gets the face of a packed vertex.
+             */
+            static constexpr Face getFace(const ShapeVertex& vertex) noexcept {
+                return static_cast<Face>((vertex.geometry >> FACE_SHIFT) & 7);
+            }
+
+            /**
+             * @brief Gets the ambient occlusion of a packed vertex, from 0 (open) to 3.
+             */
+            static constexpr uint32_t getOcclusion(const ShapeVertex& vertex) noexcept {
+                return (vertex.geometry >> OCCLUSION_SHIFT) & 3;
+            }
+
+            /**
+             * @brief Gets the light of a packed vertex.
+             */
+            static constexpr uint8_t getLight(const ShapeVertex& vertex, LightType type) noexcept {
+                return static_cast<uint8_t>((vertex.shading >> ((type == LightType::Sky) ? SKY_SHIFT : BLOCK_SHIFT)) & 0x0F);
+            }
+
+            /**
+             * @brief Gets the texture layer of a packed vertex.
+             */
+            static constexpr uint32_t getLayer(const ShapeVertex& vertex) noexcept {
+                return (vertex.shading >> LAYER_SHIFT) & MAX_LAYER;
+            }
+        };
+
+        static_assert(sizeof(ShapeVertex) == 2 * sizeof(uint32_t), "Shape vertices are uploaded as two integers.");
+
+        /**
+         * @struct ChunkMeshSection
+         * @brief Vertex and index data of one chunk section.
+         *
+         * Indices are relative to the section's own vertices.
+         */
+        struct ChunkMeshSection {
+            std::vector<uint32_t> vertices;             ///< Packed cube vertices, see ChunkVertex.
+            std::vector<GLuint> indices;                ///< Triangle list indices of the cube faces.
+            std::vector<ShapeVertex> shapeVertices;     ///< Packed vertices of the other block shapes.
+            std::vector<GLuint> shapeIndices;           ///< Triangle list indices of the other block shapes.
+
+            /**
+             * @brief Removes all vertices and indices while keeping the allocated memory.
+             */
+            void clear() noexcept;
+
+            /**
+             * @brief Gets the number of quads in the section, cube faces and shape quads together.
+             * @return The quad count.
+             */
+            [[nodiscard]] size_t getQuadCount() const noexcept;
+        };
+
+        /**
+         * @struct ChunkMesh
+         * @brief CPU-side vertex and index data for a whole chunk.
+         *
+         * Cube faces are packed into a single 32-bit integer per vertex (see ChunkVertex) and make up most
+         * of the geometry. Quads of other block shapes need positions finer than a voxel and are kept in a
+         * separate stream of two-integer vertices (see ShapeVertex). Both are bound as an integer attribute
+         * at location 0, decoded by chunk.vert and chunk_shape.vert. Positions are chunk-local.
+         *
+         * The geometry is built per section (see Chunk::getSectionIndex()) so a single section can be
+         * rebuilt after an edit; assemble() then joins the sections into the buffers sent to the GPU.
+         *
+         * The visibility always covers the whole chunk, even when only some sections were rebuilt.
+         */
+        struct ChunkMesh {
+
+            std::vector<uint32_t> vertices;             ///< Packed cube vertices of the whole chunk, see ChunkVertex.
+            std::vector<GLuint> indices;                ///< Triangle list indices of the cube faces.
+            std::vector<ShapeVertex> shapeVertices;     ///< Packed vertices of the other block shapes.
+            std::vector<GLuint> shapeIndices;           ///< Triangle list indices of the other block shapes.
+            std::vector<ChunkMeshSection> sections;     ///< Geometry of each section.
+            ChunkVisibility visibility;                 ///< Faces of the chunk seen from each other, for occlusion culling.
+
+            /**
+             * @brief Removes all vertices and indices while keeping the allocated memory.
+             */
+            void clear() noexcept;
+
+            /**
+             * @brief Rebuilds vertices and indices out of the sections.
+             */
+            void assemble();
+
+            /**
+             * @brief Checks whether the mesh holds any geometry.
+             * @return True if the mesh has no triangles.
+             */
+            [[nodiscard]] bool empty() const noexcept;
+
+            /**
+             * @brief Gets the number of vertices in the mesh, in both streams.
+             * @return The vertex count.
+             */
+            [[nodiscard]] size_t getVertexCount() const noexcept;
+
+            /**
+             * @brief Gets the number of triangles in the mesh, in both streams.
+             * @return The triangle count.
+             */
+            [[nodiscard]] size_t getTriangleCount() const noexcept;
+        };
+
+        /**
+         * @class ChunkMesher
+         * @brief Builds a single renderable mesh out of a Chunk.
+         *
+         * Faces hidden by the block in front of them are never emitted (hidden-face removal), and coplanar
+         * faces of the same block type, light and ambient occlusion are merged into the largest possible
+         * rectangles (greedy meshing), so a whole chunk can be drawn with one draw call for its cubes
+         * and one for its other shapes.
+         * Each face is lit by the light of the voxel in front of it, baked into its vertices.
+         *
+         * Blocks are full cubes unless a BlockRegistry gives them another shape (see BlockShape). Cubes go
+         * through the greedy merge; other shapes copy their pre-baked quads, and a quad on the voxel border
+         * is dropped when the occlusion mask of the neighbour covers it. Either way, hiding a face only takes
+         * table lookups and a mask test. Non-opaque cubes such as leaves hide nothing, so their neighbours
+         * keep the faces against them. Fluids only hide the faces of the same fluid: above and below, and
+         * on the sides where they stand at least as high.
+         *
+         * Each face corner also gets an ambient occlusion level out of the two side voxels and the corner
+         * voxel around it in the layer in front of the face. Quads are split along the diagonal that keeps
+         * the occlusion gradient symmetric, so a darkened corner does not bleed across the whole quad.
+         *
+         * The chunk and its one-voxel shell are copied once per call into a ChunkNeighborhood, and the
+         * meshing only ever reads that copy.
+         *
+         * Texture layers come from the face layer table of a BlockRegistry (see setBlockRegistry()). Without
+         * one, or for IDs it does not know, the layer of a block is its ID minus one on every face. Cube
+         * vertices hold 16 layers, so a registry with more textures is refused.
+         * Faces are merged within a section only, and each face belongs to the section of its block,
+         * so sections can be rebuilt independently.
+         *
+         * A mesher holds scratch memory and must not be shared between threads;
+         * use one mesher per thread.
+         */
+        class ChunkMesher {
+        public:
+            ChunkMesher();
+
+            /**
+             * @brief Generates the mesh of a chunk on its own.
+             *
+             * Voxels outside the chunk are treated as air under the open sky, so every border face is emitted.
+             *
+             * @param chunk The chunk to mesh.
+             * @param mesh The output mesh. Previous content is discarded.
+             */
+            void mesh(const Chunk& chunk, ChunkMesh& mesh);
+
+            /**
+             * @brief Generates the mesh of a chunk snapshot.
+             *
+             * Border faces hidden by the neighbour layers of the snapshot are culled.
+             *
+             * @param snapshot The chunk and its neighbour layers.
+             * @param mesh The output mesh. Previous content is discarded.
+             */
+            void mesh(const ChunkSnapshot& snapshot, ChunkMesh& mesh);
+
+            /**
+             * @brief Rebuilds some sections of a chunk snapshot.
+             *
+             * Other sections of the mesh are left untouched, and the mesh is not assembled.
+             *
+             * @param snapshot The chunk and its neighbour layers.
+             * @param sections A bit mask of the sections to rebuild.
+             * @param mesh The output mesh.
+             * @return The number of quads emitted.
+             */
+            size_t meshSections(const ChunkSnapshot& snapshot, uint64_t sections, ChunkMesh& mesh);
+
+            /**
+             * @brief Generates the mesh of a chunk out of one of its downsampled copies.
+             *
+             * Each cell becomes a cube of 2^level voxels, so the mesh is drawn like a full-resolution one.
+             * Neighbours are not looked at: every face on the chunk border is emitted, which hides the seams
+             * with neighbours meshed at another level (skirts). The whole mesh goes into the first section.
+             *
+             * @param lod The downsampled chunk.
+             * @param level The level of detail, from 1 to MAX_CHUNK_LOD.
+             * @param mesh The output mesh. Previous content is discarded.
+             * @return The number of quads emitted.
+             * @throws std::out_of_range if the level is out of range.
+             */
+            size_t meshLod(const ChunkLod& lod, uint32_t level, ChunkMesh& mesh);
+
+            /**
+             * @brief Sets the block types giving the face textures and shapes of the meshes.
+             * @param registry The block types, nullptr to draw every block as an opaque cube with the block ID
+             *                 minus one as layer. Must outlive its use.
+             * @throws std::length_error if the registry has more textures than a cube vertex can address.
+             */
+            void setBlockRegistry(const BlockRegistry* registry);
+
+            /**
+             * @brief Checks that every texture of a registry fits the texture layer of a cube vertex.
+             * @param registry The block types, nullptr is always accepted.
+             * @throws std::length_error if the registry has more than MAX_TEXTURES textures.
+             */
+            static void checkBlockRegistry(const BlockRegistry* registry);
+
+            static constexpr size_t MAX_TEXTURES = ChunkVertex::MAX_LAYER + 1;  ///< Texture layers a cube vertex can address.
+
+        private:
+
+            /**
+             * @brief Copies one level of a downsampled chunk into the neighbourhood, with air around it.
+             */
+            void gather(const ChunkLod& lod, uint32_t level);
+
+            /**
+             * @brief Rebuilds sections out of the neighbourhood.
+             *
+             * Sections without a solid voxel are cleared without being swept, they have no face of their own.
+             *
+             * @param chunk The chunk gathered in the neighbourhood.
+             * @param sections A bit mask of the sections to rebuild.
+             * @param mesh The output mesh.
+             * @return The number of quads emitted.
+             */
+            size_t build(const Chunk& chunk, uint64_t sections, ChunkMesh& mesh);
+
+            /**
+             * @brief Greedy meshing of one section out of the neighbourhood.
+             * @param min The lowest cell of the section.
+             * @param n The number of cells per side of the section.
+             * @param scale The number of voxels per side of a cell.
+             * @param section The output geometry.
+             * @return The number of quads emitted.
+             */
+            size_t buildSection(const int min[3], int n, int scale, ChunkMeshSection& section);
+
+            /**
+             * @brief Merges the faces of a slice into rectangles and emits them.
+             * @param mask The faces of the slice, n * n values, cleared on return.
+             * @param min The lowest cell of the section.
+             * @param n The number of cells per side of the section.
+             * @param scale The number of voxels per side of a cell.
+             * @param d The axis the faces are facing.
+             * @param slice The coordinate of the slice plane along d.
+             * @param backFace True if the faces look towards -d.
+             * @param section The output geometry.
+             * @return The number of quads emitted.
+             */
+            size_t mergeFaces(int64_t* mask, const int min[3], int n, int scale, int d, int slice, bool backFace, ChunkMeshSection& section);
+
+            /**
+             * @brief Selects whether blocks are drawn with their shape or all as opaque cubes.
+             */
+            void useShapes(bool enabled) noexcept;
+
+            /**
+             * @brief Checks whether a block is drawn as a cube, merged greedily. Unknown blocks are opaque cubes.
+             */
+            bool isCube(uint16_t id) const noexcept {
+                return id != 0 && (id >= shapeCount_ || fullCube_[id] != 0);
+            }
+
+            /**
+             * @brief Gets the part of a voxel face a block hides, see BlockShape::getOcclusion().
+             */
+            uint16_t getOcclusion(uint16_t id, size_t face) const noexcept {
+                return (id == 0) ? uint16_t(0) : (id >= shapeCount_) ? FULL_FACE : occlusion_[size_t(id) * FACE_COUNT + face];
+            }
+
+            /**
+             * @brief Checks whether a fluid face lies against the same fluid, at least as high on the sides.
+             */
+            bool isSameFluidBehind(uint16_t id, uint16_t neighbour, size_t face) const noexcept {
+                return neighbour < shapeCount_ && fluid_[id] != 0 && fluid_[neighbour] == fluid_[id]
+                    && (face / 2 == 1 || fluidLevel_[neighbour] >= fluidLevel_[id]);
+            }
+
+            /**
+             * @brief Gets the neighbourhood index of the voxel next to another one.
+             */
+            static size_t offsetCell(size_t cell, size_t face) noexcept {
+                const size_t stride = ChunkNeighborhood::getStride(static_cast<int>(face / 2));
+                return (face % 2 == 0) ? cell + stride : cell - stride;
+            }
+
+            /**
+             * @brief Flood fills the non-opaque voxels of the chunk to find which faces see each other.
+             * @param occupancy The solid voxels of the chunk, an empty chunk sees through every face.
+             */
+            ChunkVisibility computeVisibility(const Chunk::Occupancy& occupancy);
+
+            /**
+             * @brief Computes the ambient occlusion of the four corners of a face.
+             * @param front The padded index of the voxel in front of the face.
+             * @param strideU The padded index stride along the first tangent axis.
+             * @param strideV The padded index stride along the second tangent axis.
+             * @return Two bits per corner, in emitQuad() corner order, from 0 (fully occluded) to 3 (open).
+             */
+            uint8_t computeOcclusion(size_t front, size_t strideU, size_t strideV) const noexcept;
+
+            /**
+             * @brief Appends one quad to the mesh.
+             *
+             * Cube faces go to the one-integer stream (see ChunkVertex), shape quads to the other (see ShapeVertex).
+             *
+             * @param section The output geometry.
+             * @param origin The first quad corner, in voxels for a cube face and 1/SHAPE_RESOLUTION voxel units for a shape quad.
+             * @param du The quad extent along its first tangent, in the same units.
+             * @param dv The quad extent along its second tangent, in the same units.
+             * @param axis The axis the quad is facing (0 = x, 1 = y, 2 = z).
+             * @param backFace True if the quad faces the negative direction of the axis.
+             * @param light The light of the quad, sky level in the high nibble and block level in the low one.
+             * @param occlusion The ambient occlusion of the corners origin, origin + du, origin + du + dv and origin + dv, two bits each.
+             * @param id The block ID of the quad.
+             * @param shape True for a quad of a block shape, false for a cube face.
+             */
+            void emitQuad(ChunkMeshSection& section, const int origin[3], const int du[3], const int dv[3], int axis, bool backFace, uint8_t light, uint8_t occlusion, uint16_t id, bool shape);
+
+            /**
+             * @brief Gets the texture layer of a face of a block.
+             */
+            uint32_t getTextureLayer(uint16_t id, Face face) const noexcept;
+
+        private:
+            ChunkNeighborhood neighborhood_;    ///< The chunk and its shell being meshed, reused between calls.
+            const BlockRegistry* registry_ = nullptr;   ///< Face textures and shapes of the blocks, optional.
+            size_t shapeCount_ = 0;                     ///< Blocks drawn with their shape, see useShapes().
+            const uint8_t* fullCube_ = nullptr;         ///< Full cube table of the registry.
+            const uint16_t* occlusion_ = nullptr;       ///< Occlusion table of the registry.
+            const uint16_t* fluid_ = nullptr;           ///< Fluid table of the registry.
+            const uint8_t* fluidLevel_ = nullptr;       ///< Fluid level table of the registry.
+            std::vector<int64_t> mask_;     ///< Face masks of the slice being merged, both directions (block ID, light and occlusion), reused between calls.
+            std::vector<uint8_t> filled_;   ///< Voxels reached by the visibility flood fill or opaque, reused between calls.
+            std::vector<uint16_t> flood_;   ///< Flood fill stack of voxel indices, reused between calls.
+        };
+
+    } // namespace Voxel
+} // namespace Gem
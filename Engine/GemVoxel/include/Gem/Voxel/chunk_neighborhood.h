@@ -0,0 +1,223 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <Gem/Voxel/chunk.h>
+#include <Gem/Voxel/chunk_snapshot.h>
+
+/**
+ * @file chunk_neighborhood.h
+ * @brief Declaration of the ChunkNeighborhood class.
+ */
+
+namespace Gem {
+    namespace Voxel {
+
+        /**
+         * @class ChunkNeighborhood
+         * @brief Contiguous copy of a chunk and of the one-voxel shell around it.
+         *
+         * Block IDs and light levels are copied once into two flat (length + 2)^3 arrays, so voxel loops
+         * such as meshing or ambient occlusion read them with plain array accesses: no palette lookup,
+         * no bounds check and no branch on which chunk a voxel belongs to. Coordinates range from -1 to
+         * Chunk::getLength(), and neighbours along each axis are getStride() cells apart.
+         *
+         * Accessors do not check their arguments; coordinates and indices out of range are undefined behaviour.
+         *
+         * A neighbourhood holds scratch memory meant to be reused between chunks, and must not be shared
+         * between threads while it is being gathered.
+         */
+        class ChunkNeighborhood {
+        public:
+            static constexpr int32_t LENGTH = static_cast<int32_t>(Chunk::getLength());   ///< Voxels per side of the chunk.
+            static constexpr int32_t PADDED_LENGTH = LENGTH + 2;                           ///< Cells per side, shell included.
+            static constexpr size_t VOLUME = size_t(PADDED_LENGTH) * PADDED_LENGTH * PADDED_LENGTH;
+
+            /**
+             * @struct Cell
+             * @brief A voxel of the chunk met while iterating, see voxels().
+             */
+            struct Cell {
+                int32_t x = 0;          ///< Chunk-local x-coordinate.
+                int32_t y = 0;          ///< Chunk-local y-coordinate.
+                int32_t z = 0;          ///< Chunk-local z-coordinate.
+                size_t index = 0;       ///< Index in the padded arrays, see getIndex().
+                uint16_t block = 0;     ///< Block ID.
+                uint8_t light = 0;      ///< Light, sky level in the high nibble and block level in the low one.
+            };
+
+            /**
+             * @class Iterator
+             * @brief Walks the voxels of the chunk, shell excluded, x varying fastest.
+             */
+            class Iterator {
+            public:
+                Iterator(const ChunkNeighborhood& owner, int32_t x, int32_t y, int32_t z) noexcept
+                    : owner_(&owner), x_(x), y_(y), z_(z), index_(getIndex(x, y, z)) {
+                }
+
+                Cell operator*() const noexcept {
+                    return { x_, y_, z_, index_, owner_->blocks_[index_], owner_->light_[index_] };
+                }
+
+                Iterator& operator++() noexcept {
+                    ++index_;
+                    if (++x_ == LENGTH) {
+                        // Skip the two shell cells closing this row and opening the next one
+                        x_ = 0;
+                        index_ += 2;
+                        if (++y_ == LENGTH) {
+                            y_ = 0;
+                            ++z_;
+                            index_ += 2 * PADDED_LENGTH;
+                        }
+                    }
+                    return *this;
+                }
+
+                bool operator==(const Iterator& other) const noexcept { return index_ == other.index_; }
+                bool operator!=(const Iterator& other) const noexcept { return index_ != other.index_; }
+
+            private:
+                const ChunkNeighborhood* owner_;
+                int32_t x_, y_, z_;
+                size_t index_;
+            };
+
+            /**
+             * @brief A range over the voxels of the chunk, for range-based for loops.
+             */
+            struct VoxelRange {
+                const ChunkNeighborhood& owner;
+
+                Iterator begin() const noexcept { return Iterator(owner, 0, 0, 0); }
+                Iterator end() const noexcept { return Iterator(owner, 0, 0, LENGTH); }
+            };
+
+            /**
+             * @brief Constructs a neighbourhood of air under the open sky.
+             */
+            ChunkNeighborhood();
+
+            /**
+             * @brief Copies a chunk on its own, with air under the open sky around it.
+             * @param chunk The chunk to copy.
+             */
+            void gather(const Chunk& chunk);
+
+            /**
+             * @brief Copies a chunk and the adjacent voxels of its neighbours.
+             * @param chunk The chunk to copy.
+             * @param neighbours The neighbouring chunks, see ChunkSnapshot::getNeighbourIndex(). Missing
+             *                   neighbours give air under the open sky.
+             */
+            void gather(const Chunk& chunk, const ChunkSnapshot::Neighbours& neighbours);
+
+            /**
+             * @brief Copies a snapshot, shell included.
+             * @param snapshot The chunk and its neighbour layers.
+             */
+            void gather(const ChunkSnapshot& snapshot);
+
+            /**
+             * @brief Gets the index of a cell in the padded arrays.
+             * @param x The x-coordinate, from -1 to LENGTH.
+             * @param y The y-coordinate, from -1 to LENGTH.
+             * @param z The z-coordinate, from -1 to LENGTH.
+             * @return The index.
+             */
+            static constexpr size_t getIndex(int32_t x, int32_t y, int32_t z) noexcept {
+                return static_cast<size_t>((x + 1) + (y + 1) * PADDED_LENGTH + (z + 1) * PADDED_LENGTH * PADDED_LENGTH);
+            }
+
+            /**
+             * @brief Gets the index offset between two neighbouring cells.
+             * @param axis The axis (0 = x, 1 = y, 2 = z).
+             * @return The stride.
+             */
+            static constexpr size_t getStride(int axis) noexcept {
+                return (axis == 0) ? 1 : (axis == 1) ? size_t(PADDED_LENGTH) : size_t(PADDED_LENGTH) * PADDED_LENGTH;
+            }
+
+            /**
+             * @brief Retrieves the block ID of a cell.
+             * @param index The cell index, see getIndex().
+             * @return The block ID, 0 for air.
+             */
+            [[nodiscard]] uint16_t getBlock(size_t index) const noexcept {
+                return blocks_[index];
+            }
+
+            /**
+             * @brief Retrieves the block ID of a cell.
+             * @return The block ID, 0 for air.
+             */
+            [[nodiscard]] uint16_t getBlock(int32_t x, int32_t y, int32_t z) const noexcept {
+                return blocks_[getIndex(x, y, z)];
+            }
+
+            /**
+             * @brief Retrieves both light levels of a cell.
+             * @param index The cell index, see getIndex().
+             * @return The light, sky level in the high nibble and block level in the low one.
+             */
+            [[nodiscard]] uint8_t getPackedLight(size_t index) const noexcept {
+                return light_[index];
+            }
+
+            /**
+             * @brief Retrieves the light level of a cell.
+             * @param type The light channel.
+             * @return The light level.
+             */
+            [[nodiscard]] uint8_t getLight(LightType type, int32_t x, int32_t y, int32_t z) const noexcept {
+                const uint8_t packed = light_[getIndex(x, y, z)];
+                return (type == LightType::Sky) ? packed >> 4 : packed & 0x0F;
+            }
+
+            /**
+             * @brief Overwrites a cell, for callers filling the neighbourhood from another source.
+             * @param index The cell index, see getIndex().
+             * @param block The block ID.
+             * @param light The light, sky level in the high nibble and block level in the low one.
+             */
+            void set(size_t index, uint16_t block, uint8_t light) noexcept {
+                blocks_[index] = block;
+                light_[index] = light;
+            }
+
+            /**
+             * @brief Gets the block IDs of every cell, indexed like getIndex().
+             * @return VOLUME block IDs.
+             */
+            [[nodiscard]] const uint16_t* getBlocks() const noexcept { return blocks_.data(); }
+
+            /**
+             * @brief Gets the packed light of every cell, indexed like getIndex().
+             * @return VOLUME light values.
+             */
+            [[nodiscard]] const uint8_t* getLights() const noexcept { return light_.data(); }
+
+            /**
+             * @brief Iterates over the voxels of the chunk, shell excluded.
+             * @return A range yielding a Cell per voxel.
+             */
+            [[nodiscard]] VoxelRange voxels() const noexcept {
+                return { *this };
+            }
+
+        private:
+
+            /**
+             * @brief Copies the chunk itself into the inner cells.
+             */
+            void gatherInterior(const Chunk& chunk);
+
+        private:
+            std::vector<uint16_t> blocks_;  ///< Block IDs, VOLUME cells.
+            std::vector<uint8_t> light_;    ///< Light, sky level in the high nibble, VOLUME cells.
+        };
+
+    } // namespace Voxel
+} // namespace Gem
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <Gem/Voxel/chunk.h>
+
+/**
+ * @file chunk_pool.h
+ * @brief Declaration of the ChunkPool class.
+ */
+
+namespace Gem {
+    namespace Voxel {
+
+        /**
+         * @class ChunkPool
+         * @brief Recycles Chunk objects allocated in fixed-size blocks.
+         *
+         * Streaming loads and unloads chunks constantly. Allocating them in blocks and recycling
+         * released ones saves the allocation of the fixed-size part of a chunk, its occupancy bits and
+         * bookkeeping, on every load.
+         *
+         * Only that part is pooled. The voxel palette and the voxel and light pages belong to each chunk
+         * and live on the heap: filling the chunk on release() frees them, and they are allocated again
+         * as the recycled chunk is generated or loaded.
+         */
+        class ChunkPool {
+        public:
+            /**
+             * @brief Constructs an empty pool.
+             * @param chunksPerBlock The number of chunks allocated at once when the pool runs dry.
+             */
+            explicit ChunkPool(size_t chunksPerBlock = 64);
+
+            /**
+             * @brief Takes a chunk from the pool.
+             *
+             * The returned chunk is reset to air.
+             *
+             * @return Pointer to a chunk owned by the pool.
+             */
+            Chunk* acquire();
+
+            /**
+             * @brief Gives a chunk back to the pool.
+             * @param chunk The chunk previously returned by acquire().
+             */
+            void release(Chunk* chunk);
+
+            /**
+             * @brief Gets the number of chunks currently handed out.
+             * @return The number of chunks in use.
+             */
+            [[nodiscard]] size_t getUsedCount() const noexcept;
+
+            /**
+             * @brief Gets the total number of chunks allocated by the pool.
+             * @return The pool capacity.
+             */
+            [[nodiscard]] size_t getCapacity() const noexcept;
+
+            // Chunks are referenced by address, the pool must not move
+            ChunkPool(const ChunkPool&) = delete;
+            ChunkPool& operator=(const ChunkPool&) = delete;
+
+        private:
+            size_t chunksPerBlock_;                         ///< Number of chunks per allocated block.
+            std::vector<std::unique_ptr<Chunk[]>> blocks_;  ///< Allocated chunk blocks.
+            std::vector<Chunk*> free_;                      ///< Chunks ready to be handed out.
+        };
+
+    } // namespace Voxel
+} // namespace Gem
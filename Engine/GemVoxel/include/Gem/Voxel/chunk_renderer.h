@@ -0,0 +1,92 @@
+#pragma once
+
+#include <GlfwGlad.h>
+#include <Gem/Graphics/buffer.h>
+#include <Gem/Graphics/vao.h>
+#include <Gem/Voxel/chunk_mesher.h>
+
+/**
+ * @file chunk_renderer.h
+ * @brief Declaration of the ChunkRenderer class.
+ */
+
+namespace Gem {
+    namespace Voxel {
+
+        /**
+         * @class ChunkRenderer
+         * @brief Owns the GPU buffers of a chunk mesh and draws it with one call per vertex format.
+         *
+         * Cube faces and block shape quads are uploaded to separate buffers, packed as ChunkVertex and
+         * ShapeVertex. render() needs a shader program decoding them like chunk.vert does, renderShapes()
+         * one decoding them like chunk_shape.vert does.
+         *
+         * Must only be used from the thread owning the OpenGL context.
+         */
+        class ChunkRenderer {
+        public:
+            ChunkRenderer();
+            ~ChunkRenderer();
+
+            /**
+             * @brief Uploads a mesh to the GPU, replacing the previous one.
+             *
+             * Buffers are generated on the first upload.
+             *
+             * @param mesh The mesh to upload.
+             */
+            void upload(const ChunkMesh& mesh);
+
+            /**
+             * @brief Draws the cube faces of the uploaded mesh.
+             *
+             * Does nothing if the mesh has no cube face.
+             */
+            void render() const;
+
+            /**
+             * @brief Draws the block shape quads of the uploaded mesh.
+             *
+             * Does nothing if the mesh has no shape quad.
+             */
+            void renderShapes() const;
+
+            /**
+             * @brief Releases the GPU buffers.
+             */
+            void cleanup();
+
+            /**
+             * @brief Gets the number of cube face indices currently uploaded.
+             * @return The index count.
+             */
+            [[nodiscard]] GLsizei getIndexCount() const noexcept;
+
+            /**
+             * @brief Gets the number of shape quad indices currently uploaded.
+             * @return The index count.
+             */
+            [[nodiscard]] GLsizei getShapeIndexCount() const noexcept;
+
+            // Delete copy constructor and copy assignment to prevent double deletion of GL objects
+            ChunkRenderer(const ChunkRenderer&) = delete;
+            ChunkRenderer& operator=(const ChunkRenderer&) = delete;
+
+        private:
+
+            /**
+             * @brief Generates the VAO and buffers and links the vertex attributes.
+             */
+            void initialize();
+
+        private:
+            Gem::Graphics::VAO VAO_, shapeVAO_;
+            Gem::Graphics::Buffer VBO_, IBO_, shapeVBO_, shapeIBO_;
+
+            GLsizei indexCount_ = 0;        ///< Number of cube face indices to draw.
+            GLsizei shapeIndexCount_ = 0;   ///< Number of shape quad indices to draw.
+            bool is_initialized_ = false;   ///< Flag indicating if the GL objects have been generated.
+        };
+
+    } // namespace Voxel
+} // namespace Gem
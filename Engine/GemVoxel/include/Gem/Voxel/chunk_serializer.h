@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <Gem/Voxel/chunk.h>
+
+/**
+ * @file chunk_serializer.h
+ * @brief Declaration of the ChunkSerializer class.
+ */
+
+namespace Gem {
+    namespace Voxel {
+
+        /**
+         * @class ChunkSerializer
+         * @brief Converts chunks to and from compact binary payloads.
+         *
+         * A payload starts with the chunk palette, followed by one of three encodings of the voxels:
+         * - Uniform: nothing, the palette holds a single block.
+         * - Packed: the palette indices exactly as PaletteStorage packs them, so decoding is a single copy.
+         * - Runs: run-length encoded palette indices, for chunks made of long runs such as layered terrain.
+         *
+         * encode() picks whichever of Packed and Runs is smaller. Values are stored little-endian.
+         */
+        class ChunkSerializer {
+        public:
+            static constexpr uint8_t FORMAT_VERSION = 1;
+
+            /**
+             * @brief Ways of storing the palette indices of a payload.
+             */
+            enum class Encoding : uint8_t {
+                Uniform = 0,
+                Packed = 1,
+                Runs = 2
+            };
+
+            /**
+             * @brief Serialises a chunk.
+             * @param chunk The chunk to serialise.
+             * @param payload The output bytes. Previous content is discarded.
+             */
+            static void encode(const Chunk& chunk, std::vector<uint8_t>& payload);
+
+            /**
+             * @brief Restores a chunk from a payload.
+             * @param data The payload bytes. No alignment is required.
+             * @param size The number of bytes.
+             * @param chunk The chunk to fill. Left untouched if the payload is invalid.
+             * @return True if the payload was valid.
+             */
+            static bool decode(const uint8_t* data, size_t size, Chunk& chunk);
+        };
+
+    } // namespace Voxel
+} // namespace Gem
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <Gem/Voxel/chunk.h>
+#include <Gem/Voxel/chunk_coord.h>
+
+/**
+ * @file chunk_snapshot.h
+ * @brief Declaration of the ChunkSnapshot class.
+ */
+
+namespace Gem {
+    namespace Voxel {
+
+        /**
+         * @class ChunkSnapshot
+         * @brief Immutable copy of a chunk and of the one-voxel shell around it, light included.
+         *
+         * The shell is taken from the 26 neighbours, so faces, edges and corners are all available,
+         * which ambient occlusion needs at chunk borders.
+         *
+         * A snapshot is taken on the thread owning the chunks and can then be read from any thread,
+         * which lets workers mesh a chunk while the original keeps being edited. The chunk copy shares
+         * its voxel and light pages with the original, so only the shell is actually copied.
+         */
+        class ChunkSnapshot {
+        public:
+            static constexpr size_t NEIGHBOUR_COUNT = 27;
+
+            using Neighbours = std::array<const Chunk*, NEIGHBOUR_COUNT>;
+
+            /**
+             * @brief Gets the slot of a neighbour in a Neighbours array.
+             * @param dx The chunk offset along x, from -1 to 1.
+             * @param dy The chunk offset along y, from -1 to 1.
+             * @param dz The chunk offset along z, from -1 to 1.
+             * @return The slot. The slot of (0, 0, 0) is the chunk itself and is ignored.
+             */
+            static constexpr size_t getNeighbourIndex(int32_t dx, int32_t dy, int32_t dz) {
+                return static_cast<size_t>((dx + 1) + (dy + 1) * 3 + (dz + 1) * 9);
+            }
+
+            /**
+             * @brief Copies a chunk and the adjacent voxels of its neighbours.
+             * @param coord The coordinate of the chunk.
+             * @param chunk The chunk to copy.
+             * @param neighbours The neighbouring chunks, see getNeighbourIndex(), nullptr when not loaded.
+             */
+            ChunkSnapshot(const ChunkCoord& coord, const Chunk& chunk, const Neighbours& neighbours);
+
+            /**
+             * @brief Retrieves a voxel of the chunk or of the shell.
+             *
+             * Coordinates range from -1 to Chunk::getLength(). Voxels of missing neighbours are air.
+             *
+             * @return The voxel.
+             */
+            [[nodiscard]] Voxel getVoxel(int32_t x, int32_t y, int32_t z) const;
+
+            /**
+             * @brief Retrieves the light level of a voxel of the chunk or of the shell.
+             *
+             * Coordinates follow the same rules as getVoxel(). Voxels of missing neighbours get full sky
+             * light and no block light, like the open sky.
+             *
+             * @param type The light channel.
+             * @return The light level.
+             */
+            [[nodiscard]] uint8_t getLight(LightType type, int32_t x, int32_t y, int32_t z) const;
+
+            /**
+             * @brief Gets the copied chunk.
+             * @return The chunk.
+             */
+            [[nodiscard]] const Chunk& getChunk() const noexcept;
+
+            /**
+             * @brief Gets the coordinate of the copied chunk.
+             * @return The chunk coordinate.
+             */
+            [[nodiscard]] const ChunkCoord& getCoord() const noexcept;
+
+            /**
+             * @brief Gets the chunk version at the time of the snapshot.
+             * @return The chunk version.
+             */
+            [[nodiscard]] uint64_t getVersion() const noexcept;
+
+        private:
+
+            /**
+             * @brief Finds the shell layer and cell holding a voxel outside the chunk.
+             * @return False if the voxel lies inside the chunk.
+             */
+            static bool locate(int32_t x, int32_t y, int32_t z, size_t& layer, size_t& cell) noexcept;
+
+        private:
+            ChunkCoord coord_;                                      ///< Coordinate of the chunk.
+            Chunk chunk_;                                           ///< Copy of the chunk.
+            std::array<std::vector<Voxel>, FACE_COUNT> layers_;     ///< Shell, one (length + 2)^2 layer per face, edges and corners included.
+            std::array<std::vector<uint8_t>, FACE_COUNT> lightLayers_;  ///< Light of the shell, sky in the high nibble.
+        };
+
+    } // namespace Voxel
+} // namespace Gem
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+#include <Gem/Voxel/chunk_coord.h>
+
+/**
+ * @file chunk_visibility.h
+ * @brief Declaration of the ChunkVisibility face connectivity and the ChunkVisibilityGraph walking it.
+ */
+
+namespace Gem {
+    namespace Voxel {
+
+        /**
+         * @class ChunkVisibility
+         * @brief Which faces of a chunk can be seen from which, through its non-opaque voxels.
+         *
+         * A 6x6 symmetric matrix stored as 36 bits: faces a and b are connected when a path of non-opaque
+         * voxels runs from a voxel on face a to a voxel on face b. Built by the chunk mesher, see
+         * ChunkMesh::visibility.
+         */
+        class ChunkVisibility {
+        public:
+
+            /**
+             * @brief Constructs a visibility where no face sees another one, as for a solid chunk.
+             */
+            constexpr ChunkVisibility() noexcept = default;
+
+            /**
+             * @brief A visibility where every face sees every other one, as for an empty chunk.
+             * @return The visibility.
+             */
+            static constexpr ChunkVisibility all() noexcept {
+                ChunkVisibility visibility;
+                visibility.bits_ = (uint64_t(1) << (FACE_COUNT * FACE_COUNT)) - 1;
+                return visibility;
+            }
+
+            /**
+             * @brief Connects every pair of faces of a set.
+             * @param faces One bit per Face, the faces reached by a single flood fill.
+             */
+            constexpr void connect(uint32_t faces) noexcept {
+                for (size_t a = 0; a < FACE_COUNT; ++a) {
+                    if (faces & (1u << a)) {
+                        bits_ |= uint64_t(faces & 0x3F) << (a * FACE_COUNT);
+                    }
+                }
+            }
+
+            /**
+             * @brief Checks whether one face can be seen from another one.
+             * @param from The face the view enters through.
+             * @param to The face the view leaves through.
+             * @return True if the faces are connected.
+             */
+            [[nodiscard]] constexpr bool canSee(Face from, Face to) const noexcept {
+                return (bits_ >> (static_cast<size_t>(from) * FACE_COUNT + static_cast<size_t>(to))) & 1;
+            }
+
+            /**
+             * @brief Gets the raw matrix, bit from * FACE_COUNT + to.
+             * @return The bits.
+             */
+            [[nodiscard]] constexpr uint64_t getBits() const noexcept { return bits_; }
+
+            constexpr bool operator==(const ChunkVisibility& other) const noexcept { return bits_ == other.bits_; }
+            constexpr bool operator!=(const ChunkVisibility& other) const noexcept { return bits_ != other.bits_; }
+
+        private:
+            uint64_t bits_ = 0;     ///< Bit from * FACE_COUNT + to set when the faces are connected.
+        };
+
+        /**
+         * @class ChunkVisibilityGraph
+         * @brief Finds the chunks that can be seen from the camera through the connectivity of the chunks.
+         *
+         * The graph holds the ChunkVisibility of each meshed chunk. findVisible() walks it breadth first
+         * from the chunk holding the camera: a chunk entered through a face is left through the faces
+         * connected to it, and the walk never goes back along a direction it already went forwards along,
+         * so it only moves away from the camera. Caves behind solid rock, and the rock of mountains, are
+         * never reached.
+         *
+         * The test is an approximation done at the chunk level: a chunk is visited once, from the first
+         * path reaching it. Chunks not in the graph (not meshed yet) are crossed as if they were empty.
+         *
+         * CPU only, the graph has no GPU state.
+         */
+        class ChunkVisibilityGraph {
+        public:
+            using Filter = std::function<bool(const ChunkCoord&)>;
+
+            /**
+             * @brief Sets the visibility of a chunk, replacing the previous one.
+             * @param coord The chunk coordinate.
+             * @param visibility The chunk visibility.
+             */
+            void set(const ChunkCoord& coord, ChunkVisibility visibility);
+
+            /**
+             * @brief Removes a chunk, which is then crossed as if it were empty.
+             * @param coord The chunk coordinate.
+             */
+            void remove(const ChunkCoord& coord);
+
+            /**
+             * @brief Removes every chunk.
+             */
+            void clear() noexcept;
+
+            /**
+             * @brief Gets the number of chunks in the graph.
+             * @return The chunk count.
+             */
+            [[nodiscard]] size_t size() const noexcept { return chunks_.size(); }
+
+            /**
+             * @brief Sets how far the walk goes from the camera chunk.
+             * @param horizontal Horizontal radius in chunks.
+             * @param vertical Vertical radius in chunks.
+             */
+            void setRadius(int32_t horizontal, int32_t vertical);
+
+            /**
+             * @brief Finds the chunks that may be seen from a position.
+             *
+             * @param position The camera position, in world units.
+             * @param filter Optional test run on each chunk before it is walked into, such as a frustum test.
+             *               Rejected chunks are neither returned nor walked through.
+             * @return The reachable chunks of the graph, camera chunk first, in walk order. Valid until the next call.
+             */
+            const std::vector<ChunkCoord>& findVisible(const glm::vec3& position, const Filter& filter = {});
+
+        private:
+
+            /**
+             * @struct Node
+             * @brief A chunk waiting in the walk queue.
+             */
+            struct Node {
+                ChunkCoord coord;
+                uint8_t entry;          ///< Face the walk came in through, FACE_COUNT for the camera chunk.
+                uint8_t directions;     ///< One bit per Face the walk moved along to get here.
+            };
+
+        private:
+            std::unordered_map<ChunkCoord, ChunkVisibility, ChunkCoordHash> chunks_;   ///< Visibility of the meshed chunks.
+
+            int32_t horizontalRadius_ = 8;      ///< Horizontal walk radius in chunks.
+            int32_t verticalRadius_ = 4;        ///< Vertical walk radius in chunks.
+
+            std::vector<uint8_t> visited_;      ///< 1 for the chunks reached, dense box around the camera chunk, reused between calls.
+            std::vector<Node> queue_;           ///< Walk queue, reused between calls.
+            std::vector<ChunkCoord> visible_;   ///< Result of the last findVisible().
+        };
+
+    } // namespace Voxel
+} // namespace Gem
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <bitset>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include <Gem/Core/job_system.h>
+#include <Gem/Voxel/block_registry.h>
+#include <Gem/Voxel/chunk.h>
+#include <Gem/Voxel/chunk_coord.h>
+#include <Gem/Voxel/chunk_manager.h>
+
+/**
+ * @file fluid_simulation.h
+ * @brief Declaration of the FluidSimulation class.
+ */
+
+namespace Gem {
+    namespace Voxel {
+
+        /**
+         * @struct FluidSimulationStats
+         * @brief Counters describing the work done by a FluidSimulation.
+         */
+        struct FluidSimulationStats {
+            size_t totalTicks = 0;          ///< Calls to tick().
+            size_t totalUpdates = 0;        ///< Cells evaluated by all ticks.
+            size_t totalChanges = 0;        ///< Voxels changed by all ticks.
+            size_t lastUpdates = 0;         ///< Cells evaluated by the last tick.
+            size_t lastChanges = 0;         ///< Voxels changed by the last tick.
+            size_t activeCells = 0;         ///< Cells waiting for the next tick.
+        };
+
+        /**
+         * @class FluidSimulation
+         * @brief Makes the fluids of a BlockRegistry flow through the chunks of a ChunkManager.
+         *
+         * Fluids are a cellular automaton over block IDs (see BlockRegistry::addFluid()). The next state
+         * of a cell only depends on the current state of the cells around it:
+         * - sources never change;
+         * - a cell below a fluid becomes that fluid, falling;
+         * - otherwise a cell takes the highest level flowing in from its four sides, each side giving its
+         *   level minus the decay of its fluid, or turns back to air when nothing flows in. Only sources
+         *   and fluid standing on something other than air or itself spread sideways.
+         *
+         * Only active cells are evaluated: those next to a voxel that changed, by an edit or by the
+         * simulation itself. Fluid at rest costs nothing, so a tick costs in proportion to the moving fluid.
+         *
+         * Ticks are double-buffered: every active cell is evaluated against the world as it was at the
+         * start of the tick, and the new states go to a change buffer that is written back once all cells
+         * are done. Cells are grouped by chunk, and with a JobSystem each chunk is evaluated by a worker.
+         * Changes are written through ChunkManager::setVoxel(), which marks the dirty sections and calls
+         * the edit callback as for any other edit; the changed chunks are also remembered until
+         * takeChangedChunks() so the caller can mesh them again.
+         *
+         * Chunks that are not loaded stop the flow. Must be used from the thread owning the ChunkManager.
+         */
+        class FluidSimulation {
+        public:
+            /**
+             * @brief Constructs a fluid simulation.
+             * @param world The chunks holding the fluids. Must outlive the simulation.
+             * @param blocks The block types, giving the fluids. Must outlive the simulation.
+             * @param jobs Optional workers to evaluate the chunks on. Must outlive the simulation.
+             */
+            FluidSimulation(ChunkManager& world, const BlockRegistry& blocks, Gem::Core::JobSystem* jobs = nullptr);
+
+            /**
+             * @brief Wakes up the fluid of a freshly loaded chunk, and the fluid of its neighbours facing it.
+             *
+             * Call from the ChunkManager load callback.
+             *
+             * @param coord The coordinate of the loaded chunk.
+             */
+            void onChunkLoaded(const ChunkCoord& coord);
+
+            /**
+             * @brief Wakes up the cells around an edited voxel.
+             *
+             * Call from the ChunkManager edit callback. Edits made by tick() itself are ignored, they are
+             * already accounted for.
+             *
+             * @param voxel The world voxel coordinates.
+             * @param previous The voxel before the edit.
+             * @param value The voxel after the edit.
+             */
+            void onVoxelChanged(const glm::ivec3& voxel, const Voxel& previous, const Voxel& value);
+
+            /**
+             * @brief Advances the simulation by one step.
+             * @return The number of voxels changed.
+             */
+            size_t tick();
+
+            /**
+             * @brief Gets the chunks changed by tick() since the last call and forgets them.
+             * @return The chunk coordinates, in no particular order.
+             */
+            std::vector<ChunkCoord> takeChangedChunks();
+
+            /**
+             * @brief Gets the simulation counters.
+             * @return The current statistics.
+             */
+            [[nodiscard]] FluidSimulationStats getStats() const noexcept;
+
+        private:
+            static constexpr size_t CHUNK_VOLUME = size_t(CHUNK_BOUNDARY) * CHUNK_BOUNDARY * CHUNK_BOUNDARY;
+
+            /**
+             * @brief The active cells of one chunk.
+             */
+            struct ActiveChunk {
+                std::bitset<CHUNK_VOLUME> flags;    ///< Set for the cells listed, so each is listed once.
+                std::vector<uint16_t> cells;        ///< Voxel indices, see Chunk::linearize().
+            };
+
+            /**
+             * @brief The cells of one chunk evaluated by a tick, and their new states.
+             */
+            struct Region {
+                ChunkCoord coord;
+                std::vector<uint16_t> cells;                        ///< Cells to evaluate.
+                std::vector<std::pair<uint16_t, uint16_t>> changes; ///< Cell index and new block ID.
+                std::vector<uint16_t> deferred;                     ///< Cells of slower fluids, evaluated on a later tick.
+            };
+
+            /**
+             * @brief Adds a cell to the cells evaluated by the next tick.
+             */
+            void activate(const glm::ivec3& voxel);
+
+            /**
+             * @brief Adds the cells whose next state reads a voxel.
+             */
+            void activateAround(const glm::ivec3& voxel);
+
+            /**
+             * @brief Wakes up the fluid cells of a chunk within a box of chunk-local coordinates.
+             */
+            void activateFluids(const ChunkCoord& coord, const glm::ivec3& min, const glm::ivec3& max);
+
+            /**
+             * @brief Computes the new states of the cells of a region, reading the world only.
+             */
+            void evaluate(Region& region, uint64_t tick) const;
+
+        private:
+            ChunkManager& world_;                       ///< Chunks holding the fluids.
+            const BlockRegistry& blocks_;               ///< Fluid properties.
+            Gem::Core::JobSystem* jobs_;                ///< Workers, optional.
+
+            std::unordered_map<ChunkCoord, ActiveChunk, ChunkCoordHash> active_;   ///< Cells to evaluate on the next tick.
+            std::vector<Region> regions_;               ///< Change buffers of the tick, reused between ticks.
+            bool applying_ = false;                     ///< True while tick() writes its changes back.
+
+            std::unordered_set<ChunkCoord, ChunkCoordHash> changed_;   ///< Chunks changed since takeChangedChunks().
+            FluidSimulationStats stats_;                ///< Counters.
+        };
+
+    } // namespace Voxel
+} // namespace Gem
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include <Gem/Voxel/block_registry.h>
+#include <Gem/Voxel/chunk.h>
+#include <Gem/Voxel/chunk_coord.h>
+#include <Gem/Voxel/chunk_manager.h>
+
+/**
+ * @file light_engine.h
+ * @brief Declaration of the LightEngine class.
+ */
+
+namespace Gem {
+    namespace Voxel {
+
+        /**
+         * @struct LightEngineStats
+         * @brief Counters describing the work done by a LightEngine.
+         */
+        struct LightEngineStats {
+            size_t totalChunksLit = 0;      ///< Chunks lit after being loaded.
+            size_t totalEdits = 0;          ///< Voxel edits the light was updated for.
+            size_t totalAdded = 0;          ///< Voxels visited by the propagation passes.
+            size_t totalRemoved = 0;        ///< Voxels darkened by the removal passes.
+        };
+
+        /**
+         * @class LightEngine
+         * @brief Computes the sky and block light of the chunks of a ChunkManager.
+         *
+         * Light spreads by breadth-first flood fill across chunk borders, losing one level per voxel.
+         * Sky light enters the world at MAX_LIGHT through the top of the chunks with no loaded chunk above
+         * and travels straight down without losing any level; block light starts at the emission level the
+         * BlockRegistry gives the emitting blocks. Air and the blocks it marks as not opaque, such as leaves
+         * and fluids, let light through; any other block stops it (see setBlockRegistry()).
+         *
+         * Edits only touch the area they affect: the light of the edited voxel, and of every voxel it lit,
+         * is removed by a first flood fill that collects the brighter voxels around the darkened area,
+         * then a second flood fill spreads their light back in.
+         *
+         * Every voxel whose light changes marks the sections showing it dirty, and its chunk is remembered
+         * until takeChangedChunks() so the caller can mesh it again.
+         *
+         * Light is not updated when a chunk is unloaded; it is recomputed when the chunk is loaded again.
+         * Must be used from the thread owning the ChunkManager.
+         */
+        class LightEngine {
+        public:
+            /**
+             * @brief Constructs a light engine.
+             * @param world The chunks to light. Must outlive the engine.
+             */
+            explicit LightEngine(ChunkManager& world);
+
+            /**
+             * @brief Sets the block types telling which blocks stop light and which glow.
+             *
+             * Set it before the first chunk is lit, light already computed is not updated.
+             *
+             * @param registry The block types, nullptr to let only air through and light nothing but the sky.
+             *                 Must outlive the engine.
+             */
+            void setBlockRegistry(const BlockRegistry* registry) noexcept;
+
+            /**
+             * @brief Lights a freshly loaded chunk and updates the light of its neighbours.
+             *
+             * Call from the ChunkManager load callback.
+             *
+             * @param coord The coordinate of the loaded chunk.
+             */
+            void onChunkLoaded(const ChunkCoord& coord);
+
+            /**
+             * @brief Updates the light around an edited voxel.
+             *
+             * Call from the ChunkManager edit callback.
+             *
+             * @param voxel The world voxel coordinates.
+             * @param previous The voxel before the edit.
+             * @param value The voxel after the edit.
+             */
+            void onVoxelChanged(const glm::ivec3& voxel, const Voxel& previous, const Voxel& value);
+
+            /**
+             * @brief Retrieves the light level of a voxel by world coordinates.
+             * @param type The light channel.
+             * @param voxel The world voxel coordinates.
+             * @return The light level. Voxels of chunks not loaded get full sky light and no block light.
+             */
+            [[nodiscard]] uint8_t getLight(LightType type, const glm::ivec3& voxel) const;
+
+            /**
+             * @brief Gets the chunks whose light changed since the last call and forgets them.
+             * @return The chunk coordinates, in no particular order.
+             */
+            std::vector<ChunkCoord> takeChangedChunks();
+
+            /**
+             * @brief Gets the engine counters.
+             * @return The current statistics.
+             */
+            [[nodiscard]] LightEngineStats getStats() const noexcept;
+
+        private:
+
+            /**
+             * @brief A voxel waiting in a flood fill queue.
+             */
+            struct Node {
+                Chunk* chunk = nullptr;     ///< Chunk holding the voxel.
+                ChunkCoord coord;           ///< Coordinate of that chunk.
+                uint16_t index = 0;         ///< Voxel index in the chunk, see Chunk::linearize().
+                uint8_t level = 0;          ///< Light level before removal, removal queues only.
+            };
+
+            /**
+             * @brief Gets the block light emitted by a block type, 0 without a registry or for unknown IDs.
+             */
+            uint8_t getEmission(uint16_t id) const noexcept;
+
+            /**
+             * @brief Checks whether a block type stops light. Air never does, IDs unknown to the registry do.
+             */
+            bool isOpaque(uint16_t id) const noexcept;
+
+            /**
+             * @brief Checks whether a voxel stops light.
+             *
+             * Air is a single bit test on the occupancy, the block ID is only read for solid voxels.
+             *
+             * @param chunk The chunk holding the voxel.
+             * @param index The voxel index in the chunk, see Chunk::linearize().
+             */
+            bool isOpaque(const Chunk& chunk, uint16_t index) const;
+
+            /**
+             * @brief Checks whether a chunk stops all light: full of blocks, none of which lets light through.
+             */
+            bool isSealed(const Chunk& chunk) const;
+
+            /**
+             * @brief Finds the voxel next to another one, possibly in a neighbouring chunk.
+             * @return False if the voxel lies in a chunk that is not loaded.
+             */
+            bool step(const Node& from, size_t face, Node& to) const;
+
+            /**
+             * @brief Gets the light a voxel produces by itself: its emission, or MAX_LIGHT for sky-exposed air.
+             */
+            uint8_t getSourceLevel(LightType type, const Node& node) const;
+
+            /**
+             * @brief Marks the sections showing a voxel dirty and remembers the chunks holding them.
+             */
+            void markChanged(const Node& node);
+
+            /**
+             * @brief Sets the light of a voxel and marks it changed.
+             */
+            void setLevel(LightType type, const Node& node, uint8_t level);
+
+            /**
+             * @brief Darkens the voxels of the removal queue and those they lit.
+             *
+             * Brighter voxels met on the way are queued for propagate().
+             */
+            void removeLight(LightType type);
+
+            /**
+             * @brief Spreads the light of the voxels of the propagation queue.
+             */
+            void propagate(LightType type);
+
+        private:
+            ChunkManager& world_;                       ///< Chunks being lit.
+            const BlockRegistry* registry_ = nullptr;   ///< Opacity and emission of the blocks, optional.
+
+            std::vector<Node> addQueue_;                ///< Voxels whose light must spread, reused between calls.
+            std::vector<Node> removeQueue_;             ///< Voxels whose light must be removed, reused between calls.
+            std::vector<Node> blockQueue_;              ///< Block light seeds of a loaded chunk, spread after the sky light.
+
+            std::unordered_set<ChunkCoord, ChunkCoordHash> changed_;   ///< Chunks changed since takeChangedChunks().
+            LightEngineStats stats_;                    ///< Counters.
+        };
+
+    } // namespace Voxel
+} // namespace Gem
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <Gem/Voxel/shared_pages.h>
+
+/**
+ * @file nibble_array.h
+ * @brief Declaration of the NibbleArray class template.
+ */
+
+namespace Gem {
+    namespace Voxel {
+
+        /**
+         * @class NibbleArray
+         * @brief Fixed-size array of 4-bit values, two per byte.
+         *
+         * Even indices use the low half of a byte and odd indices the high half.
+         *
+         * The bytes are kept in SharedPages of PAGE_LENGTH elements: copies share them and a write only
+         * clones the page it lands in. A filled array is a single page shared by every slot, and writing
+         * the value an element already holds leaves its page shared.
+         *
+         * @tparam Size The number of elements. Must be even, and a multiple of PAGE_LENGTH above it.
+         */
+        template<size_t Size>
+        class NibbleArray {
+        public:
+            static_assert(Size % 2 == 0, "Nibble arrays hold whole bytes.");
+
+            static constexpr uint8_t MAX_VALUE = 15;
+            static constexpr size_t PAGE_LENGTH = (Size < 512) ? Size : 512;  ///< Elements per page.
+
+            static_assert(Size % PAGE_LENGTH == 0, "Nibble arrays hold whole pages.");
+
+            /**
+             * @brief Constructs an array of zeros.
+             */
+            NibbleArray() {
+                fill(0);
+            }
+
+            /**
+             * @brief Retrieves the element at the specified index.
+             * @param index The element index. Must be lower than Size.
+             * @return The element value, from 0 to MAX_VALUE.
+             */
+            [[nodiscard]] uint8_t get(size_t index) const noexcept {
+                return (pages_.getPage(index / PAGE_LENGTH)[(index % PAGE_LENGTH) >> 1] >> ((index & 1) * 4)) & 0x0F;
+            }
+
+            /**
+             * @brief Sets the element at the specified index.
+             * @param index The element index. Must be lower than Size.
+             * @param value The value to store, only its low 4 bits are kept.
+             */
+            void set(size_t index, uint8_t value) {
+                if (get(index) == (value & 0x0F)) {
+                    return;
+                }
+
+                const uint32_t shift = static_cast<uint32_t>(index & 1) * 4;
+                uint8_t& byte = pages_.getMutablePage(index / PAGE_LENGTH)[(index % PAGE_LENGTH) >> 1];
+                byte = static_cast<uint8_t>((byte & ~(0x0F << shift)) | ((value & 0x0F) << shift));
+            }
+
+            /**
+             * @brief Sets every element to the same value.
+             * @param value The value to store, only its low 4 bits are kept.
+             */
+            void fill(uint8_t value) {
+                pages_.assign(Size / PAGE_LENGTH, PAGE_LENGTH / 2, static_cast<uint8_t>((value & 0x0F) * 0x11));
+            }
+
+            /**
+             * @brief Gets the number of elements.
+             * @return Size.
+             */
+            [[nodiscard]] static constexpr size_t size() noexcept { return Size; }
+
+            /**
+             * @brief Gets the packed bytes of a page.
+             * @param page The page index, lower than Size / PAGE_LENGTH.
+             * @return PAGE_LENGTH / 2 bytes, holding elements page * PAGE_LENGTH onwards.
+             */
+            [[nodiscard]] const uint8_t* getPage(size_t page) const noexcept { return pages_.getPage(page); }
+
+            /**
+             * @brief Estimates the heap memory referenced by the array.
+             * @return The number of bytes, shared pages included.
+             */
+            [[nodiscard]] size_t getMemoryUsage() const noexcept { return pages_.getMemoryUsage(); }
+
+        private:
+            SharedPages<uint8_t> pages_;    ///< Two elements per byte, PAGE_LENGTH per page.
+        };
+
+    } // namespace Voxel
+} // namespace Gem
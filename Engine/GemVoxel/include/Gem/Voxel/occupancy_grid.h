@@ -0,0 +1,256 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file occupancy_grid.h
+ * @brief Declaration of the OccupancyGrid class template.
+ */
+
+namespace Gem {
+    namespace Voxel {
+
+        /**
+         * @class OccupancyGrid
+         * @brief One bit per voxel of a cube, set for solid voxels, with coarser "any solid" levels on top.
+         *
+         * Bits are ordered x first, then y, then z, so a row of voxels along x is a run of Size bits in a
+         * single word (see getRow()) and can be scanned with popcount and count-trailing-zeros.
+         *
+         * Above the voxel bits sit LEVEL_COUNT levels of cells of 2^3, 4^3 and 8^3 voxels, a cell bit
+         * being set when any voxel of the cell is solid. Setting a voxel sets the cells containing it,
+         * clearing one only looks at the eight children of each cell on the way up, so updates cost a
+         * few word operations. The solid voxel count is kept too, so isEmpty() and isFull() are O(1).
+         *
+         * @tparam Size The number of voxels per side. A power of two from 8 to 64.
+         */
+        template<uint32_t Size>
+        class OccupancyGrid {
+        public:
+            static_assert(Size >= 8 && Size <= 64 && (Size & (Size - 1)) == 0, "Occupancy grids range from 8 to 64 voxels per side, in powers of two.");
+
+            static constexpr uint32_t LEVEL_COUNT = 3;                  ///< Cell levels, 2^3, 4^3 and 8^3 voxels.
+            static constexpr size_t VOLUME = size_t(Size) * Size * Size;
+            static constexpr size_t WORD_COUNT = VOLUME / 64;
+
+            /**
+             * @brief Gets the side of the cells of a level.
+             * @param level The level, lower than LEVEL_COUNT.
+             * @return The cell side in voxels.
+             */
+            static constexpr uint32_t getCellLength(uint32_t level) noexcept { return 2u << level; }
+
+            /**
+             * @brief Gets the number of cells of a level along each axis.
+             * @param level The level, lower than LEVEL_COUNT.
+             * @return The cell count per axis.
+             */
+            static constexpr uint32_t getCellsPerAxis(uint32_t level) noexcept { return Size / getCellLength(level); }
+
+            /**
+             * @brief Converts voxel coordinates to a bit index.
+             * @return x + (y + z * Size) * Size.
+             */
+            static constexpr size_t getIndex(uint32_t x, uint32_t y, uint32_t z) noexcept {
+                return x + (y + size_t(z) * Size) * Size;
+            }
+
+            /**
+             * @brief Gets the index of the cell of a level containing a voxel.
+             * @param level The level, lower than LEVEL_COUNT.
+             * @return The cell index, ordered like getIndex().
+             */
+            static constexpr size_t getCellIndex(uint32_t level, uint32_t x, uint32_t y, uint32_t z) noexcept {
+                const uint32_t shift = level + 1;
+                const size_t n = getCellsPerAxis(level);
+                return (x >> shift) + ((y >> shift) + (z >> shift) * n) * n;
+            }
+
+            /**
+             * @brief Checks whether a voxel is solid. Coordinates must be lower than Size.
+             */
+            [[nodiscard]] bool test(uint32_t x, uint32_t y, uint32_t z) const noexcept {
+                return test(getIndex(x, y, z));
+            }
+
+            /**
+             * @brief Checks whether a voxel is solid.
+             * @param index The bit index, see getIndex().
+             */
+            [[nodiscard]] bool test(size_t index) const noexcept {
+                return (words_[index >> 6] >> (index & 63)) & 1;
+            }
+
+            /**
+             * @brief Gets the solid voxels of a row along x.
+             * @return Bit x set for each solid voxel of the row, Size bits.
+             */
+            [[nodiscard]] uint64_t getRow(uint32_t y, uint32_t z) const noexcept {
+                const size_t index = getIndex(0, y, z);
+                return (words_[index >> 6] >> (index & 63)) & ROW_MASK;
+            }
+
+            /**
+             * @brief Checks whether the cell of a level containing a voxel holds any solid voxel.
+             * @param level The level, lower than LEVEL_COUNT.
+             */
+            [[nodiscard]] bool testCell(uint32_t level, uint32_t x, uint32_t y, uint32_t z) const noexcept {
+                return testCellIndex(level, getCellIndex(level, x, y, z));
+            }
+
+            /**
+             * @brief Checks whether a cell of a level holds any solid voxel.
+             * @param level The level, lower than LEVEL_COUNT.
+             * @param cell The cell index, see getCellIndex().
+             */
+            [[nodiscard]] bool testCellIndex(uint32_t level, size_t cell) const noexcept {
+                return (levels_[LEVEL_OFFSETS[level] + (cell >> 6)] >> (cell & 63)) & 1;
+            }
+
+            /**
+             * @brief Gets the largest empty aligned cube holding a voxel, to skip empty space.
+             * @return 0 if the voxel is solid, else the side of the largest empty cell containing it:
+             *         Size for an empty grid, a cell length of the levels, or 1.
+             */
+            [[nodiscard]] uint32_t getEmptyLength(uint32_t x, uint32_t y, uint32_t z) const noexcept {
+                if (count_ == 0) {
+                    return Size;
+                }
+                if (test(x, y, z)) {
+                    return 0;
+                }
+
+                // Coarsest first, an empty cell only holds empty cells
+                for (uint32_t level = LEVEL_COUNT; level-- > 0;) {
+                    if (!testCell(level, x, y, z)) {
+                        return getCellLength(level);
+                    }
+                }
+                return 1;
+            }
+
+            /**
+             * @brief Sets whether a voxel is solid, updating the levels above it.
+             */
+            void set(uint32_t x, uint32_t y, uint32_t z, bool solid) noexcept {
+                const size_t index = getIndex(x, y, z);
+                const uint64_t bit = uint64_t(1) << (index & 63);
+                uint64_t& word = words_[index >> 6];
+
+                if (((word & bit) != 0) == solid) {
+                    return;
+                }
+
+                if (solid) {
+                    word |= bit;
+                    ++count_;
+                    for (uint32_t level = 0; level < LEVEL_COUNT; ++level) {
+                        setCell(level, getCellIndex(level, x, y, z), true);
+                    }
+                    return;
+                }
+
+                word &= ~bit;
+                --count_;
+
+                // Clear the cells up the hierarchy until one still holds something
+                for (uint32_t level = 0; level < LEVEL_COUNT; ++level) {
+                    if (anyInCell(level, x, y, z)) {
+                        break;
+                    }
+                    setCell(level, getCellIndex(level, x, y, z), false);
+                }
+            }
+
+            /**
+             * @brief Sets every voxel to the same state.
+             */
+            void fill(bool solid) noexcept {
+                words_.fill(solid ? ~uint64_t(0) : 0);
+                count_ = solid ? static_cast<uint32_t>(VOLUME) : 0;
+
+                for (uint32_t level = 0; level < LEVEL_COUNT; ++level) {
+                    const size_t cells = size_t(getCellsPerAxis(level)) * getCellsPerAxis(level) * getCellsPerAxis(level);
+                    for (size_t w = 0; w < LEVEL_WORDS[level]; ++w) {
+                        const size_t bits = cells - w * 64;
+                        levels_[LEVEL_OFFSETS[level] + w] = !solid ? 0 : (bits >= 64) ? ~uint64_t(0) : (uint64_t(1) << bits) - 1;
+                    }
+                }
+            }
+
+            /**
+             * @brief Gets the number of solid voxels.
+             */
+            [[nodiscard]] size_t count() const noexcept { return count_; }
+
+            /**
+             * @brief Checks whether no voxel is solid.
+             */
+            [[nodiscard]] bool isEmpty() const noexcept { return count_ == 0; }
+
+            /**
+             * @brief Checks whether every voxel is solid.
+             */
+            [[nodiscard]] bool isFull() const noexcept { return count_ == VOLUME; }
+
+            /**
+             * @brief Gets the voxel bits, ordered like getIndex().
+             * @return WORD_COUNT words.
+             */
+            [[nodiscard]] const std::array<uint64_t, WORD_COUNT>& getWords() const noexcept { return words_; }
+
+        private:
+            static constexpr uint64_t ROW_MASK = (Size == 64) ? ~uint64_t(0) : (uint64_t(1) << Size) - 1;
+
+            // Words holding the bits of each level, one bit per cell
+            static constexpr size_t LEVEL_WORDS[LEVEL_COUNT] = {
+                (size_t(Size / 2) * (Size / 2) * (Size / 2) + 63) / 64,
+                (size_t(Size / 4) * (Size / 4) * (Size / 4) + 63) / 64,
+                (size_t(Size / 8) * (Size / 8) * (Size / 8) + 63) / 64
+            };
+            static constexpr size_t LEVEL_OFFSETS[LEVEL_COUNT] = { 0, LEVEL_WORDS[0], LEVEL_WORDS[0] + LEVEL_WORDS[1] };
+            static constexpr size_t LEVEL_WORD_COUNT = LEVEL_OFFSETS[LEVEL_COUNT - 1] + LEVEL_WORDS[LEVEL_COUNT - 1];
+
+            void setCell(uint32_t level, size_t cell, bool solid) noexcept {
+                uint64_t& word = levels_[LEVEL_OFFSETS[level] + (cell >> 6)];
+                const uint64_t bit = uint64_t(1) << (cell & 63);
+                word = solid ? (word | bit) : (word & ~bit);
+            }
+
+            /**
+             * @brief Checks whether the cell of a level containing a voxel holds any solid voxel, from the level below.
+             */
+            bool anyInCell(uint32_t level, uint32_t x, uint32_t y, uint32_t z) const noexcept {
+                const uint32_t length = getCellLength(level);
+                const uint32_t bx = x & ~(length - 1);
+                const uint32_t by = y & ~(length - 1);
+                const uint32_t bz = z & ~(length - 1);
+
+                // The 2^3 cells read their four rows of two voxels
+                if (level == 0) {
+                    return ((getRow(by, bz) | getRow(by + 1, bz) | getRow(by, bz + 1) | getRow(by + 1, bz + 1)) >> bx) & 3;
+                }
+
+                // Larger cells read their eight children
+                const uint32_t half = length / 2;
+                for (uint32_t k = 0; k < 2; ++k) {
+                    for (uint32_t j = 0; j < 2; ++j) {
+                        for (uint32_t i = 0; i < 2; ++i) {
+                            if (testCell(level - 1, bx + i * half, by + j * half, bz + k * half)) {
+                                return true;
+                            }
+                        }
+                    }
+                }
+                return false;
+            }
+
+            std::array<uint64_t, WORD_COUNT> words_{};          ///< One bit per voxel.
+            std::array<uint64_t, LEVEL_WORD_COUNT> levels_{};   ///< One bit per cell, level after level.
+            uint32_t count_ = 0;                                ///< Solid voxels.
+        };
+
+    } // namespace Voxel
+} // namespace Gem
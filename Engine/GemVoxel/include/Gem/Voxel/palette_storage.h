@@ -0,0 +1,388 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <stdexcept>
+#include <Gem/Voxel/shared_pages.h>
+
+/**
+ * @file palette_storage.h
+ * @brief Declaration of the PaletteStorage class template.
+ */
+
+namespace Gem {
+    namespace Voxel {
+
+        /**
+         * @class PaletteStorage
+         * @brief Fixed-size array compressed with a palette and bit-packed indices.
+         *
+         * Every distinct value is stored once in the palette and each element only keeps
+         * an index into it. Indices use 0, 1, 2, 4, 8 or 16 bits depending on the palette size,
+         * so a uniform array costs a single palette entry and no index data at all.
+         * Because the widths are powers of two, an index never straddles two words and
+         * reads stay O(1).
+         *
+         * The palette grows automatically on set(). Entries that are no longer referenced are
+         * reused, and the storage shrinks back to a narrower width once enough of them are freed.
+         *
+         * The indices are kept in SharedPages of PAGE_LENGTH elements, so copying a storage shares
+         * them and an edit only clones the page it writes. The palette itself is small and copied.
+         *
+         * @tparam T The element type. Must be copyable and equality comparable.
+         */
+        template<typename T>
+        class PaletteStorage {
+        public:
+            static constexpr size_t PAGE_LENGTH = 512;  ///< Elements per page of indices.
+
+            /**
+             * @brief Constructs a storage of the given size filled with a single value.
+             * @param size The number of elements.
+             * @param value The initial value of every element.
+             */
+            explicit PaletteStorage(size_t size, const T& value = T())
+                : size_(size) {
+                fill(value);
+            }
+
+            /**
+             * @brief Retrieves the element at the specified index.
+             * @param index The element index. Must be lower than size().
+             * @return The element value.
+             */
+            [[nodiscard]] T get(size_t index) const {
+                return palette_[readIndex(index)];
+            }
+
+            /**
+             * @brief Sets the element at the specified index.
+             *
+             * Adds the value to the palette and widens the indices if required.
+             *
+             * @param index The element index. Must be lower than size().
+             * @param value The value to store.
+             * @return True if the element changed.
+             */
+            bool set(size_t index, const T& value) {
+                const uint32_t oldEntry = readIndex(index);
+                if (palette_[oldEntry] == value) {
+                    return false;
+                }
+
+                const uint32_t newEntry = acquireEntry(value);
+
+                writeIndex(index, newEntry);
+                ++refCounts_[newEntry];
+
+                // The whole array now holds a single value
+                if (refCounts_[newEntry] == size_) {
+                    fill(value);
+                    return true;
+                }
+
+                if (--refCounts_[oldEntry] == 0) {
+                    ++unusedEntries_;
+
+                    // Shrink with some hysteresis so alternating edits do not repack every time
+                    const size_t liveEntries = palette_.size() - unusedEntries_;
+                    if (liveEntries <= capacity(narrowerBits(bits_)) / 2) {
+                        compact();
+                    }
+                }
+
+                return true;
+            }
+
+            /**
+             * @brief Sets every element to the same value.
+             *
+             * Collapses the storage to a single palette entry with 0-bit indices.
+             *
+             * @param value The value to store.
+             */
+            void fill(const T& value) {
+                bits_ = 0;
+                unusedEntries_ = 0;
+
+                palette_.assign(1, value);
+                refCounts_.assign(1, static_cast<uint32_t>(size_));
+
+                pages_.clear();
+            }
+
+            /**
+             * @brief Rebuilds the palette with only the referenced values and the narrowest index width.
+             */
+            void compact() {
+                std::vector<uint32_t> remap(palette_.size(), 0);
+                std::vector<T> palette;
+                std::vector<uint32_t> refCounts;
+
+                for (uint32_t entry = 0; entry < palette_.size(); ++entry) {
+                    if (refCounts_[entry] > 0) {
+                        remap[entry] = static_cast<uint32_t>(palette.size());
+                        palette.push_back(palette_[entry]);
+                        refCounts.push_back(refCounts_[entry]);
+                    }
+                }
+
+                repack(bitsFor(palette.size()), remap.data());
+
+                palette_ = std::move(palette);
+                refCounts_ = std::move(refCounts);
+                unusedEntries_ = 0;
+            }
+
+            /**
+             * @brief Replaces the content with previously packed indices, see getPalette() and getPackedIndices().
+             *
+             * The indices must use the width the palette size calls for, as getPackedIndices() returns them.
+             * Reference counts are rebuilt from the indices.
+             *
+             * @param palette The palette. Must hold between 1 and size() entries.
+             * @param words The bit-packed palette indices.
+             * @throws std::invalid_argument if the data does not describe a valid storage.
+             */
+            void assign(std::vector<T> palette, std::vector<uint64_t> words) {
+                if (palette.empty() || palette.size() > size_) {
+                    throw std::invalid_argument("PaletteStorage palette size out of range.");
+                }
+
+                const uint8_t bits = bitsFor(palette.size());
+                if (words.size() != ((bits > 0) ? (size_ * bits + 63) / 64 : 0)) {
+                    throw std::invalid_argument("PaletteStorage packed index size mismatch.");
+                }
+
+                if (bits == 0) {
+                    fill(palette[0]);
+                    return;
+                }
+
+                std::vector<uint32_t> refCounts(palette.size(), 0);
+                const uint64_t mask = (uint64_t(1) << bits) - 1;
+
+                for (size_t index = 0; index < size_; ++index) {
+                    const size_t bit = index * bits;
+                    const uint64_t entry = (words[bit >> 6] >> (bit & 63)) & mask;
+
+                    if (entry >= palette.size()) {
+                        throw std::invalid_argument("PaletteStorage index out of palette range.");
+                    }
+                    ++refCounts[entry];
+                }
+
+                palette_ = std::move(palette);
+                refCounts_ = std::move(refCounts);
+                pages_.assign(words.data(), words.size(), getPageWords(bits));
+                bits_ = bits;
+                unusedEntries_ = static_cast<size_t>(std::count(refCounts_.begin(), refCounts_.end(), 0u));
+            }
+
+            /**
+             * @brief Gets the palette index of an element.
+             * @param index The element index. Must be lower than size().
+             * @return The entry of getPalette() the element refers to.
+             */
+            [[nodiscard]] uint32_t getIndex(size_t index) const noexcept {
+                return readIndex(index);
+            }
+
+            /**
+             * @brief Gets the palette, including unused entries.
+             * @return The distinct values referenced by the indices.
+             */
+            [[nodiscard]] const std::vector<T>& getPalette() const noexcept { return palette_; }
+
+            /**
+             * @brief Gets the bit-packed palette indices.
+             *
+             * Element i uses getBitsPerEntry() bits starting at bit i * getBitsPerEntry(), words are little-endian.
+             * Empty when the storage is uniform.
+             *
+             * @return The packed words, gathered from the pages.
+             */
+            [[nodiscard]] std::vector<uint64_t> getPackedIndices() const {
+                std::vector<uint64_t> words((bits_ > 0) ? (size_ * bits_ + 63) / 64 : 0);
+
+                const size_t pageWords = getPageWords(bits_);
+                for (size_t first = 0; first < words.size(); first += pageWords) {
+                    const uint64_t* page = pages_.getPage(first / pageWords);
+                    std::copy_n(page, std::min(pageWords, words.size() - first), words.data() + first);
+                }
+                return words;
+            }
+
+            /**
+             * @brief Gets the number of elements.
+             * @return The element count.
+             */
+            [[nodiscard]] size_t size() const noexcept { return size_; }
+
+            /**
+             * @brief Gets the current index width.
+             * @return The number of bits per element (0, 1, 2, 4, 8 or 16).
+             */
+            [[nodiscard]] uint8_t getBitsPerEntry() const noexcept { return bits_; }
+
+            /**
+             * @brief Gets the number of palette entries, including unused ones.
+             * @return The palette size.
+             */
+            [[nodiscard]] size_t getPaletteSize() const noexcept { return palette_.size(); }
+
+            /**
+             * @brief Checks whether every element holds the same value.
+             * @return True if the storage is uniform.
+             */
+            [[nodiscard]] bool isUniform() const noexcept { return bits_ == 0; }
+
+            /**
+             * @brief Gets the narrowest supported width able to address a palette of the given size.
+             * @param paletteSize The number of palette entries.
+             * @return The number of bits per element (0, 1, 2, 4, 8 or 16).
+             */
+            static constexpr uint8_t bitsFor(size_t paletteSize) noexcept {
+                if (paletteSize <= 1) return 0;
+                if (paletteSize <= 2) return 1;
+                if (paletteSize <= 4) return 2;
+                if (paletteSize <= 16) return 4;
+                if (paletteSize <= 256) return 8;
+                return 16;
+            }
+
+            /**
+             * @brief Estimates the heap memory used by the storage.
+             * @return The number of bytes allocated for the palette and the indices.
+             */
+            [[nodiscard]] size_t getMemoryUsage() const noexcept {
+                return palette_.capacity() * sizeof(T)
+                    + refCounts_.capacity() * sizeof(uint32_t)
+                    + pages_.getMemoryUsage();
+            }
+
+        private:
+            static constexpr size_t PAGE_SHIFT = 9;
+            static_assert(PAGE_LENGTH == size_t(1) << PAGE_SHIFT, "The page length must match its shift.");
+
+            /**
+             * @brief Gets the number of words in a page of indices of a given width.
+             */
+            static constexpr size_t getPageWords(uint8_t bits) noexcept {
+                return PAGE_LENGTH * bits / 64;
+            }
+
+            /**
+             * @brief Gets the number of palette entries addressable with a given width.
+             */
+            static constexpr size_t capacity(uint8_t bits) noexcept {
+                return size_t(1) << bits;
+            }
+
+            /**
+             * @brief Gets the next narrower supported width.
+             */
+            static constexpr uint8_t narrowerBits(uint8_t bits) noexcept {
+                return bits / 2;
+            }
+
+            /**
+             * @brief Reads the palette index of an element.
+             */
+            [[nodiscard]] uint32_t readIndex(size_t index) const noexcept {
+                if (bits_ == 0) {
+                    return 0;
+                }
+
+                // Pages hold whole words, so the bit offset restarts at each page
+                const size_t bit = (index & (PAGE_LENGTH - 1)) * bits_;
+                const uint64_t mask = (uint64_t(1) << bits_) - 1;
+                return static_cast<uint32_t>((pages_.getPage(index >> PAGE_SHIFT)[bit >> 6] >> (bit & 63)) & mask);
+            }
+
+            /**
+             * @brief Writes the palette index of an element.
+             */
+            void writeIndex(size_t index, uint32_t entry) {
+                const size_t bit = (index & (PAGE_LENGTH - 1)) * bits_;
+                const uint64_t mask = (uint64_t(1) << bits_) - 1;
+                uint64_t& word = pages_.getMutablePage(index >> PAGE_SHIFT)[bit >> 6];
+                word = (word & ~(mask << (bit & 63))) | (uint64_t(entry) << (bit & 63));
+            }
+
+            /**
+             * @brief Finds or allocates the palette entry of a value, widening the indices if needed.
+             */
+            uint32_t acquireEntry(const T& value) {
+                uint32_t freeEntry = UINT32_MAX;
+
+                for (uint32_t entry = 0; entry < palette_.size(); ++entry) {
+                    if (refCounts_[entry] == 0) {
+                        if (freeEntry == UINT32_MAX) {
+                            freeEntry = entry;
+                        }
+                    }
+                    else if (palette_[entry] == value) {
+                        return entry;
+                    }
+                }
+
+                // Reuse a slot freed by previous edits
+                if (freeEntry != UINT32_MAX) {
+                    palette_[freeEntry] = value;
+                    --unusedEntries_;
+                    return freeEntry;
+                }
+
+                if (palette_.size() >= size_) {
+                    throw std::length_error("PaletteStorage palette overflow.");
+                }
+
+                palette_.push_back(value);
+                refCounts_.push_back(0);
+
+                if (palette_.size() > capacity(bits_)) {
+                    repack(bitsFor(palette_.size()), nullptr);
+                }
+
+                return static_cast<uint32_t>(palette_.size() - 1);
+            }
+
+            /**
+             * @brief Re-encodes every index with a new width, optionally remapping them.
+             * @param bits The new index width.
+             * @param remap Optional old-to-new palette index table.
+             */
+            void repack(uint8_t bits, const uint32_t* remap) {
+                std::vector<uint64_t> words;
+                if (bits > 0) {
+                    words.assign((size_ * bits + 63) / 64, 0);
+                }
+
+                for (size_t index = 0; bits > 0 && index < size_; ++index) {
+                    uint32_t entry = readIndex(index);
+                    if (remap) {
+                        entry = remap[entry];
+                    }
+
+                    const size_t bit = index * bits;
+                    words[bit >> 6] |= uint64_t(entry) << (bit & 63);
+                }
+
+                pages_.assign(words.data(), words.size(), getPageWords(bits));
+                bits_ = bits;
+            }
+
+        private:
+            size_t size_;                       ///< Number of elements.
+            uint8_t bits_ = 0;                  ///< Bits per packed index.
+            size_t unusedEntries_ = 0;          ///< Palette entries with a zero reference count.
+
+            std::vector<T> palette_;            ///< Distinct values referenced by the indices.
+            std::vector<uint32_t> refCounts_;   ///< Number of elements referencing each palette entry.
+            SharedPages<uint64_t> pages_;       ///< Bit-packed palette indices, PAGE_LENGTH per page.
+        };
+
+    } // namespace Voxel
+} // namespace Gem
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include <Gem/Core/job_system.h>
+#include <Gem/Voxel/block_registry.h>
+#include <Gem/Voxel/chunk_coord.h>
+#include <Gem/Voxel/chunk_manager.h>
+#include <Gem/Voxel/world_view.h>
+
+/**
+ * @file physics.h
+ * @brief Declaration of the Physics class moving axis-aligned boxes through the voxel grid.
+ */
+
+namespace Gem {
+    namespace Voxel {
+
+        /**
+         * @struct PhysicsBody
+         * @brief An entity moved by Physics, an axis-aligned box standing on its bottom face.
+         */
+        struct PhysicsBody {
+            glm::vec3 position{ 0.0f };             ///< Centre of the bottom face of the box, in world units.
+            glm::vec3 size{ 0.6f, 1.8f, 0.6f };     ///< Box extents, in world units.
+            glm::vec3 velocity{ 0.0f };             ///< World units per second, used by Physics::step().
+            float stepHeight = 0.6f;                ///< Highest ledge walked onto without jumping, 0 to disable.
+            bool onGround = false;                  ///< True when the box stands on a solid voxel.
+            glm::bvec3 collided{ false };           ///< Axes the last move was stopped along.
+        };
+
+        /**
+         * @struct PhysicsStats
+         * @brief Counters describing the work done by Physics::step().
+         */
+        struct PhysicsStats {
+            size_t totalSteps = 0;              ///< Calls to step().
+            size_t totalBodies = 0;             ///< Bodies moved by all steps.
+            size_t lastBodies = 0;              ///< Bodies moved by the last step.
+            size_t lastSkipped = 0;             ///< Bodies of the last step left in place, their chunk not being loaded.
+            double lastMillis = 0.0;            ///< Duration of the last step.
+            double bodiesPerMillisecond = 0.0;  ///< Throughput of the last step.
+        };
+
+        /**
+         * @class Physics
+         * @brief Sweeps axis-aligned boxes through the voxels of a ChunkManager.
+         *
+         * A move is resolved one axis at a time, vertical first: the box is pushed along the axis as far
+         * as the voxels ahead of it allow, then the next axis starts from there. Only the voxels the box
+         * sweeps over along the axis are read, nearest layer first, and the sweep stops at the first layer
+         * further away than what is left of the move, so the cost follows the distance moved rather than
+         * the size of the world.
+         *
+         * Voxels collide with the boxes of their BlockShape when their block is solid, and as full cubes
+         * when no registry is given. Voxels of chunks that are not loaded are solid, so nothing falls
+         * through terrain that is still being generated.
+         *
+         * A box that stands on the ground, or lands during the move, and is stopped sideways, tries the
+         * move again raised by its step height and keeps that attempt if it goes further, which walks it
+         * up slabs and stairs. A box overlapping a voxel is never pushed out of it, only kept from moving
+         * further in.
+         *
+         * Moves only read the world, so step() can spread bodies over a JobSystem. Must be used from the
+         * thread owning the ChunkManager, or while nothing edits it.
+         */
+        class Physics {
+        public:
+            /**
+             * @brief Constructs the physics of a world.
+             *
+             * The collision boxes of each block are gathered once here, blocks added to the registry later
+             * collide as full cubes.
+             *
+             * @param world The chunks to collide with. Must outlive the physics.
+             * @param blocks Optional block types, giving which blocks are solid and their shapes. Must outlive the physics.
+             */
+            explicit Physics(const ChunkManager& world, const BlockRegistry* blocks = nullptr);
+
+            /**
+             * @brief Moves a body, stopping it against solid voxels.
+             *
+             * Updates the body position, onGround and collided. The velocity is left as it is.
+             *
+             * @param body The body.
+             * @param displacement The wanted move, in world units.
+             * @return The move actually done.
+             */
+            glm::vec3 move(PhysicsBody& body, const glm::vec3& displacement) const;
+
+            /**
+             * @brief Advances every body by one time step, the batched entry point of a server tick.
+             *
+             * Each body is accelerated by the gravity then moved by its velocity. Velocity components along
+             * the axes the body is stopped along are zeroed. Bodies in a chunk that is not loaded are left
+             * as they are.
+             *
+             * @param bodies The bodies.
+             * @param seconds The time step.
+             * @param jobs Optional workers to move the bodies on.
+             */
+            void step(std::vector<PhysicsBody>& bodies, float seconds, Gem::Core::JobSystem* jobs = nullptr);
+
+            /**
+             * @brief Checks whether a box overlaps a solid voxel.
+             * @param min The lowest corner, in world units.
+             * @param max The highest corner, in world units.
+             * @return True if any collision box intersects the inside of the box.
+             */
+            [[nodiscard]] bool overlaps(const glm::vec3& min, const glm::vec3& max) const;
+
+            /**
+             * @brief Sets the acceleration applied by step().
+             * @param gravity World units per second squared.
+             */
+            void setGravity(const glm::vec3& gravity) noexcept { gravity_ = gravity; }
+
+            /**
+             * @brief Gets the acceleration applied by step().
+             * @return World units per second squared.
+             */
+            [[nodiscard]] const glm::vec3& getGravity() const noexcept { return gravity_; }
+
+            /**
+             * @brief Gets the step counters.
+             * @return The current statistics.
+             */
+            [[nodiscard]] const PhysicsStats& getStats() const noexcept { return stats_; }
+
+        private:
+
+            /**
+             * @struct Box
+             * @brief A collision box, in voxel units relative to its voxel.
+             */
+            struct Box {
+                glm::vec3 min;
+                glm::vec3 max;
+            };
+
+            /**
+             * @brief Gets the collision boxes of a voxel.
+             * @return The first box and the box count.
+             */
+            std::pair<const Box*, size_t> getBoxes(const glm::ivec3& voxel, WorldView& view) const;
+
+            /**
+             * @brief Shortens a move along one axis so the box stops at the first collision box ahead.
+             * @param axis The axis, 0 = x, 1 = y, 2 = z.
+             * @param min The lowest corner of the box.
+             * @param max The highest corner of the box.
+             * @param delta The wanted move along the axis.
+             * @return The allowed move, between 0 and delta.
+             */
+            float sweep(int axis, const glm::vec3& min, const glm::vec3& max, float delta, WorldView& view) const;
+
+            /**
+             * @brief Moves a box along the three axes in turn, vertical first.
+             * @return The move done.
+             */
+            glm::vec3 sweepAll(glm::vec3& min, glm::vec3& max, const glm::vec3& displacement, WorldView& view) const;
+
+        private:
+            const ChunkManager& world_;                 ///< Chunks to collide with.
+            const BlockRegistry* blocks_;               ///< Block types, optional.
+
+            std::vector<uint32_t> firstBox_;            ///< Index of the first collision box of each block ID, plus an end entry.
+            std::vector<Box> boxes_;                    ///< Collision boxes of all blocks, the unit cube first.
+
+            glm::vec3 gravity_{ 0.0f, -32.0f, 0.0f };   ///< Acceleration applied by step().
+            PhysicsStats stats_;                        ///< Counters.
+        };
+
+    } // namespace Voxel
+} // namespace Gem
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <glm/glm.hpp>
+
+#include <Gem/Core/job_system.h>
+#include <Gem/Voxel/chunk.h>
+#include <Gem/Voxel/chunk_manager.h>
+
+/**
+ * @file raycast.h
+ * @brief Declaration of the voxel ray casting functions.
+ */
+
+namespace Gem {
+    namespace Voxel {
+
+        /**
+         * @struct Ray
+         * @brief A ray to cast through the voxels of a ChunkManager.
+         */
+        struct Ray {
+            glm::vec3 origin{ 0.0f };       ///< World-space start point.
+            glm::vec3 direction{ 0.0f };    ///< World-space direction, need not be normalised.
+            float maxDistance = 0.0f;       ///< Length of the ray, in world units. Must be finite.
+        };
+
+        /**
+         * @struct RaycastHit
+         * @brief The first solid voxel met by a ray.
+         */
+        struct RaycastHit {
+            bool hit = false;               ///< True if a solid voxel was met, the other fields are only valid then.
+            glm::ivec3 voxel{ 0 };          ///< World coordinates of the voxel.
+            glm::ivec3 normal{ 0 };         ///< Normal of the face the ray entered through, zero if the ray starts inside the voxel.
+            float distance = 0.0f;          ///< Distance from the origin to the entry point.
+            Voxel block;                    ///< The voxel that was hit.
+        };
+
+        /**
+         * @brief Casts a ray through the resident chunks (Amanatides-Woo DDA).
+         *
+         * The ray walks voxel by voxel across chunk borders. Chunks that are not loaded and empty
+         * occupancy cells (see Chunk::getOccupancy()) are crossed without reading any voxel.
+         *
+         * @param world The chunks to cast through. Missing chunks are treated as air.
+         * @param origin World-space start point.
+         * @param direction World-space direction, need not be normalised.
+         * @param maxDistance Length of the ray, in world units. Must be finite.
+         * @return The first solid voxel met, if any.
+         */
+        RaycastHit raycast(const ChunkManager& world, const glm::vec3& origin, const glm::vec3& direction, float maxDistance);
+
+        /**
+         * @brief Casts many rays on the calling thread.
+         *
+         * Chunk lookups are cached across rays, so batches of rays crossing the same area, such as line-of-sight
+         * queries between nearby entities, are cheaper than separate calls.
+         *
+         * @param world The chunks to cast through. Must not be modified during the call.
+         * @param rays The rays to cast.
+         * @param count The number of rays.
+         * @param hits Receives the result of each ray, at the same index.
+         */
+        void raycast(const ChunkManager& world, const Ray* rays, size_t count, RaycastHit* hits);
+
+        /**
+         * @brief Casts many rays on a job system.
+         * @param jobs The job system.
+         * @param world The chunks to cast through. Must not be modified until the handle completes.
+         * @param rays The rays to cast. Must stay alive until the handle completes.
+         * @param count The number of rays.
+         * @param hits Receives the result of each ray, at the same index. Must stay alive until the handle completes.
+         * @return A handle completing once every ray is cast.
+         */
+        Gem::Core::JobHandle raycast(Gem::Core::JobSystem& jobs, const ChunkManager& world, const Ray* rays, size_t count, RaycastHit* hits);
+
+    } // namespace Voxel
+} // namespace Gem
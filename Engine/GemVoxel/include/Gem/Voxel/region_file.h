@@ -0,0 +1,195 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <shared_mutex>
+#include <vector>
+
+#include <Gem/Voxel/chunk.h>
+#include <Gem/Voxel/chunk_coord.h>
+
+/**
+ * @file region_file.h
+ * @brief Declaration of the RegionFile class.
+ */
+
+namespace Gem {
+    namespace Voxel {
+
+        /**
+         * @struct RegionFileStats
+         * @brief Space usage of a RegionFile.
+         */
+        struct RegionFileStats {
+            size_t chunkCount = 0;      ///< Chunks stored in the file.
+            uint64_t fileSize = 0;      ///< Bytes in use, header included. The file on disk may be longer.
+            uint64_t liveBytes = 0;     ///< Bytes of the payloads referenced by the offset table.
+            uint64_t deadBytes = 0;     ///< Bytes of the payloads replaced since the last compaction.
+        };
+
+        /**
+         * @class RegionFile
+         * @brief Stores the chunks of a LENGTH^3 block of chunks in a single file.
+         *
+         * The file starts with a header and an offset table holding, for every chunk of the region,
+         * the location, size and checksum of its ChunkSerializer payload. Payloads follow the table.
+         *
+         * Writes are append-only: a new payload is written after the last one, then its table entry
+         * is updated, so an interrupted write leaves the previous payload in place. Replaced payloads are
+         * left behind as dead bytes until compact() rewrites the file.
+         *
+         * Reads go through a shared memory mapping of the file and decode the payload straight out of it.
+         * The file is grown ahead of the payloads in large steps and mapped whole, so payloads appended
+         * inside it are readable without mapping it again; it is only mapped again when a read reaches a
+         * payload past the end of the mapping, once per step. Unused bytes past the last payload are
+         * zero, and are reused by the next write after the file is opened again.
+         *
+         * read() and getStats() may be called from any thread. write() and compact() may run concurrently
+         * with reads, but only from one thread at a time.
+         */
+        class RegionFile {
+        public:
+            static constexpr uint32_t LENGTH_BITS = 4;
+            static constexpr uint32_t LENGTH = 1u << LENGTH_BITS;               ///< Chunks per axis.
+            static constexpr uint32_t CHUNK_COUNT = LENGTH * LENGTH * LENGTH;   ///< Chunks per region.
+
+            /**
+             * @brief Opens a region file, creating it if it does not exist.
+             * @param path The file path.
+             * @throws std::runtime_error if the file cannot be created, opened or mapped, or is not a region file.
+             */
+            explicit RegionFile(std::filesystem::path path);
+            ~RegionFile();
+
+            RegionFile(const RegionFile&) = delete;
+            RegionFile& operator=(const RegionFile&) = delete;
+
+            /**
+             * @brief Gets the region containing a chunk.
+             * @param chunk The chunk coordinate.
+             * @return The region coordinate, in region units.
+             */
+            [[nodiscard]] static ChunkCoord getRegion(const ChunkCoord& chunk) noexcept;
+
+            /**
+             * @brief Gets the offset table slot of a chunk within its region.
+             * @param chunk The chunk coordinate.
+             * @return The slot, lower than CHUNK_COUNT.
+             */
+            [[nodiscard]] static uint32_t getSlot(const ChunkCoord& chunk) noexcept;
+
+            /**
+             * @brief Checks whether the file holds a chunk.
+             * @param chunk The chunk coordinate, which must lie in this region.
+             * @return True if the chunk was written.
+             */
+            [[nodiscard]] bool contains(const ChunkCoord& chunk) const;
+
+            /**
+             * @brief Restores a chunk from the file.
+             * @param coord The chunk coordinate, which must lie in this region.
+             * @param chunk The chunk to fill. Left untouched if nothing valid is stored.
+             * @return True if the chunk was restored.
+             */
+            bool read(const ChunkCoord& coord, Chunk& chunk) const;
+
+            /**
+             * @brief Appends the payload of a chunk and points the offset table to it.
+             * @param coord The chunk coordinate, which must lie in this region.
+             * @param payload The payload, see ChunkSerializer::encode().
+             * @return True if the payload was written.
+             */
+            bool write(const ChunkCoord& coord, const std::vector<uint8_t>& payload);
+
+            /**
+             * @brief Rewrites the file without its dead bytes.
+             * @return True if the file was compacted.
+             */
+            bool compact();
+
+            /**
+             * @brief Checks whether enough space is wasted for compact() to be worth it.
+             * @return True if the dead bytes exceed both the live bytes and a minimum size.
+             */
+            [[nodiscard]] bool needsCompaction() const;
+
+            /**
+             * @brief Gets the space usage of the file.
+             * @return The current statistics.
+             */
+            [[nodiscard]] RegionFileStats getStats() const;
+
+            /**
+             * @brief Gets the path of the file.
+             * @return The path given at construction.
+             */
+            [[nodiscard]] const std::filesystem::path& getPath() const noexcept;
+
+        private:
+
+            /**
+             * @brief Location of a payload in the file, as stored in the offset table.
+             */
+            struct Entry {
+                uint64_t offset = 0;    ///< First byte of the payload.
+                uint32_t size = 0;      ///< Payload size in bytes, 0 if the chunk was never written.
+                uint32_t checksum = 0;  ///< FNV-1a hash of the payload.
+            };
+
+            static_assert(sizeof(Entry) == 16, "Offset table entries are 16 bytes on disk.");
+
+            /**
+             * @brief Read-only memory mapping of a whole file.
+             */
+            class Mapping;
+
+            /**
+             * @brief Opens the file, reads its offset table and maps it.
+             * @return True on success.
+             */
+            bool open();
+
+            /**
+             * @brief Maps the file again so payloads appended past the mapping become readable.
+             *
+             * Readers must be excluded. On failure the mapping is dropped, and reads fail until a later
+             * call succeeds.
+             *
+             * @return True on success.
+             */
+            bool remap() const;
+
+            /**
+             * @brief Checks whether the mapping covers a range of the file.
+             * @param end The first byte past the range.
+             */
+            [[nodiscard]] bool isMapped(uint64_t end) const noexcept;
+
+            /**
+             * @brief Writes a new file holding only a header and an empty offset table.
+             */
+            static bool create(const std::filesystem::path& path);
+
+            /**
+             * @brief Hashes a payload.
+             */
+            [[nodiscard]] static uint32_t checksum(const uint8_t* data, size_t size) noexcept;
+
+        private:
+            std::filesystem::path path_;                ///< File path.
+            std::fstream stream_;                       ///< Write handle.
+            mutable std::unique_ptr<Mapping> mapping_;  ///< Read view of the file, replaced by readers past its end.
+
+            std::vector<Entry> entries_;                ///< Offset table, one entry per slot.
+            uint64_t fileSize_ = 0;                     ///< Bytes in use, where the next payload goes.
+            uint64_t capacity_ = 0;                     ///< Bytes on disk, at least fileSize_.
+            uint64_t liveBytes_ = 0;                    ///< Bytes referenced by the offset table.
+            uint64_t deadBytes_ = 0;                    ///< Bytes of replaced payloads.
+
+            mutable std::shared_mutex mutex_;           ///< Shared by readers, exclusive while the table or the mapping change.
+        };
+
+    } // namespace Voxel
+} // namespace Gem
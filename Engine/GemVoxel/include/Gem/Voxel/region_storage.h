@@ -0,0 +1,157 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <Gem/Voxel/chunk.h>
+#include <Gem/Voxel/chunk_coord.h>
+#include <Gem/Voxel/region_file.h>
+
+/**
+ * @file region_storage.h
+ * @brief Declaration of the RegionStorage class.
+ */
+
+namespace Gem {
+    namespace Voxel {
+
+        /**
+         * @struct RegionStorageStats
+         * @brief Counters describing the activity of a RegionStorage.
+         */
+        struct RegionStorageStats {
+            size_t openRegions = 0;         ///< Region files currently open.
+            size_t pendingWrites = 0;       ///< Chunks saved but not written yet.
+            size_t totalReads = 0;          ///< Chunks restored since creation.
+            size_t totalWrites = 0;         ///< Chunks written since creation.
+            size_t totalCompactions = 0;    ///< Region files compacted since creation.
+        };
+
+        /**
+         * @class RegionStorage
+         * @brief Persists chunks in a directory of RegionFile.
+         *
+         * save() only queues a snapshot of the chunk; a background thread serialises it, appends the
+         * payloads to the region files and compacts them once they hold too many dead bytes, so neither
+         * encoding nor a slow disk stalls the caller. load() sees queued chunks before they reach the disk.
+         *
+         * A bounded number of region files is kept open, the least recently opened ones are closed first.
+         */
+        class RegionStorage {
+        public:
+            /**
+             * @brief Opens a storage directory, creating it if needed, and starts the writer thread.
+             * @param directory The directory holding the region files.
+             * @param maxOpenRegions The number of region files kept open.
+             * @throws std::filesystem::filesystem_error if the directory cannot be created.
+             */
+            explicit RegionStorage(std::filesystem::path directory, size_t maxOpenRegions = 16);
+
+            /**
+             * @brief Writes every queued chunk, then stops the writer thread.
+             */
+            ~RegionStorage();
+
+            RegionStorage(const RegionStorage&) = delete;
+            RegionStorage& operator=(const RegionStorage&) = delete;
+
+            /**
+             * @brief Restores a saved chunk.
+             * @param coord The chunk coordinate.
+             * @param chunk The chunk to fill. Left untouched if the chunk was never saved.
+             * @return True if the chunk was restored.
+             */
+            bool load(const ChunkCoord& coord, Chunk& chunk);
+
+            /**
+             * @brief Queues a chunk to be written by the writer thread.
+             *
+             * Only a copy-on-write snapshot of the chunk is taken, see Chunk::snapshot(), so it may be modified
+             * or released as soon as this returns. Saving a chunk again before it is written replaces the
+             * queued snapshot.
+             *
+             * Must be called on the thread editing the chunk.
+             *
+             * @param coord The chunk coordinate.
+             * @param chunk The chunk to save.
+             */
+            void save(const ChunkCoord& coord, const Chunk& chunk);
+
+            /**
+             * @brief Blocks until every queued chunk is written.
+             */
+            void flush();
+
+            /**
+             * @brief Gets the storage counters.
+             * @return The current statistics.
+             */
+            [[nodiscard]] RegionStorageStats getStats() const;
+
+            /**
+             * @brief Gets the directory holding the region files.
+             * @return The directory given at construction.
+             */
+            [[nodiscard]] const std::filesystem::path& getDirectory() const noexcept;
+
+        private:
+
+            /**
+             * @brief A chunk snapshot waiting for the writer thread.
+             */
+            struct PendingWrite {
+                std::shared_ptr<const Chunk> chunk; ///< The chunk as it was saved.
+                uint64_t sequence = 0;              ///< Changes every time the chunk is saved again.
+            };
+
+            /**
+             * @brief Gets an open region file.
+             * @param region The region coordinate.
+             * @param create Whether to create the file if it does not exist.
+             * @return The region file, or nullptr if it does not exist or cannot be opened.
+             */
+            std::shared_ptr<RegionFile> getRegion(const ChunkCoord& region, bool create);
+
+            /**
+             * @brief Closes the oldest region files no one is using, down to the limit.
+             */
+            void closeRegions();
+
+            /**
+             * @brief Writes queued chunks until the storage is destroyed.
+             */
+            void writerLoop();
+
+        private:
+            std::filesystem::path directory_;   ///< Directory holding the region files.
+            size_t maxOpenRegions_;             ///< Region files kept open.
+
+            mutable std::mutex regionsMutex_;   ///< Protects the open regions.
+            std::unordered_map<ChunkCoord, std::shared_ptr<RegionFile>, ChunkCoordHash> regions_;   ///< Open region files, nullptr for missing ones.
+            std::deque<ChunkCoord> regionOrder_;    ///< Open regions, oldest first.
+
+            mutable std::mutex queueMutex_;     ///< Protects the pending writes.
+            std::condition_variable queueCondition_;    ///< Wakes the writer thread.
+            std::condition_variable idleCondition_;     ///< Signals flush() once the queue is empty.
+            std::unordered_map<ChunkCoord, PendingWrite, ChunkCoordHash> pending_;  ///< Chunks waiting to be written.
+            std::deque<ChunkCoord> queue_;      ///< Pending chunks in save order.
+            uint64_t nextSequence_ = 0;         ///< Source of PendingWrite::sequence.
+            bool running_ = true;               ///< Cleared to stop the writer thread.
+
+            std::atomic<size_t> totalReads_{ 0 };       ///< Chunks restored since creation.
+            std::atomic<size_t> totalWrites_{ 0 };      ///< Chunks written since creation.
+            std::atomic<size_t> totalCompactions_{ 0 }; ///< Regions compacted since creation.
+
+            std::thread writer_;                ///< Writes the pending chunks.
+        };
+
+    } // namespace Voxel
+} // namespace Gem
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * @file shared_pages.h
+ * @brief Declaration of the SharedPages class template.
+ */
+
+namespace Gem {
+    namespace Voxel {
+
+        /**
+         * @class SharedPages
+         * @brief An array split into fixed-size, reference-counted pages shared between copies.
+         *
+         * Copying only copies the page pointers, so the copy costs a few atomic increments whatever the
+         * array length. A page is cloned the first time it is written while another copy still holds it,
+         * so a writer only pays for the pages it modifies and readers of a copy never see the changes.
+         *
+         * Copies may be read and destroyed on any thread, but a given instance must only be written by
+         * one thread, and copies of it taken on that thread.
+         *
+         * @tparam T The element type. Must be trivially copyable.
+         */
+        template<typename T>
+        class SharedPages {
+        public:
+            SharedPages() = default;
+
+            /**
+             * @brief Replaces the content with pages all holding the same value.
+             *
+             * Every page shares a single allocation until it is written.
+             *
+             * @param pageCount The number of pages.
+             * @param pageLength The number of elements per page.
+             * @param value The value of every element.
+             */
+            void assign(size_t pageCount, size_t pageLength, const T& value) {
+                pageLength_ = pageLength;
+                pages_.assign(pageCount, (pageCount > 0) ? std::make_shared<T[]>(pageLength, value) : nullptr);
+            }
+
+            /**
+             * @brief Replaces the content with a copy of an array, cut into pages.
+             * @param data The elements.
+             * @param count The number of elements. The last page is padded with T() if needed.
+             * @param pageLength The number of elements per page.
+             */
+            void assign(const T* data, size_t count, size_t pageLength) {
+                pageLength_ = pageLength;
+                pages_.resize((pageLength > 0) ? (count + pageLength - 1) / pageLength : 0);
+
+                for (size_t page = 0; page < pages_.size(); ++page) {
+                    const size_t first = page * pageLength;
+                    const size_t length = std::min(pageLength, count - first);
+
+                    pages_[page] = std::make_shared<T[]>(pageLength);
+                    std::copy_n(data + first, length, pages_[page].get());
+                }
+            }
+
+            /**
+             * @brief Releases every page.
+             */
+            void clear() noexcept {
+                pages_.clear();
+                pages_.shrink_to_fit();
+                pageLength_ = 0;
+            }
+
+            /**
+             * @brief Gets a page for reading.
+             * @param page The page index, lower than getPageCount().
+             * @return getPageLength() elements.
+             */
+            [[nodiscard]] const T* getPage(size_t page) const noexcept {
+                return pages_[page].get();
+            }
+
+            /**
+             * @brief Gets a page for writing, cloning it first if another copy shares it.
+             * @param page The page index, lower than getPageCount().
+             * @return getPageLength() elements, owned by this instance only.
+             */
+            [[nodiscard]] T* getMutablePage(size_t page) {
+                std::shared_ptr<T[]>& slot = pages_[page];
+
+                if (slot.use_count() != 1) {
+                    std::shared_ptr<T[]> copy = std::make_shared<T[]>(pageLength_);
+                    std::copy_n(slot.get(), pageLength_, copy.get());
+                    slot = std::move(copy);
+                }
+                else {
+                    // Copies released on other threads are done reading the page before it is written
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                }
+
+                return slot.get();
+            }
+
+            /**
+             * @brief Checks whether a page is also held by another copy, so writing it would clone it.
+             * @param page The page index, lower than getPageCount().
+             */
+            [[nodiscard]] bool isShared(size_t page) const noexcept {
+                return pages_[page].use_count() > 1;
+            }
+
+            /**
+             * @brief Gets the number of pages.
+             */
+            [[nodiscard]] size_t getPageCount() const noexcept { return pages_.size(); }
+
+            /**
+             * @brief Gets the number of elements per page.
+             */
+            [[nodiscard]] size_t getPageLength() const noexcept { return pageLength_; }
+
+            /**
+             * @brief Estimates the heap memory referenced by the pages.
+             * @return The number of bytes, shared pages counted in full by every copy.
+             */
+            [[nodiscard]] size_t getMemoryUsage() const noexcept {
+                return pages_.capacity() * sizeof(std::shared_ptr<T[]>) + pages_.size() * pageLength_ * sizeof(T);
+            }
+
+        private:
+            std::vector<std::shared_ptr<T[]>> pages_;   ///< Page pointers, possibly shared with other copies.
+            size_t pageLength_ = 0;                     ///< Elements per page.
+        };
+
+    } // namespace Voxel
+} // namespace Gem
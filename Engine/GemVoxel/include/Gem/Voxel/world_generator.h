@@ -0,0 +1,205 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <Gem/Core/job_system.h>
+#include <Gem/Math/noise.h>
+#include <Gem/Voxel/chunk.h>
+#include <Gem/Voxel/chunk_coord.h>
+
+/**
+ * @file world_generator.h
+ * @brief Declaration of the WorldGenerator class.
+ */
+
+namespace Gem {
+    namespace Voxel {
+
+        /**
+         * @brief Climate zones, chosen per column.
+         */
+        enum class Biome : uint8_t {
+            Plains,
+            Forest,
+            Desert,
+            Mountains
+        };
+
+        /**
+         * @struct WorldBlocks
+         * @brief The voxels placed by the WorldGenerator.
+         *
+         * The defaults are the IDs given by BlockRegistry::createDefault().
+         */
+        struct WorldBlocks {
+            Voxel stone = Voxel(3);     ///< Bulk of the terrain.
+            Voxel dirt = Voxel(1);      ///< Layers under grass.
+            Voxel grass = Voxel(2);     ///< Surface of plains and forests.
+            Voxel sand = Voxel(4);      ///< Surface of deserts.
+            Voxel log = Voxel(5);       ///< Tree trunks.
+            Voxel leaves = Voxel(6);    ///< Tree canopies.
+        };
+
+        /**
+         * @struct ColumnData
+         * @brief Per-column data shared by every chunk of a vertical stack.
+         */
+        struct ColumnData {
+            static constexpr uint32_t AREA = Chunk::getArea();
+
+            std::array<int32_t, AREA> heights;  ///< World height of the surface voxel, indexed x + z * length.
+            std::array<Biome, AREA> biomes;     ///< Biome of each column, indexed x + z * length.
+            int32_t minHeight = 0;              ///< Lowest surface in the stack.
+            int32_t maxHeight = 0;              ///< Highest surface in the stack.
+        };
+
+        /**
+         * @class WorldGenerator
+         * @brief Fills chunks with terrain from a seed.
+         *
+         * Generation runs in stages:
+         * 1. Columns: heightmap and biome of each chunk column, cached so stacked chunks share them.
+         * 2. Terrain: solid ground below the heightmap, carved by 3D cave noise.
+         * 3. Surface: grass, dirt and sand layers depending on the biome.
+         * 4. Features: trees, which may cross chunk borders.
+         *
+         * Every stage is a pure function of the seed and the chunk coordinate; trees are anchored on
+         * hashed world columns and every chunk they overlap places its own part of them. The output is
+         * therefore identical whatever the order, the batch or the number of threads used.
+         *
+         * All functions are thread-safe.
+         */
+        class WorldGenerator {
+        public:
+            using ChunkBatch = std::vector<std::pair<ChunkCoord, Chunk*>>;
+
+            /**
+             * @brief Constructs a generator.
+             * @param seed The world seed.
+             * @param blocks The voxels to place.
+             */
+            explicit WorldGenerator(uint32_t seed, const WorldBlocks& blocks = WorldBlocks());
+
+            /**
+             * @brief Runs every stage for one chunk on the calling thread.
+             *
+             * Matches the signature of ChunkManager::setGenerator().
+             *
+             * @param coord The chunk coordinate.
+             * @param chunk The chunk to fill. Previous content is discarded.
+             */
+            void generate(const ChunkCoord& coord, Chunk& chunk) const;
+
+            /**
+             * @brief Schedules every stage for a batch of chunks on a job system.
+             *
+             * Columns are computed once per distinct column, then each stage runs over all chunks in parallel.
+             *
+             * @param jobs The job system.
+             * @param chunks The chunks to fill. Must stay alive until the handle completes.
+             * @return A handle completing once every chunk is filled.
+             */
+            Gem::Core::JobHandle generate(Gem::Core::JobSystem& jobs, const ChunkBatch& chunks) const;
+
+            /**
+             * @brief Stage 1: gets the column data of a chunk stack, computing it if not cached.
+             * @param x The chunk x-coordinate.
+             * @param z The chunk z-coordinate.
+             * @return The column data.
+             */
+            std::shared_ptr<const ColumnData> getColumn(int32_t x, int32_t z) const;
+
+            /**
+             * @brief Stage 2: fills a chunk with stone below the surface, minus caves.
+             * @param coord The chunk coordinate.
+             * @param chunk The chunk to fill. Previous content is discarded.
+             */
+            void generateTerrain(const ChunkCoord& coord, Chunk& chunk) const;
+
+            /**
+             * @brief Stage 3: covers the terrain of a chunk with biome-specific layers.
+             * @param coord The chunk coordinate.
+             * @param chunk The chunk, filled by generateTerrain().
+             */
+            void decorateSurface(const ChunkCoord& coord, Chunk& chunk) const;
+
+            /**
+             * @brief Stage 4: places the parts of trees overlapping a chunk.
+             * @param coord The chunk coordinate.
+             * @param chunk The chunk, filled by decorateSurface().
+             */
+            void placeFeatures(const ChunkCoord& coord, Chunk& chunk) const;
+
+            /**
+             * @brief Sets the maximum number of cached columns.
+             * @param capacity The number of columns kept. The oldest ones are evicted first.
+             */
+            void setColumnCacheCapacity(size_t capacity);
+
+            /**
+             * @brief Gets the seed.
+             * @return The world seed.
+             */
+            [[nodiscard]] uint32_t getSeed() const noexcept;
+
+        private:
+
+            /**
+             * @brief A tree anchored on a world column.
+             */
+            struct Tree {
+                glm::ivec3 base;        ///< World voxel of the lowest log.
+                int32_t trunkHeight;    ///< Number of log voxels.
+            };
+
+            /**
+             * @brief Computes the column data of a chunk stack.
+             */
+            [[nodiscard]] std::shared_ptr<ColumnData> computeColumn(int32_t x, int32_t z) const;
+
+            /**
+             * @brief Computes the surface height and biome of world columns.
+             */
+            void computeSurface(const glm::ivec2& origin, ColumnData& column) const;
+
+            /**
+             * @brief Gets the surface height and biome of any world column, through the column cache.
+             */
+            std::pair<int32_t, Biome> getSurface(int32_t x, int32_t z) const;
+
+            /**
+             * @brief Finds the trees that may overlap a box of world columns.
+             */
+            void findTrees(const glm::ivec2& min, const glm::ivec2& max, std::vector<Tree>& trees) const;
+
+            /**
+             * @brief Hashes a world position with the seed.
+             */
+            [[nodiscard]] uint32_t hash(int32_t x, int32_t y, int32_t z) const noexcept;
+
+        private:
+            uint32_t seed_;                     ///< World seed.
+            WorldBlocks blocks_;                ///< Voxels to place.
+
+            Gem::Math::Noise heightNoise_;      ///< Rolling hills.
+            Gem::Math::Noise mountainNoise_;    ///< Where mountains rise.
+            Gem::Math::Noise temperatureNoise_; ///< Biome selection.
+            Gem::Math::Noise moistureNoise_;    ///< Biome selection.
+            Gem::Math::Noise caveNoise_;        ///< Cave carving, first axis.
+            Gem::Math::Noise tunnelNoise_;      ///< Cave carving, second axis.
+
+            mutable std::mutex columnsMutex_;   ///< Protects the column cache.
+            mutable std::unordered_map<uint64_t, std::shared_ptr<const ColumnData>> columns_;   ///< Cached columns.
+            mutable std::deque<uint64_t> columnOrder_;  ///< Cached columns, oldest first.
+            size_t columnCapacity_ = 4096;      ///< Maximum number of cached columns.
+        };
+
+    } // namespace Voxel
+} // namespace Gem
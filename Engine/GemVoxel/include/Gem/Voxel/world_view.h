@@ -0,0 +1,187 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include <Gem/Voxel/chunk.h>
+#include <Gem/Voxel/chunk_coord.h>
+#include <Gem/Voxel/chunk_manager.h>
+
+/**
+ * @file world_view.h
+ * @brief Declaration of the WorldView class reading voxels across chunk borders.
+ */
+
+namespace Gem {
+    namespace Voxel {
+
+        /**
+         * @class WorldView
+         * @brief Reads the voxels of a ChunkManager by world coordinates, caching the chunks it went through.
+         *
+         * World coordinates are split into a chunk and a local index with shifts and masks. Chunks are
+         * cached in a window of 4x4x4 slots indexed by the low two bits of each chunk coordinate, so any
+         * 4x4x4 block of chunks, and in particular the 3x3x3 chunks around any chunk, is held at once
+         * whatever its position, and a walk keeps the chunks it still overlaps. A chunk is only looked up
+         * in the ChunkManager the first time it is read, so walking across chunk borders costs about as
+         * much as walking inside a chunk.
+         *
+         * Unloaded chunks are remembered too, as nullptr. The view is meant to live for the duration of
+         * a pass over the world, such as a light update, a fluid tick or a move: it must not be used
+         * across ChunkManager::update() or clear(), or invalidate() must be called after them.
+         *
+         * A view only reads. It is not thread-safe, but each thread may use its own view while nothing
+         * edits the world.
+         */
+        class WorldView {
+        public:
+            static constexpr int32_t WINDOW_LENGTH = 4;     ///< Chunks cached along each axis, a power of two.
+            static constexpr size_t WINDOW_SIZE = size_t(WINDOW_LENGTH) * WINDOW_LENGTH * WINDOW_LENGTH;
+
+            /**
+             * @brief Constructs a view of a world.
+             * @param world The chunks to read. Must outlive the view.
+             */
+            explicit WorldView(const ChunkManager& world) noexcept;
+
+            /**
+             * @brief Forgets every cached chunk, after chunks were loaded or unloaded.
+             */
+            void invalidate() noexcept {
+                resolved_ = 0;
+            }
+
+            /**
+             * @brief Gets a resident chunk through the window.
+             * @param coord The chunk coordinate.
+             * @return Pointer to the chunk, or nullptr if it is not loaded.
+             */
+            [[nodiscard]] Chunk* getChunk(const ChunkCoord& coord) {
+                const uint32_t slot = static_cast<uint32_t>((coord.x & WINDOW_MASK)
+                    | ((coord.y & WINDOW_MASK) << WINDOW_SHIFT)
+                    | ((coord.z & WINDOW_MASK) << (2 * WINDOW_SHIFT)));
+
+                const Slot& entry = slots_[slot];
+                if (!((resolved_ >> slot) & 1) || entry.x != coord.x || entry.y != coord.y || entry.z != coord.z) {
+                    return resolve(slot, coord);
+                }
+                return entry.chunk;
+            }
+
+            /**
+             * @brief Retrieves a voxel by world coordinates.
+             * @param voxel The world voxel coordinates.
+             * @return The voxel, or air if its chunk is not loaded.
+             */
+            [[nodiscard]] Voxel getVoxel(const glm::ivec3& voxel) {
+                const Chunk* chunk = getChunk(toChunk(voxel));
+                return chunk ? chunk->getStorage().get(toIndex(voxel)) : Voxel();
+            }
+
+            /**
+             * @brief Retrieves the light level of a voxel by world coordinates.
+             * @param type The light channel.
+             * @param voxel The world voxel coordinates.
+             * @return The light level, full sky light and no block light if its chunk is not loaded.
+             */
+            [[nodiscard]] uint8_t getLight(LightType type, const glm::ivec3& voxel) {
+                const Chunk* chunk = getChunk(toChunk(voxel));
+                if (!chunk) {
+                    return (type == LightType::Sky) ? MAX_LIGHT : 0;
+                }
+                return chunk->getLightStorage(type).get(toIndex(voxel));
+            }
+
+            /**
+             * @brief Checks whether a voxel is solid.
+             * @param voxel The world voxel coordinates.
+             * @return True if the voxel is not air, false if it is air or its chunk is not loaded.
+             */
+            [[nodiscard]] bool isSolid(const glm::ivec3& voxel) {
+                const Chunk* chunk = getChunk(toChunk(voxel));
+                return chunk && chunk->getOccupancy().test(
+                    static_cast<uint32_t>(voxel.x & MASK), static_cast<uint32_t>(voxel.y & MASK), static_cast<uint32_t>(voxel.z & MASK));
+            }
+
+            /**
+             * @brief Checks whether the chunk holding a voxel is loaded.
+             * @param voxel The world voxel coordinates.
+             */
+            [[nodiscard]] bool isLoaded(const glm::ivec3& voxel) {
+                return getChunk(toChunk(voxel)) != nullptr;
+            }
+
+            /**
+             * @brief Retrieves many voxels by world coordinates.
+             *
+             * Consecutive voxels of the same chunk reuse its pointer without going through the window,
+             * so lists ordered along space, such as a path or the cells of a region, read at in-chunk cost.
+             *
+             * @param voxels The world voxel coordinates.
+             * @param count The number of voxels.
+             * @param out Receives each voxel at the same index, air for voxels of unloaded chunks.
+             */
+            void getVoxels(const glm::ivec3* voxels, size_t count, Voxel* out);
+
+            /**
+             * @brief Gets the number of lookups made in the ChunkManager, to measure how well the window works.
+             * @return The lookups since construction.
+             */
+            [[nodiscard]] size_t getLookupCount() const noexcept { return lookups_; }
+
+            /**
+             * @brief Gets the chunk holding a voxel.
+             * @param voxel The world voxel coordinates.
+             * @return The chunk coordinate.
+             */
+            static constexpr ChunkCoord toChunk(const glm::ivec3& voxel) noexcept {
+                return { voxel.x >> SHIFT, voxel.y >> SHIFT, voxel.z >> SHIFT };
+            }
+
+            /**
+             * @brief Gets the storage index of a voxel in its chunk.
+             * @param voxel The world voxel coordinates.
+             * @return The index, see Chunk::linearizeUnchecked().
+             */
+            static constexpr size_t toIndex(const glm::ivec3& voxel) noexcept {
+                return Chunk::linearizeUnchecked(
+                    static_cast<uint32_t>(voxel.x & MASK), static_cast<uint32_t>(voxel.y & MASK), static_cast<uint32_t>(voxel.z & MASK));
+            }
+
+        private:
+            static constexpr int32_t SHIFT = 4;
+            static constexpr int32_t MASK = CHUNK_BOUNDARY - 1;
+            static constexpr int32_t WINDOW_SHIFT = 2;
+            static constexpr int32_t WINDOW_MASK = WINDOW_LENGTH - 1;
+            static_assert((1 << SHIFT) == CHUNK_BOUNDARY, "Chunk coordinates are derived with a shift.");
+            static_assert((1 << WINDOW_SHIFT) == WINDOW_LENGTH, "Window slots are derived with a shift.");
+            static_assert(WINDOW_SIZE <= 64, "The resolved slots must fit a 64-bit mask.");
+
+            /**
+             * @brief A cached chunk lookup, only valid once its bit of resolved_ is set.
+             *
+             * Left uninitialised so views are cheap to create for a single query.
+             */
+            struct Slot {
+                int32_t x;
+                int32_t y;
+                int32_t z;
+                Chunk* chunk;   ///< nullptr when the chunk is not loaded.
+            };
+
+            /**
+             * @brief Looks a chunk up in the ChunkManager and caches it in its slot.
+             */
+            Chunk* resolve(uint32_t slot, const ChunkCoord& coord);
+
+        private:
+            const ChunkManager& world_;                     ///< Chunks to read.
+            uint64_t resolved_ = 0;                         ///< One bit per slot holding a lookup.
+            std::array<Slot, WINDOW_SIZE> slots_;           ///< Cached lookups, x first.
+            size_t lookups_ = 0;                            ///< Lookups made in the ChunkManager.
+        };
+
+    } // namespace Voxel
+} // namespace Gem
@@ -0,0 +1,216 @@
+#include <Gem/Voxel/block_registry.h>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace Gem {
+    namespace Voxel {
+
+        BlockDefinition BlockDefinition::cube(std::string name, const std::string& texture) {
+            BlockDefinition definition;
+            definition.name = std::move(name);
+            definition.textures.fill(texture);
+            return definition;
+        }
+
+        BlockDefinition BlockDefinition::column(std::string name, const std::string& side, const std::string& top, const std::string& bottom) {
+            BlockDefinition definition = cube(std::move(name), side);
+            definition.textures[static_cast<size_t>(Face::PosY)] = top;
+            definition.textures[static_cast<size_t>(Face::NegY)] = bottom;
+            return definition;
+        }
+
+        BlockRegistry::BlockRegistry() {
+            // Air has no texture, its faces are never drawn
+            names_.push_back("air");
+            ids_.emplace("air", AIR);
+            solid_.push_back(0);
+            opaque_.push_back(0);
+            emission_.push_back(0);
+            faceLayers_.resize(FACE_COUNT, 0);
+            fullCube_.push_back(0);
+            occlusion_.resize(FACE_COUNT, 0);
+            shapes_.emplace_back();
+            fluid_.push_back(0);
+            fluidLevel_.push_back(0);
+            fluidDecay_.push_back(0);
+            fluidInterval_.push_back(0);
+        }
+
+        BlockRegistry BlockRegistry::createDefault() {
+            BlockRegistry registry;
+
+            // Keep this order, saved chunks and WorldBlocks use these IDs
+            registry.add(BlockDefinition::cube("dirt", "dirt.png"));
+            registry.add(BlockDefinition::column("grass", "grass_side.png", "grass.png", "dirt.png"));
+            registry.add(BlockDefinition::cube("stone", "stone.png"));
+            registry.add(BlockDefinition::cube("sand", "sand.png"));
+            registry.add(BlockDefinition::column("log", "log_side.png", "log_top.png", "log_top.png"));
+
+            // Leaves are see-through, so they hide nothing behind them
+            BlockDefinition leaves = BlockDefinition::cube("leaves", "leaves.png");
+            leaves.opaque = false;
+            leaves.shape = BlockShape::cube(false);
+            registry.add(leaves);
+
+            registry.add(BlockDefinition::cube("planks", "planks.png"));
+            registry.add(BlockDefinition::cube("cobblestone", "cobblestone.png"));
+
+            for (const char* material : { "planks", "cobblestone" }) {
+                BlockDefinition slab = BlockDefinition::cube(std::string(material) + "_slab", std::string(material) + ".png");
+                slab.shape = BlockShape::slab(false);
+                registry.add(slab);
+            }
+
+            const std::pair<const char*, Face> facings[] = {
+                { "east", Face::PosX }, { "west", Face::NegX }, { "south", Face::PosZ }, { "north", Face::NegZ }
+            };
+            for (const auto& [name, face] : facings) {
+                BlockDefinition stairs = BlockDefinition::cube(std::string("planks_stairs_") + name, "planks.png");
+                stairs.shape = BlockShape::stairs(face);
+                registry.add(stairs);
+            }
+
+            FluidDefinition water;
+            water.name = "water";
+            water.texture = "water.png";
+            registry.addFluid(water);
+
+            FluidDefinition lava;
+            lava.name = "lava";
+            lava.texture = "lava.png";
+            lava.decay = 2;
+            lava.interval = 3;
+            lava.emission = MAX_LIGHT;
+            registry.addFluid(lava);
+
+            return registry;
+        }
+
+        uint16_t BlockRegistry::add(const BlockDefinition& definition) {
+            if (definition.name.empty()) {
+                throw std::invalid_argument("Block name is empty in BlockRegistry::add.");
+            }
+            if (ids_.count(definition.name) != 0) {
+                throw std::invalid_argument("Block name already registered in BlockRegistry::add.");
+            }
+            if (std::any_of(definition.textures.begin(), definition.textures.end(), [](const std::string& texture) { return texture.empty(); })) {
+                throw std::invalid_argument("Block face without texture in BlockRegistry::add.");
+            }
+            if (names_.size() > std::numeric_limits<uint16_t>::max()) {
+                throw std::length_error("No block ID left in BlockRegistry::add.");
+            }
+
+            return append(definition, AIR, 0, 0, 0);
+        }
+
+        uint16_t BlockRegistry::addFluid(const FluidDefinition& definition) {
+            // Source, falling, then one block per flowing level
+            std::vector<std::string> names = { definition.name, definition.name + "_falling" };
+            for (uint8_t level = 1; level < MAX_FLUID_LEVEL; ++level) {
+                names.push_back(definition.name + "_" + std::to_string(level));
+            }
+
+            if (definition.name.empty()) {
+                throw std::invalid_argument("Fluid name is empty in BlockRegistry::addFluid.");
+            }
+            if (std::any_of(names.begin(), names.end(), [this](const std::string& name) { return ids_.count(name) != 0; })) {
+                throw std::invalid_argument("Fluid name already registered in BlockRegistry::addFluid.");
+            }
+            if (definition.texture.empty()) {
+                throw std::invalid_argument("Fluid without texture in BlockRegistry::addFluid.");
+            }
+            if (definition.decay == 0 || definition.interval == 0) {
+                throw std::invalid_argument("Fluid decay and interval must be positive in BlockRegistry::addFluid.");
+            }
+            if (names_.size() + names.size() - 1 > std::numeric_limits<uint16_t>::max()) {
+                throw std::length_error("No block ID left in BlockRegistry::addFluid.");
+            }
+
+            const uint16_t fluid = static_cast<uint16_t>(names_.size());
+
+            for (size_t i = 0; i < names.size(); ++i) {
+                const uint8_t level = (i < 2) ? MAX_FLUID_LEVEL : static_cast<uint8_t>(i - 1);
+
+                // Sources and falling fluid fill the voxel so stacked fluid joins up, flowing fluid thins out
+                ShapeBox box;
+                box.max.y = (level == MAX_FLUID_LEVEL) ? SHAPE_RESOLUTION : level * SHAPE_RESOLUTION / MAX_FLUID_LEVEL;
+
+                BlockDefinition block = BlockDefinition::cube(names[i], definition.texture);
+                block.solid = false;
+                block.opaque = false;
+                block.emission = definition.emission;
+                block.shape = BlockShape::fromBoxes({ box }, false);
+
+                append(block, fluid, level, definition.decay, definition.interval);
+            }
+
+            return fluid;
+        }
+
+        uint16_t BlockRegistry::append(const BlockDefinition& definition, uint16_t fluid, uint8_t level, uint8_t decay, uint8_t interval) {
+            const uint16_t id = static_cast<uint16_t>(names_.size());
+
+            names_.push_back(definition.name);
+            ids_.emplace(definition.name, id);
+            solid_.push_back(definition.solid ? 1 : 0);
+            opaque_.push_back(definition.opaque ? 1 : 0);
+            emission_.push_back(std::min(definition.emission, MAX_LIGHT));
+
+            for (const std::string& texture : definition.textures) {
+                faceLayers_.push_back(getLayer(texture));
+            }
+
+            fullCube_.push_back(definition.shape.isFullCube() ? 1 : 0);
+            for (size_t f = 0; f < FACE_COUNT; ++f) {
+                occlusion_.push_back(definition.opaque ? definition.shape.getOcclusion(static_cast<Face>(f)) : uint16_t(0));
+            }
+            shapes_.push_back(definition.shape);
+
+            fluid_.push_back(fluid);
+            fluidLevel_.push_back(level);
+            fluidDecay_.push_back(decay);
+            fluidInterval_.push_back(interval);
+
+            return id;
+        }
+
+        uint16_t BlockRegistry::getId(const std::string& name) const {
+            auto it = ids_.find(name);
+            if (it == ids_.end()) {
+                throw std::out_of_range("Unknown block name in BlockRegistry::getId.");
+            }
+            return it->second;
+        }
+
+        Voxel BlockRegistry::getVoxel(const std::string& name) const {
+            return Voxel(getId(name));
+        }
+
+        bool BlockRegistry::contains(const std::string& name) const {
+            return ids_.count(name) != 0;
+        }
+
+        const std::string& BlockRegistry::getName(uint16_t id) const {
+            if (id >= names_.size()) {
+                throw std::out_of_range("Unknown block ID in BlockRegistry::getName.");
+            }
+            return names_[id];
+        }
+
+        uint16_t BlockRegistry::getLayer(const std::string& texture) {
+            auto it = layers_.find(texture);
+            if (it != layers_.end()) {
+                return it->second;
+            }
+
+            const uint16_t layer = static_cast<uint16_t>(textures_.size());
+            textures_.push_back(texture);
+            layers_.emplace(texture, layer);
+            return layer;
+        }
+
+    } // namespace Voxel
+} // namespace Gem
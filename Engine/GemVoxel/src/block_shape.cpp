@@ -0,0 +1,155 @@
+#include <Gem/Voxel/block_shape.h>
+#include <stdexcept>
+
+namespace Gem {
+    namespace Voxel {
+
+        namespace {
+
+            constexpr int32_t CELL = SHAPE_RESOLUTION / SHAPE_GRID;     // Shape units per mask cell
+
+            /**
+             * @brief Gets the mask cells of a rectangle on a face plane.
+             * @param touching True to set the cells the rectangle overlaps, false for those it covers entirely.
+             */
+            uint16_t getCells(const glm::ivec3& min, const glm::ivec3& max, int u, int v, bool touching) {
+                uint16_t mask = 0;
+                for (int j = 0; j < SHAPE_GRID; ++j) {
+                    for (int i = 0; i < SHAPE_GRID; ++i) {
+                        const int32_t u0 = i * CELL, u1 = u0 + CELL;
+                        const int32_t v0 = j * CELL, v1 = v0 + CELL;
+
+                        const bool set = touching
+                            ? (min[u] < u1 && max[u] > u0 && min[v] < v1 && max[v] > v0)
+                            : (min[u] <= u0 && max[u] >= u1 && min[v] <= v0 && max[v] >= v1);
+                        if (set) {
+                            mask |= static_cast<uint16_t>(1u << (i + j * SHAPE_GRID));
+                        }
+                    }
+                }
+                return mask;
+            }
+
+        } // namespace
+
+        BlockShape BlockShape::cube(bool occluding) {
+            BlockShape shape = fromBoxes({ ShapeBox() }, occluding);
+            shape.fullCube_ = true;
+            return shape;
+        }
+
+        BlockShape BlockShape::slab(bool top) {
+            const int32_t half = SHAPE_RESOLUTION / 2;
+            ShapeBox box;
+            box.min.y = top ? half : 0;
+            box.max.y = top ? SHAPE_RESOLUTION : half;
+            return fromBoxes({ box });
+        }
+
+        BlockShape BlockShape::stairs(Face facing) {
+            const int axis = static_cast<int>(facing) / 2;
+            if (axis == 1) {
+                throw std::invalid_argument("Stairs must face a horizontal direction in BlockShape::stairs.");
+            }
+
+            const int32_t half = SHAPE_RESOLUTION / 2;
+
+            ShapeBox lower;
+            lower.max.y = half;
+
+            ShapeBox step;
+            step.min.y = half;
+            if (static_cast<int>(facing) % 2 == 0) {
+                step.min[axis] = half;
+            }
+            else {
+                step.max[axis] = half;
+            }
+
+            return fromBoxes({ lower, step });
+        }
+
+        BlockShape BlockShape::cross() {
+            BlockShape shape;
+
+            // Both diagonals, each seen from both sides
+            const glm::ivec3 origins[2] = { glm::ivec3(0, 0, 0), glm::ivec3(0, 0, SHAPE_RESOLUTION) };
+            const glm::ivec3 directions[2] = { glm::ivec3(SHAPE_RESOLUTION, 0, SHAPE_RESOLUTION), glm::ivec3(SHAPE_RESOLUTION, 0, -SHAPE_RESOLUTION) };
+
+            for (int diagonal = 0; diagonal < 2; ++diagonal) {
+                for (int side = 0; side < 2; ++side) {
+                    ShapeQuad quad;
+                    quad.origin = origins[diagonal];
+                    quad.du = directions[diagonal];
+                    quad.dv = glm::ivec3(0, SHAPE_RESOLUTION, 0);
+                    quad.axis = 2;
+                    quad.backFace = side == 1;
+                    shape.quads_.push_back(quad);
+                }
+            }
+
+            return shape;
+        }
+
+        BlockShape BlockShape::fromBoxes(const std::vector<ShapeBox>& boxes, bool occluding) {
+            for (const ShapeBox& box : boxes) {
+                if (glm::any(glm::lessThan(box.min, glm::ivec3(0))) || glm::any(glm::greaterThan(box.max, glm::ivec3(SHAPE_RESOLUTION)))
+                    || glm::any(glm::greaterThanEqual(box.min, box.max))) {
+                    throw std::invalid_argument("Box out of the voxel or empty in BlockShape::fromBoxes.");
+                }
+            }
+
+            BlockShape shape;
+            shape.boxes_ = boxes;
+
+            for (size_t a = 0; a < boxes.size(); ++a) {
+                const ShapeBox& box = boxes[a];
+
+                for (int d = 0; d < 3; ++d) {
+                    const int u = (d + 1) % 3;
+                    const int v = (d + 2) % 3;
+
+                    for (int side = 0; side < 2; ++side) {
+                        const bool backFace = side == 1;
+                        const int32_t plane = backFace ? box.min[d] : box.max[d];
+
+                        // Drop the face if another box lies against it and covers it entirely
+                        bool hidden = false;
+                        for (size_t b = 0; b < boxes.size() && !hidden; ++b) {
+                            const ShapeBox& other = boxes[b];
+                            hidden = b != a
+                                && (backFace ? other.max[d] : other.min[d]) == plane
+                                && other.min[u] <= box.min[u] && other.max[u] >= box.max[u]
+                                && other.min[v] <= box.min[v] && other.max[v] >= box.max[v];
+                        }
+                        if (hidden) {
+                            continue;
+                        }
+
+                        ShapeQuad quad;
+                        quad.origin = box.min;
+                        quad.origin[d] = plane;
+                        quad.du[u] = box.max[u] - box.min[u];
+                        quad.dv[v] = box.max[v] - box.min[v];
+                        quad.axis = d;
+                        quad.backFace = backFace;
+
+                        // Faces on the voxel border can be hidden by the neighbour, and hide part of it
+                        if (plane == (backFace ? 0 : SHAPE_RESOLUTION)) {
+                            quad.cullFace = d * 2 + side;
+                            quad.coverage = getCells(box.min, box.max, u, v, true);
+                            if (occluding) {
+                                shape.occlusion_[quad.cullFace] |= getCells(box.min, box.max, u, v, false);
+                            }
+                        }
+
+                        shape.quads_.push_back(quad);
+                    }
+                }
+            }
+
+            return shape;
+        }
+
+    } // namespace Voxel
+} // namespace Gem
@@ -0,0 +1,131 @@
+#include <Gem/Voxel/chunk_lod.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace Gem {
+    namespace Voxel {
+
+        namespace {
+
+            /**
+             * @brief Halves the resolution of a grid of blocks and light.
+             * @param length The number of cells per side of the source, even.
+             * @param blockAt Returns the block ID of a source cell.
+             * @param lightAt Returns the packed light of a source cell.
+             */
+            template<typename BlockAt, typename LightAt>
+            void downsample(uint32_t length, const BlockAt& blockAt, const LightAt& lightAt, std::vector<uint16_t>& blocks, std::vector<uint8_t>& lights) {
+                const uint32_t half = length / 2;
+                blocks.assign(size_t(half) * half * half, 0);
+                lights.assign(size_t(half) * half * half, 0);
+
+                size_t cell = 0;
+                for (uint32_t z = 0; z < half; ++z) {
+                    for (uint32_t y = 0; y < half; ++y) {
+                        for (uint32_t x = 0; x < half; ++x, ++cell) {
+                            uint16_t block = 0;
+                            uint8_t sky = 0;
+                            uint8_t light = 0;
+
+                            // Top layer first, so the highest solid child gives the block
+                            for (int32_t dy = 1; dy >= 0; --dy) {
+                                for (uint32_t dz = 0; dz < 2; ++dz) {
+                                    for (uint32_t dx = 0; dx < 2; ++dx) {
+                                        const uint32_t cx = x * 2 + dx;
+                                        const uint32_t cy = y * 2 + static_cast<uint32_t>(dy);
+                                        const uint32_t cz = z * 2 + dz;
+
+                                        if (block == 0) {
+                                            block = blockAt(cx, cy, cz);
+                                        }
+
+                                        const uint8_t packed = lightAt(cx, cy, cz);
+                                        sky = std::max<uint8_t>(sky, packed >> 4);
+                                        light = std::max<uint8_t>(light, packed & 0x0F);
+                                    }
+                                }
+                            }
+
+                            blocks[cell] = block;
+                            lights[cell] = static_cast<uint8_t>((sky << 4) | light);
+                        }
+                    }
+                }
+            }
+
+        } // namespace
+
+        ChunkLod::ChunkLod(const Chunk& chunk)
+            : version_(chunk.getVersion()) {
+
+            const uint32_t length = getLength(0);
+
+            // Level 1 reads the full-resolution chunk, resolving its palette once
+            const PaletteStorage<Voxel>& storage = chunk.getStorage();
+            std::vector<uint16_t> ids;
+            ids.reserve(storage.getPaletteSize());
+            for (const Voxel& voxel : storage.getPalette()) {
+                ids.push_back(voxel.getId());
+            }
+
+            const Chunk::LightStorage& sky = chunk.getLightStorage(LightType::Sky);
+            const Chunk::LightStorage& block = chunk.getLightStorage(LightType::Block);
+
+            downsample(length, [&](uint32_t x, uint32_t y, uint32_t z) {
+                return ids[storage.getIndex(Chunk::linearizeUnchecked(x, y, z))];
+            }, [&](uint32_t x, uint32_t y, uint32_t z) {
+                const size_t i = Chunk::linearizeUnchecked(x, y, z);
+                return static_cast<uint8_t>((sky.get(i) << 4) | block.get(i));
+            }, blocks_[0], lights_[0]);
+
+            // Every further level halves the previous one
+            for (uint32_t level = 2; level <= MAX_CHUNK_LOD; ++level) {
+                const uint32_t source = getLength(level - 1);
+                const std::vector<uint16_t>& blocks = blocks_[level - 2];
+                const std::vector<uint8_t>& lights = lights_[level - 2];
+
+                downsample(source, [&](uint32_t x, uint32_t y, uint32_t z) {
+                    return blocks[x + (y + z * source) * source];
+                }, [&](uint32_t x, uint32_t y, uint32_t z) {
+                    return lights[x + (y + z * source) * source];
+                }, blocks_[level - 1], lights_[level - 1]);
+            }
+        }
+
+        uint16_t ChunkLod::getBlock(uint32_t level, uint32_t x, uint32_t y, uint32_t z) const {
+            return blocks_[getSlot(level)][getIndex(level, x, y, z)];
+        }
+
+        uint8_t ChunkLod::getLight(uint32_t level, uint32_t x, uint32_t y, uint32_t z) const {
+            return lights_[getSlot(level)][getIndex(level, x, y, z)];
+        }
+
+        const std::vector<uint16_t>& ChunkLod::getBlocks(uint32_t level) const {
+            return blocks_[getSlot(level)];
+        }
+
+        const std::vector<uint8_t>& ChunkLod::getLights(uint32_t level) const {
+            return lights_[getSlot(level)];
+        }
+
+        uint64_t ChunkLod::getVersion() const noexcept {
+            return version_;
+        }
+
+        size_t ChunkLod::getSlot(uint32_t level) {
+            if (level == 0 || level > MAX_CHUNK_LOD) {
+                throw std::out_of_range("Level of detail out of range in ChunkLod.");
+            }
+            return level - 1;
+        }
+
+        size_t ChunkLod::getIndex(uint32_t level, uint32_t x, uint32_t y, uint32_t z) {
+            const uint32_t length = getLength(level);
+            if (x >= length || y >= length || z >= length) {
+                throw std::out_of_range("Cell coordinates out of bounds in ChunkLod.");
+            }
+            return x + (y + size_t(z) * length) * length;
+        }
+
+    } // namespace Voxel
+} // namespace Gem
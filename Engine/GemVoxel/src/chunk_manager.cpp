@@ -0,0 +1,294 @@
+#include <Gem/Voxel/chunk_manager.h>
+#include <algorithm>
+#include <cstdlib>
+
+namespace Gem {
+    namespace Voxel {
+
+        ChunkManager::ChunkManager() {
+            // Nothing is loaded until the first update, and every chunk is at full resolution
+            lodDistances_.fill(std::numeric_limits<int32_t>::max());
+        }
+
+        ChunkManager::~ChunkManager() {
+            clear();
+        }
+
+        void ChunkManager::setGenerator(ChunkCallback generator) {
+            generator_ = std::move(generator);
+        }
+
+        void ChunkManager::setBatchGenerator(BatchCallback generator) {
+            batchGenerator_ = std::move(generator);
+        }
+
+        void ChunkManager::setLoadCallback(ChunkCallback callback) {
+            onLoad_ = std::move(callback);
+        }
+
+        void ChunkManager::setUnloadCallback(ChunkCallback callback) {
+            onUnload_ = std::move(callback);
+        }
+
+        void ChunkManager::setEditCallback(EditCallback callback) {
+            onEdit_ = std::move(callback);
+        }
+
+        void ChunkManager::setLoadRadius(int32_t horizontal, int32_t vertical) {
+            horizontalRadius_ = std::max(horizontal, 0);
+            verticalRadius_ = std::max(vertical, 0);
+            hasCenter_ = false; // Force the queue to be rebuilt
+        }
+
+        void ChunkManager::setUnloadMargin(int32_t margin) {
+            unloadMargin_ = std::max(margin, 0);
+        }
+
+        void ChunkManager::setMaxLoadsPerFrame(size_t maxLoads) {
+            maxLoadsPerFrame_ = maxLoads;
+        }
+
+        void ChunkManager::setLodDistances(const std::array<int32_t, MAX_CHUNK_LOD>& distances) {
+            lodDistances_ = distances;
+        }
+
+        uint32_t ChunkManager::getLod(const ChunkCoord& coord) const noexcept {
+            const int64_t dx = coord.x - center_.x;
+            const int64_t dy = coord.y - center_.y;
+            const int64_t dz = coord.z - center_.z;
+            const int64_t distance = dx * dx + dy * dy + dz * dz;
+
+            uint32_t lod = 0;
+            while (lod < MAX_CHUNK_LOD && distance >= int64_t(lodDistances_[lod]) * lodDistances_[lod]) {
+                ++lod;
+            }
+            return lod;
+        }
+
+        const ChunkCoord& ChunkManager::getCenter() const noexcept {
+            return center_;
+        }
+
+        void ChunkManager::update(const glm::vec3& position) {
+            const ChunkCoord center = ChunkCoord::fromWorld(position);
+
+            // Only rescan when the position crosses into another chunk
+            if (!hasCenter_ || center != center_) {
+                center_ = center;
+                hasCenter_ = true;
+
+                unloadFarChunks(center);
+                rebuildQueue(center);
+            }
+
+            ChunkBatch batch;
+            while (batch.size() < maxLoadsPerFrame_ && !loadQueue_.empty()) {
+                const ChunkCoord coord = loadQueue_.back();
+                loadQueue_.pop_back();
+
+                if (chunks_.find(coord) == chunks_.end()) {
+                    batch.emplace_back(coord, pool_.acquire());
+                }
+            }
+
+            if (!batch.empty()) {
+                loadChunks(batch);
+            }
+        }
+
+        void ChunkManager::clear() {
+            while (!chunks_.empty()) {
+                unloadChunk(chunks_.begin());
+            }
+
+            loadQueue_.clear();
+            hasCenter_ = false;
+        }
+
+        Chunk* ChunkManager::getChunk(const ChunkCoord& coord) const {
+            auto it = chunks_.find(coord);
+            return (it != chunks_.end()) ? it->second : nullptr;
+        }
+
+        Voxel ChunkManager::getVoxel(const glm::ivec3& voxel) const {
+            const ChunkCoord coord = ChunkCoord::fromVoxel(voxel);
+
+            const Chunk* chunk = getChunk(coord);
+            if (!chunk) {
+                return Voxel();
+            }
+
+            const glm::ivec3 local = voxel - coord.getOrigin();
+            return chunk->getVoxelUnchecked(local.x, local.y, local.z);
+        }
+
+        bool ChunkManager::setVoxel(const glm::ivec3& voxel, const Voxel& value) {
+            const ChunkCoord coord = ChunkCoord::fromVoxel(voxel);
+
+            Chunk* chunk = getChunk(coord);
+            if (!chunk) {
+                return false;
+            }
+
+            const glm::ivec3 local = voxel - coord.getOrigin();
+            const uint64_t version = chunk->getVersion();
+            const Voxel previous = chunk->getVoxelUnchecked(local.x, local.y, local.z);
+
+            chunk->setVoxelUnchecked(local.x, local.y, local.z, value);
+            if (chunk->getVersion() == version) {
+                return false;
+            }
+
+            markNeighboursDirty(coord, local, local);
+
+            if (onEdit_) {
+                onEdit_(voxel, previous, value);
+            }
+            return true;
+        }
+
+        const ChunkManager::ChunkMap& ChunkManager::getChunks() const noexcept {
+            return chunks_;
+        }
+
+        ChunkManagerStats ChunkManager::getStats() const {
+            ChunkManagerStats stats;
+
+            stats.loadedChunks = chunks_.size();
+            stats.pendingLoads = loadQueue_.size();
+            stats.totalLoads = totalLoads_;
+            stats.totalUnloads = totalUnloads_;
+            stats.pooledChunks = pool_.getCapacity();
+
+            for (const auto& [coord, chunk] : chunks_) {
+                stats.memoryUsage += chunk->getMemoryUsage();
+            }
+
+            return stats;
+        }
+
+        void ChunkManager::rebuildQueue(const ChunkCoord& center) {
+            loadQueue_.clear();
+
+            for (int32_t dy = -verticalRadius_; dy <= verticalRadius_; ++dy) {
+                for (int32_t dz = -horizontalRadius_; dz <= horizontalRadius_; ++dz) {
+                    for (int32_t dx = -horizontalRadius_; dx <= horizontalRadius_; ++dx) {
+                        const ChunkCoord coord = center.offset(dx, dy, dz);
+
+                        if (isWithin(coord, center, horizontalRadius_, verticalRadius_) && chunks_.find(coord) == chunks_.end()) {
+                            loadQueue_.push_back(coord);
+                        }
+                    }
+                }
+            }
+
+            // Farthest first, so the nearest chunks are popped from the back
+            auto distance = [&center](const ChunkCoord& c) {
+                const int32_t dx = c.x - center.x;
+                const int32_t dy = c.y - center.y;
+                const int32_t dz = c.z - center.z;
+                return dx * dx + dy * dy + dz * dz;
+            };
+
+            std::sort(loadQueue_.begin(), loadQueue_.end(), [&distance](const ChunkCoord& a, const ChunkCoord& b) {
+                return distance(a) > distance(b);
+            });
+        }
+
+        void ChunkManager::unloadFarChunks(const ChunkCoord& center) {
+            const int32_t horizontal = horizontalRadius_ + unloadMargin_;
+            const int32_t vertical = verticalRadius_ + unloadMargin_;
+
+            for (auto it = chunks_.begin(); it != chunks_.end();) {
+                if (!isWithin(it->first, center, horizontal, vertical)) {
+                    auto next = std::next(it);
+                    unloadChunk(it);
+                    it = next;
+                }
+                else {
+                    ++it;
+                }
+            }
+        }
+
+        bool ChunkManager::isWithin(const ChunkCoord& coord, const ChunkCoord& center, int32_t horizontal, int32_t vertical) noexcept {
+            const int32_t dx = coord.x - center.x;
+            const int32_t dy = coord.y - center.y;
+            const int32_t dz = coord.z - center.z;
+
+            return dx * dx + dz * dz <= horizontal * horizontal && std::abs(dy) <= vertical;
+        }
+
+        void ChunkManager::loadChunks(const ChunkBatch& batch) {
+            if (batchGenerator_) {
+                batchGenerator_(batch);
+            }
+            else if (generator_) {
+                for (const auto& [coord, chunk] : batch) {
+                    generator_(coord, *chunk);
+                }
+            }
+
+            const glm::ivec3 last(static_cast<int32_t>(Chunk::getLength()) - 1);
+
+            for (const auto& [coord, chunk] : batch) {
+                chunks_.emplace(coord, chunk);
+                ++totalLoads_;
+
+                // Border faces of the neighbours may now be hidden
+                markNeighboursDirty(coord, glm::ivec3(0), last);
+
+                if (onLoad_) {
+                    onLoad_(coord, *chunk);
+                }
+            }
+        }
+
+        void ChunkManager::markNeighboursDirty(const ChunkCoord& coord, const glm::ivec3& min, const glm::ivec3& max) {
+            const int32_t length = static_cast<int32_t>(Chunk::getLength());
+
+            // Faces see the voxels in front of them, and ambient occlusion the voxels around those,
+            // so the region grown by one voxel reaches into edge and corner neighbours as well
+            for (int32_t dz = -1; dz <= 1; ++dz) {
+                for (int32_t dy = -1; dy <= 1; ++dy) {
+                    for (int32_t dx = -1; dx <= 1; ++dx) {
+                        const glm::ivec3 offset(dx, dy, dz);
+                        if (offset == glm::ivec3(0)) {
+                            continue;
+                        }
+
+                        bool touches = true;
+                        for (int axis = 0; axis < 3; ++axis) {
+                            if ((offset[axis] > 0 && max[axis] < length - 1) || (offset[axis] < 0 && min[axis] > 0)) {
+                                touches = false;
+                            }
+                        }
+
+                        if (!touches) {
+                            continue;
+                        }
+
+                        Chunk* neighbour = getChunk(coord.offset(dx, dy, dz));
+                        if (!neighbour) {
+                            continue;
+                        }
+
+                        // The grown region in the neighbour's coordinates, clamped by markRegionDirty()
+                        neighbour->markRegionDirty(min - 1 - offset * length, max + 1 - offset * length);
+                    }
+                }
+            }
+        }
+
+        void ChunkManager::unloadChunk(ChunkMap::iterator it) {
+            if (onUnload_) {
+                onUnload_(it->first, *it->second);
+            }
+
+            pool_.release(it->second);
+            chunks_.erase(it);
+            ++totalUnloads_;
+        }
+
+    } // namespace Voxel
+} // namespace Gem
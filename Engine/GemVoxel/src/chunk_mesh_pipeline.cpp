@@ -0,0 +1,244 @@
+#include <Gem/Voxel/chunk_mesh_pipeline.h>
+#include <algorithm>
+
+namespace Gem {
+    namespace Voxel {
+
+        ChunkMeshPipeline::ChunkMeshPipeline(Gem::Core::JobSystem& jobs, const ChunkManager& chunks, const BlockRegistry* blocks)
+            : jobs_(jobs), chunks_(chunks), blocks_(blocks) {
+            // Refuse the registry here rather than in every meshing job
+            ChunkMesher::checkBlockRegistry(blocks_);
+        }
+
+        ChunkMeshPipeline::~ChunkMeshPipeline() {
+            // Jobs write into this object, let them finish first
+            for (const Gem::Core::JobHandle& handle : handles_) {
+                jobs_.wait(handle);
+            }
+        }
+
+        void ChunkMeshPipeline::request(const ChunkCoord& coord) {
+            Chunk* chunk = chunks_.getChunk(coord);
+            if (!chunk) {
+                return;
+            }
+
+            // The level the chunk is meshed at, or about to be
+            const uint32_t lod = chunks_.getLod(coord);
+            uint32_t current = 0;
+            if (auto inFlight = pending_.find(coord); inFlight != pending_.end()) {
+                current = inFlight->second.lod;
+            }
+            else if (auto meshed = meshes_.find(coord); meshed != meshes_.end()) {
+                current = meshed->second.lod;
+            }
+
+            uint64_t dirty = chunk->takeDirtySections();
+            if (dirty == 0 && lod == current) {
+                return;
+            }
+
+            std::shared_ptr<const ChunkLod> downsampled;
+            if (lod == 0) {
+                // Back to full resolution, nothing of the coarse mesh can be kept
+                if (current != 0) {
+                    dirty = Chunk::getAllSections();
+                }
+
+                // The downsampled copy misses the changes taken here
+                if (dirty != 0) {
+                    lods_.erase(coord);
+                }
+            }
+            else {
+                std::shared_ptr<const ChunkLod>& cached = lods_[coord];
+                if (!cached || dirty != 0 || cached->getVersion() != chunk->getVersion()) {
+                    cached = std::make_shared<const ChunkLod>(*chunk);
+                    ++stats_.totalLodBuilds;
+                }
+                downsampled = cached;
+            }
+
+            // Supersede the request in flight, so its sections are rebuilt here as well
+            Pending& pending = pending_[coord];
+            pending.sections = (pending.lod == lod) ? (pending.sections | dirty) : dirty;
+            pending.sequence = nextSequence_++;
+            pending.lod = lod;
+
+            const uint64_t sequence = pending.sequence;
+            const uint64_t sections = (lod == 0) ? pending.sections : Chunk::getAllSections();
+
+            ++stats_.inFlight;
+
+            if (downsampled) {
+                handles_.push_back(jobs_.schedule([this, coord, downsampled, lod, sequence, sections]() {
+                    thread_local ChunkMesher mesher;
+                    mesher.setBlockRegistry(blocks_);
+
+                    Result result;
+                    result.coord = coord;
+                    result.version = downsampled->getVersion();
+                    result.sequence = sequence;
+                    result.sections = sections;
+                    result.lod = lod;
+                    result.faces = mesher.meshLod(*downsampled, lod, result.mesh);
+
+                    std::lock_guard<std::mutex> lock(resultsMutex_);
+                    results_.push_back(std::move(result));
+                }));
+                return;
+            }
+
+            std::shared_ptr<const ChunkSnapshot> source = snapshot(coord, *chunk);
+
+            handles_.push_back(jobs_.schedule([this, source, sequence, sections]() {
+                // Meshers hold scratch memory, keep one per worker thread
+                thread_local ChunkMesher mesher;
+                mesher.setBlockRegistry(blocks_);
+
+                Result result;
+                result.coord = source->getCoord();
+                result.version = source->getVersion();
+                result.sequence = sequence;
+                result.sections = sections;
+                result.faces = mesher.meshSections(*source, sections, result.mesh);
+
+                std::lock_guard<std::mutex> lock(resultsMutex_);
+                results_.push_back(std::move(result));
+            }));
+        }
+
+        void ChunkMeshPipeline::requestWithNeighbours(const ChunkCoord& coord) {
+            for (int32_t dz = -1; dz <= 1; ++dz) {
+                for (int32_t dy = -1; dy <= 1; ++dy) {
+                    for (int32_t dx = -1; dx <= 1; ++dx) {
+                        request(coord.offset(dx, dy, dz));
+                    }
+                }
+            }
+        }
+
+        void ChunkMeshPipeline::updateLod() {
+            const ChunkCoord& center = chunks_.getCenter();
+            if (hasLodCenter_ && center == lodCenter_) {
+                return;
+            }
+            lodCenter_ = center;
+            hasLodCenter_ = true;
+
+            // request() compares the level of each chunk with the one it is meshed at
+            std::vector<ChunkCoord> coords;
+            coords.reserve(meshes_.size() + pending_.size());
+            for (const auto& [coord, cached] : meshes_) {
+                coords.push_back(coord);
+            }
+            for (const auto& [coord, pending] : pending_) {
+                coords.push_back(coord);
+            }
+
+            for (const ChunkCoord& coord : coords) {
+                request(coord);
+            }
+        }
+
+        void ChunkMeshPipeline::remove(const ChunkCoord& coord) {
+            meshes_.erase(coord);
+            pending_.erase(coord);
+            lods_.erase(coord);
+        }
+
+        size_t ChunkMeshPipeline::processResults(const UploadCallback& upload, size_t maxUploads) {
+            std::vector<Result> results;
+            {
+                std::lock_guard<std::mutex> lock(resultsMutex_);
+
+                // Oldest results first, keep the rest for the next call
+                const size_t count = std::min(maxUploads, results_.size());
+                results.assign(std::make_move_iterator(results_.begin()), std::make_move_iterator(results_.begin() + count));
+                results_.erase(results_.begin(), results_.begin() + count);
+            }
+
+            size_t uploads = 0;
+            for (Result& result : results) {
+                --stats_.inFlight;
+
+                // A newer request covers these sections, or the chunk was removed
+                auto pending = pending_.find(result.coord);
+                if (pending == pending_.end() || pending->second.sequence != result.sequence) {
+                    ++stats_.totalDiscarded;
+                    continue;
+                }
+                pending_.erase(pending);
+
+                Chunk* chunk = chunks_.getChunk(result.coord);
+                if (!chunk) {
+                    meshes_.erase(result.coord);
+                    ++stats_.totalDiscarded;
+                    continue;
+                }
+
+                // Modified while being meshed without a new request, build these sections again
+                if (chunk->getVersion() != result.version) {
+                    ++stats_.totalDiscarded;
+                    chunk->markSectionsDirty(result.sections);
+                    request(result.coord);
+                    continue;
+                }
+
+                CachedMesh& cached = meshes_[result.coord];
+                ChunkMesh& mesh = cached.mesh;
+                cached.lod = result.lod;
+
+                if (result.lod != 0) {
+                    // Coarse meshes are built whole
+                    std::swap(mesh, result.mesh);
+                }
+                else {
+                    mesh.sections.resize(Chunk::getSectionCount());
+                    for (uint32_t index = 0; index < Chunk::getSectionCount(); ++index) {
+                        if (result.sections & (uint64_t(1) << index)) {
+                            std::swap(mesh.sections[index], result.mesh.sections[index]);
+                            ++stats_.remeshedSections;
+                        }
+                    }
+                    mesh.visibility = result.mesh.visibility;
+                    mesh.assemble();
+                }
+
+                stats_.remeshedFaces += result.faces;
+                stats_.lastRemeshedFaces = result.faces;
+                ++stats_.totalUploads;
+
+                upload(result.coord, mesh);
+                ++uploads;
+            }
+
+            // Forget the handles of finished jobs
+            handles_.erase(std::remove_if(handles_.begin(), handles_.end(), [](const Gem::Core::JobHandle& handle) {
+                return handle.isDone();
+            }), handles_.end());
+
+            return uploads;
+        }
+
+        ChunkMeshPipelineStats ChunkMeshPipeline::getStats() const {
+            return stats_;
+        }
+
+        std::shared_ptr<const ChunkSnapshot> ChunkMeshPipeline::snapshot(const ChunkCoord& coord, const Chunk& chunk) const {
+            ChunkSnapshot::Neighbours neighbours{};
+            for (int32_t dz = -1; dz <= 1; ++dz) {
+                for (int32_t dy = -1; dy <= 1; ++dy) {
+                    for (int32_t dx = -1; dx <= 1; ++dx) {
+                        if (dx != 0 || dy != 0 || dz != 0) {
+                            neighbours[ChunkSnapshot::getNeighbourIndex(dx, dy, dz)] = chunks_.getChunk(coord.offset(dx, dy, dz));
+                        }
+                    }
+                }
+            }
+
+            return std::make_shared<const ChunkSnapshot>(coord, chunk, neighbours);
+        }
+
+    } // namespace Voxel
+} // namespace Gem
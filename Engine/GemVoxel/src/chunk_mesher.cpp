@@ -0,0 +1,549 @@
+#include <Gem/Voxel/chunk_mesher.h>
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+
+namespace Gem {
+    namespace Voxel {
+
+        void ChunkMeshSection::clear() noexcept {
+            vertices.clear();
+            indices.clear();
+            shapeVertices.clear();
+            shapeIndices.clear();
+        }
+
+        size_t ChunkMeshSection::getQuadCount() const noexcept {
+            return (indices.size() + shapeIndices.size()) / 6;
+        }
+
+        void ChunkMesh::clear() noexcept {
+            vertices.clear();
+            indices.clear();
+            shapeVertices.clear();
+            shapeIndices.clear();
+            visibility = ChunkVisibility();
+
+            for (ChunkMeshSection& section : sections) {
+                section.clear();
+            }
+        }
+
+        void ChunkMesh::assemble() {
+            size_t vertexCount = 0;
+            size_t indexCount = 0;
+            size_t shapeVertexCount = 0;
+            size_t shapeIndexCount = 0;
+            for (const ChunkMeshSection& section : sections) {
+                vertexCount += section.vertices.size();
+                indexCount += section.indices.size();
+                shapeVertexCount += section.shapeVertices.size();
+                shapeIndexCount += section.shapeIndices.size();
+            }
+
+            vertices.clear();
+            indices.clear();
+            shapeVertices.clear();
+            shapeIndices.clear();
+            vertices.reserve(vertexCount);
+            indices.reserve(indexCount);
+            shapeVertices.reserve(shapeVertexCount);
+            shapeIndices.reserve(shapeIndexCount);
+
+            for (const ChunkMeshSection& section : sections) {
+                const GLuint base = static_cast<GLuint>(vertices.size());
+                const GLuint shapeBase = static_cast<GLuint>(shapeVertices.size());
+
+                vertices.insert(vertices.end(), section.vertices.begin(), section.vertices.end());
+                for (GLuint index : section.indices) {
+                    indices.push_back(base + index);
+                }
+
+                shapeVertices.insert(shapeVertices.end(), section.shapeVertices.begin(), section.shapeVertices.end());
+                for (GLuint index : section.shapeIndices) {
+                    shapeIndices.push_back(shapeBase + index);
+                }
+            }
+        }
+
+        bool ChunkMesh::empty() const noexcept {
+            return indices.empty() && shapeIndices.empty();
+        }
+
+        size_t ChunkMesh::getVertexCount() const noexcept {
+            return vertices.size() + shapeVertices.size();
+        }
+
+        size_t ChunkMesh::getTriangleCount() const noexcept {
+            return (indices.size() + shapeIndices.size()) / 3;
+        }
+
+        namespace {
+
+            constexpr size_t PADDED_STRIDES[3] = { ChunkNeighborhood::getStride(0), ChunkNeighborhood::getStride(1), ChunkNeighborhood::getStride(2) };
+
+        } // namespace
+
+        ChunkMesher::ChunkMesher()
+            : mask_(2 * Chunk::getSectionLength() * Chunk::getSectionLength(), 0) {
+        }
+
+        void ChunkMesher::mesh(const Chunk& chunk, ChunkMesh& mesh) {
+            neighborhood_.gather(chunk);
+
+            mesh.clear();
+            build(chunk, Chunk::getAllSections(), mesh);
+            mesh.assemble();
+        }
+
+        void ChunkMesher::mesh(const ChunkSnapshot& snapshot, ChunkMesh& mesh) {
+            mesh.clear();
+            meshSections(snapshot, Chunk::getAllSections(), mesh);
+            mesh.assemble();
+        }
+
+        size_t ChunkMesher::meshSections(const ChunkSnapshot& snapshot, uint64_t sections, ChunkMesh& mesh) {
+            neighborhood_.gather(snapshot);
+            return build(snapshot.getChunk(), sections, mesh);
+        }
+
+        size_t ChunkMesher::meshLod(const ChunkLod& lod, uint32_t level, ChunkMesh& mesh) {
+            gather(lod, level);
+
+            // Shapes are smaller than a coarse cell, every block is drawn as an opaque cube
+            useShapes(false);
+
+            mesh.clear();
+            mesh.sections.resize(Chunk::getSectionCount());
+
+            // Coarse grids are small enough to be merged as a single section
+            const int min[3] = { 0, 0, 0 };
+            const size_t quads = buildSection(min, static_cast<int>(ChunkLod::getLength(level)), 1 << level, mesh.sections[0]);
+
+            // Merged cells can close or open passages, so distant chunks never hide what lies behind them
+            mesh.visibility = ChunkVisibility::all();
+
+            mesh.assemble();
+            return quads;
+        }
+
+        void ChunkMesher::gather(const ChunkLod& lod, uint32_t level) {
+            const std::vector<uint16_t>& blocks = lod.getBlocks(level);
+            const std::vector<uint8_t>& lights = lod.getLights(level);
+            const int n = static_cast<int>(ChunkLod::getLength(level));
+
+            // Only the (n + 2)^3 corner of the neighbourhood is used. The shell is air, so every border
+            // face is emitted and skirts the seams with neighbours meshed at another level; it takes the
+            // light of the cell it touches, so skirts are lit like the faces next to them.
+            for (int z = -1; z <= n; ++z) {
+                for (int y = -1; y <= n; ++y) {
+                    for (int x = -1; x <= n; ++x) {
+                        const int cx = std::clamp(x, 0, n - 1);
+                        const int cy = std::clamp(y, 0, n - 1);
+                        const int cz = std::clamp(z, 0, n - 1);
+                        const size_t source = static_cast<size_t>(cx + (cy + cz * n) * n);
+                        const bool inside = cx == x && cy == y && cz == z;
+
+                        neighborhood_.set(ChunkNeighborhood::getIndex(x, y, z), inside ? blocks[source] : uint16_t(0), lights[source]);
+                    }
+                }
+            }
+        }
+
+        size_t ChunkMesher::build(const Chunk& chunk, uint64_t sections, ChunkMesh& mesh) {
+            useShapes(true);
+
+            const uint32_t perAxis = Chunk::getSectionsPerAxis();
+            const int sectionLength = static_cast<int>(Chunk::getSectionLength());
+
+            mesh.sections.resize(Chunk::getSectionCount());
+
+            // Faces belong to the section holding their block, so sections of air only need clearing
+            const uint64_t solid = chunk.getSolidSections();
+
+            size_t quads = 0;
+            for (uint32_t index = 0; index < Chunk::getSectionCount(); ++index) {
+                if ((sections & (uint64_t(1) << index)) == 0) {
+                    continue;
+                }
+
+                const int min[3] = {
+                    static_cast<int>(index % perAxis) * sectionLength,
+                    static_cast<int>((index / perAxis) % perAxis) * sectionLength,
+                    static_cast<int>(index / (perAxis * perAxis)) * sectionLength
+                };
+
+                ChunkMeshSection& section = mesh.sections[index];
+                section.clear();
+                if (solid & (uint64_t(1) << index)) {
+                    quads += buildSection(min, sectionLength, 1, section);
+                }
+            }
+
+            mesh.visibility = computeVisibility(chunk.getOccupancy());
+            return quads;
+        }
+
+        void ChunkMesher::useShapes(bool enabled) noexcept {
+            shapeCount_ = (enabled && registry_) ? registry_->getCount() : 0;
+            fullCube_ = registry_ ? registry_->getFullCubeTable() : nullptr;
+            occlusion_ = registry_ ? registry_->getOcclusionTable() : nullptr;
+            fluid_ = registry_ ? registry_->getFluidTable() : nullptr;
+            fluidLevel_ = registry_ ? registry_->getFluidLevelTable() : nullptr;
+        }
+
+        ChunkVisibility ChunkMesher::computeVisibility(const Chunk::Occupancy& occupancy) {
+            if (occupancy.isEmpty()) {
+                return ChunkVisibility::all();
+            }
+
+            constexpr int32_t length = ChunkNeighborhood::LENGTH;
+            constexpr size_t volume = size_t(length) * length * length;
+            constexpr size_t strides[3] = { 1, size_t(length), size_t(length) * length };
+            static_assert(volume <= 65536, "Flood fill indices must fit 16 bits.");
+
+            // Opaque cubes stop the view, everything else (air, leaves, slabs...) lets it through
+            filled_.resize(volume);
+            size_t open = 0;
+            size_t index = 0;
+            for (int32_t z = 0; z < length; ++z) {
+                for (int32_t y = 0; y < length; ++y) {
+                    for (int32_t x = 0; x < length; ++x, ++index) {
+                        const uint16_t id = neighborhood_.getBlock(x, y, z);
+                        const bool opaque = isCube(id) && getOcclusion(id, 0) == FULL_FACE;
+                        filled_[index] = opaque ? 1 : 0;
+                        open += opaque ? 0 : 1;
+                    }
+                }
+            }
+
+            if (open == 0) {
+                return ChunkVisibility();
+            }
+            if (open == volume) {
+                return ChunkVisibility::all();
+            }
+
+            ChunkVisibility visibility;
+            for (size_t start = 0; start < volume; ++start) {
+                if (filled_[start]) {
+                    continue;
+                }
+
+                // Collect the chunk faces touched by this connected region of open voxels
+                uint32_t faces = 0;
+                filled_[start] = 1;
+                flood_.push_back(static_cast<uint16_t>(start));
+
+                while (!flood_.empty()) {
+                    const size_t cell = flood_.back();
+                    flood_.pop_back();
+
+                    const int32_t coords[3] = {
+                        static_cast<int32_t>(cell % length),
+                        static_cast<int32_t>((cell / length) % length),
+                        static_cast<int32_t>(cell / (size_t(length) * length))
+                    };
+
+                    for (int d = 0; d < 3; ++d) {
+                        // Positive face of the axis first, see Face
+                        if (coords[d] == length - 1) {
+                            faces |= 1u << (d * 2);
+                        }
+                        else if (!filled_[cell + strides[d]]) {
+                            filled_[cell + strides[d]] = 1;
+                            flood_.push_back(static_cast<uint16_t>(cell + strides[d]));
+                        }
+
+                        if (coords[d] == 0) {
+                            faces |= 1u << (d * 2 + 1);
+                        }
+                        else if (!filled_[cell - strides[d]]) {
+                            filled_[cell - strides[d]] = 1;
+                            flood_.push_back(static_cast<uint16_t>(cell - strides[d]));
+                        }
+                    }
+                }
+
+                visibility.connect(faces);
+            }
+
+            return visibility;
+        }
+
+        uint8_t ChunkMesher::computeOcclusion(size_t front, size_t strideU, size_t strideV) const noexcept {
+            const int su[4] = { -1, 1, 1, -1 };
+            const int sv[4] = { -1, -1, 1, 1 };
+
+            uint8_t occlusion = 0;
+            for (int c = 0; c < 4; ++c) {
+                const ptrdiff_t offsetU = su[c] * static_cast<ptrdiff_t>(strideU);
+                const ptrdiff_t offsetV = sv[c] * static_cast<ptrdiff_t>(strideV);
+
+                // Only full cubes darken the corners around them
+                const int side1 = isCube(neighborhood_.getBlock(front + offsetU));
+                const int side2 = isCube(neighborhood_.getBlock(front + offsetV));
+                const int corner = isCube(neighborhood_.getBlock(front + offsetU + offsetV));
+
+                // Two solid sides hide the corner voxel entirely
+                const int level = (side1 && side2) ? 0 : 3 - (side1 + side2 + corner);
+                occlusion |= static_cast<uint8_t>(level << (c * 2));
+            }
+
+            return occlusion;
+        }
+
+        size_t ChunkMesher::buildSection(const int min[3], int n, int scale, ChunkMeshSection& section) {
+            const size_t area = size_t(n) * n;
+            size_t quads = 0;
+
+            // Sweep the section once per axis, one slice of faces at a time
+            for (int d = 0; d < 3; ++d) {
+                const int u = (d + 1) % 3;
+                const int v = (d + 2) % 3;
+
+                const size_t strideD = PADDED_STRIDES[d];
+                const size_t strideU = PADDED_STRIDES[u];
+                const size_t strideV = PADDED_STRIDES[v];
+
+                const size_t posFace = static_cast<size_t>(d) * 2;
+                const size_t negFace = posFace + 1;
+
+                int x[3] = { 0, 0, 0 };
+
+                const int first = min[d];
+                const int last = min[d] + n - 1;
+
+                // x[d] = first - 1 and x[d] = last are the faces on the section border,
+                // only the side inside the section emits a face there
+                for (x[d] = first - 1; x[d] <= last;) {
+
+                    // Build the face masks between slice x[d] and slice x[d] + 1, faces looking towards +d
+                    // first and faces looking towards -d after them: both exist when neither cube hides the other.
+                    // The block ID sits in the low 16 bits, the light of the voxel in front above it
+                    // and the corner occlusion above that, so only faces shaded the same way are merged.
+                    int64_t* positive = mask_.data();
+                    int64_t* negative = mask_.data() + area;
+
+                    size_t m = 0;
+                    for (x[v] = min[v]; x[v] < min[v] + n; ++x[v]) {
+                        x[u] = min[u];
+                        size_t cell = ChunkNeighborhood::getIndex(x[0], x[1], x[2]);
+
+                        for (; x[u] < min[u] + n; ++x[u], cell += strideU, ++m) {
+                            const uint16_t a = neighborhood_.getBlock(cell);
+                            const uint16_t b = neighborhood_.getBlock(cell + strideD);
+
+                            // A face belongs to the section holding its block, and is hidden when the
+                            // block in front covers the whole face
+                            positive[m] = 0;
+                            negative[m] = 0;
+
+                            if (x[d] >= first && isCube(a) && getOcclusion(b, negFace) != FULL_FACE) {
+                                const size_t front = cell + strideD;
+                                positive[m] = a | (int64_t(neighborhood_.getPackedLight(front)) << 16) | (int64_t(computeOcclusion(front, strideU, strideV)) << 24);
+                            }
+                            if (x[d] < last && isCube(b) && getOcclusion(a, posFace) != FULL_FACE) {
+                                negative[m] = b | (int64_t(neighborhood_.getPackedLight(cell)) << 16) | (int64_t(computeOcclusion(cell, strideU, strideV)) << 24);
+                            }
+                        }
+                    }
+
+                    ++x[d];
+                    quads += mergeFaces(positive, min, n, scale, d, x[d], false, section);
+                    quads += mergeFaces(negative, min, n, scale, d, x[d], true, section);
+                }
+            }
+
+            // Other shapes copy their pre-baked quads, keeping those their neighbours do not cover
+            if (shapeCount_ == 0) {
+                return quads;
+            }
+
+            for (int z = min[2]; z < min[2] + n; ++z) {
+                for (int y = min[1]; y < min[1] + n; ++y) {
+                    for (int x = min[0]; x < min[0] + n; ++x) {
+                        const size_t cell = ChunkNeighborhood::getIndex(x, y, z);
+                        const uint16_t id = neighborhood_.getBlock(cell);
+                        if (id == 0 || isCube(id)) {
+                            continue;
+                        }
+
+                        for (const ShapeQuad& quad : registry_->getShape(id).getQuads()) {
+                            if (quad.cullFace >= 0) {
+                                const uint16_t neighbour = neighborhood_.getBlock(offsetCell(cell, static_cast<size_t>(quad.cullFace)));
+                                if ((quad.coverage & ~getOcclusion(neighbour, static_cast<size_t>(quad.cullFace) ^ 1)) == 0) {
+                                    continue;
+                                }
+                                if (isSameFluidBehind(id, neighbour, static_cast<size_t>(quad.cullFace))) {
+                                    continue;
+                                }
+                            }
+
+                            // Lit by the voxel the quad looks at, shaded like a cube face only on the voxel border
+                            const size_t front = offsetCell(cell, static_cast<size_t>(quad.axis) * 2 + (quad.backFace ? 1 : 0));
+                            const uint8_t occlusion = (quad.cullFace >= 0)
+                                ? computeOcclusion(front, PADDED_STRIDES[(quad.axis + 1) % 3], PADDED_STRIDES[(quad.axis + 2) % 3])
+                                : uint8_t(0xFF);
+
+                            const int origin[3] = {
+                                x * SHAPE_RESOLUTION + quad.origin.x,
+                                y * SHAPE_RESOLUTION + quad.origin.y,
+                                z * SHAPE_RESOLUTION + quad.origin.z
+                            };
+                            const int du[3] = { quad.du.x, quad.du.y, quad.du.z };
+                            const int dv[3] = { quad.dv.x, quad.dv.y, quad.dv.z };
+
+                            emitQuad(section, origin, du, dv, quad.axis, quad.backFace, neighborhood_.getPackedLight(front), occlusion, id, true);
+                            ++quads;
+                        }
+                    }
+                }
+            }
+
+            return quads;
+        }
+
+        size_t ChunkMesher::mergeFaces(int64_t* mask, const int min[3], int n, int scale, int d, int slice, bool backFace, ChunkMeshSection& section) {
+            const int u = (d + 1) % 3;
+            const int v = (d + 2) % 3;
+
+            size_t quads = 0;
+            size_t m = 0;
+            for (int j = 0; j < n; ++j) {
+                for (int i = 0; i < n;) {
+                    const int64_t face = mask[m];
+
+                    if (face == 0) {
+                        ++i;
+                        ++m;
+                        continue;
+                    }
+
+                    // Grow along u
+                    int width = 1;
+                    while (i + width < n && mask[m + width] == face) {
+                        ++width;
+                    }
+
+                    // Grow along v while the whole row matches
+                    int height = 1;
+                    for (; j + height < n; ++height) {
+                        bool rowMatches = true;
+                        for (int k = 0; k < width; ++k) {
+                            if (mask[m + k + height * n] != face) {
+                                rowMatches = false;
+                                break;
+                            }
+                        }
+                        if (!rowMatches) {
+                            break;
+                        }
+                    }
+
+                    int x[3];
+                    x[d] = slice;
+                    x[u] = min[u] + i;
+                    x[v] = min[v] + j;
+
+                    // Cells are scale voxels wide
+                    const int origin[3] = { x[0] * scale, x[1] * scale, x[2] * scale };
+                    int du[3] = { 0, 0, 0 };
+                    int dv[3] = { 0, 0, 0 };
+                    du[u] = width * scale;
+                    dv[v] = height * scale;
+
+                    emitQuad(section, origin, du, dv, d, backFace, static_cast<uint8_t>(face >> 16), static_cast<uint8_t>(face >> 24), static_cast<uint16_t>(face), false);
+                    ++quads;
+
+                    // Clear the merged area so it is not emitted twice
+                    for (int l = 0; l < height; ++l) {
+                        for (int k = 0; k < width; ++k) {
+                            mask[m + k + l * n] = 0;
+                        }
+                    }
+
+                    i += width;
+                    m += width;
+                }
+            }
+
+            return quads;
+        }
+
+        void ChunkMesher::setBlockRegistry(const BlockRegistry* registry) {
+            checkBlockRegistry(registry);
+            registry_ = registry;
+        }
+
+        void ChunkMesher::checkBlockRegistry(const BlockRegistry* registry) {
+            if (registry && registry->getTextures().size() > MAX_TEXTURES) {
+                throw std::length_error("Too many block textures for the cube vertex layer in ChunkMesher::setBlockRegistry.");
+            }
+        }
+
+        uint32_t ChunkMesher::getTextureLayer(uint16_t id, Face face) const noexcept {
+            if (registry_ && id < registry_->getCount()) {
+                return registry_->getFaceLayer(id, face);
+            }
+            return (id > 0) ? id - 1u : 0u;
+        }
+
+        void ChunkMesher::emitQuad(ChunkMeshSection& section, const int origin[3], const int du[3], const int dv[3], int axis, bool backFace, uint8_t light, uint8_t occlusion, uint16_t id, bool shape) {
+            std::vector<GLuint>& indices = shape ? section.shapeIndices : section.indices;
+            const GLuint base = static_cast<GLuint>(shape ? section.shapeVertices.size() : section.vertices.size());
+
+            const int corners[4][3] = {
+                { origin[0],                 origin[1],                 origin[2] },
+                { origin[0] + du[0],         origin[1] + du[1],         origin[2] + du[2] },
+                { origin[0] + du[0] + dv[0], origin[1] + du[1] + dv[1], origin[2] + du[2] + dv[2] },
+                { origin[0] + dv[0],         origin[1] + dv[1],         origin[2] + dv[2] },
+            };
+
+            // Faces come in +axis, -axis pairs, see Face
+            const Face face = static_cast<Face>(axis * 2 + (backFace ? 1 : 0));
+            const uint32_t layer = getTextureLayer(id, face);
+
+            // Front faces are clockwise (see GLFW::enable_parameters).
+            // Corners 0-1-2-3 are counter-clockwise seen from +axis, so the order is reversed for front faces.
+            static constexpr int frontOrder[4] = { 0, 3, 2, 1 };
+            static constexpr int backOrder[4] = { 0, 1, 2, 3 };
+            const int* order = backFace ? backOrder : frontOrder;
+
+            int levels[4];
+            for (int c = 0; c < 4; ++c) {
+                levels[c] = (occlusion >> (c * 2)) & 3;
+            }
+
+            for (int c = 0; c < 4; ++c) {
+                const uint32_t x = static_cast<uint32_t>(corners[order[c]][0]);
+                const uint32_t y = static_cast<uint32_t>(corners[order[c]][1]);
+                const uint32_t z = static_cast<uint32_t>(corners[order[c]][2]);
+                const uint32_t closed = static_cast<uint32_t>(3 - levels[order[c]]);
+
+                if (shape) {
+                    section.shapeVertices.push_back(ShapeVertex::pack(x, y, z, face, closed, light, layer));
+                }
+                else {
+                    section.vertices.push_back(ChunkVertex::pack(x, y, z, face, closed, light, layer));
+                }
+            }
+
+            // Vertices 0 and 2 hold corners 0 and 2 in both orders. Split along the other diagonal when
+            // corners 0 and 2 are the darker pair, otherwise the darkness spreads over both triangles.
+            if (levels[0] + levels[2] < levels[1] + levels[3]) {
+                indices.insert(indices.end(), {
+                    base + 1, base + 2, base + 3,
+                    base + 3, base + 0, base + 1
+                });
+            }
+            else {
+                indices.insert(indices.end(), {
+                    base + 0, base + 1, base + 2,
+                    base + 2, base + 3, base + 0
+                });
+            }
+        }
+
+    } // namespace Voxel
+} // namespace Gem
@@ -0,0 +1,132 @@
+#include <Gem/Voxel/chunk_neighborhood.h>
+#include <algorithm>
+
+namespace Gem {
+    namespace Voxel {
+
+        namespace {
+
+            // gatherInterior() walks the voxel storage in x, y, z order
+            static_assert(Chunk::LayoutType::IS_LINEAR, "ChunkNeighborhood relies on the linear chunk layout.");
+
+            constexpr int32_t length = ChunkNeighborhood::LENGTH;
+            constexpr uint8_t OPEN_SKY = static_cast<uint8_t>(MAX_LIGHT << 4);
+
+            /**
+             * @brief Calls a function with the coordinates of every shell cell, from -1 to length.
+             */
+            template<typename Function>
+            void forEachShellCell(const Function& function) {
+                for (int32_t z = -1; z <= length; ++z) {
+                    for (int32_t y = -1; y <= length; ++y) {
+                        // Rows crossing the chunk only have their two end cells in the shell
+                        const bool inside = z >= 0 && z < length && y >= 0 && y < length;
+                        for (int32_t x = -1; x <= length; x += (inside && x == -1) ? length + 1 : 1) {
+                            function(x, y, z);
+                        }
+                    }
+                }
+            }
+
+            /**
+             * @brief Gets the chunk offset of a chunk-local coordinate, from -1 to 1.
+             */
+            inline int32_t chunkOffset(int32_t value) noexcept {
+                return (value < 0) ? -1 : (value >= length) ? 1 : 0;
+            }
+
+        } // namespace
+
+        ChunkNeighborhood::ChunkNeighborhood()
+            : blocks_(VOLUME, 0),
+              light_(VOLUME, OPEN_SKY) {
+        }
+
+        void ChunkNeighborhood::gather(const Chunk& chunk) {
+            gatherInterior(chunk);
+
+            forEachShellCell([this](int32_t x, int32_t y, int32_t z) {
+                set(getIndex(x, y, z), 0, OPEN_SKY);
+            });
+        }
+
+        void ChunkNeighborhood::gather(const Chunk& chunk, const ChunkSnapshot::Neighbours& neighbours) {
+            gatherInterior(chunk);
+
+            forEachShellCell([this, &neighbours](int32_t x, int32_t y, int32_t z) {
+                // Edges and corners come from the diagonal neighbours
+                const int32_t dx = chunkOffset(x);
+                const int32_t dy = chunkOffset(y);
+                const int32_t dz = chunkOffset(z);
+
+                const size_t cell = getIndex(x, y, z);
+                const Chunk* neighbour = neighbours[ChunkSnapshot::getNeighbourIndex(dx, dy, dz)];
+                if (!neighbour) {
+                    set(cell, 0, OPEN_SKY);
+                    return;
+                }
+
+                const uint32_t lx = static_cast<uint32_t>(x - dx * length);
+                const uint32_t ly = static_cast<uint32_t>(y - dy * length);
+                const uint32_t lz = static_cast<uint32_t>(z - dz * length);
+
+                set(cell, neighbour->getVoxelUnchecked(lx, ly, lz).getId(),
+                    static_cast<uint8_t>((neighbour->getLightUnchecked(LightType::Sky, lx, ly, lz) << 4) | neighbour->getLightUnchecked(LightType::Block, lx, ly, lz)));
+            });
+        }
+
+        void ChunkNeighborhood::gather(const ChunkSnapshot& snapshot) {
+            gatherInterior(snapshot.getChunk());
+
+            forEachShellCell([this, &snapshot](int32_t x, int32_t y, int32_t z) {
+                set(getIndex(x, y, z), snapshot.getVoxel(x, y, z).getId(),
+                    static_cast<uint8_t>((snapshot.getLight(LightType::Sky, x, y, z) << 4) | snapshot.getLight(LightType::Block, x, y, z)));
+            });
+        }
+
+        void ChunkNeighborhood::gatherInterior(const Chunk& chunk) {
+            // Resolve the palette once rather than once per voxel
+            const PaletteStorage<Voxel>& storage = chunk.getStorage();
+            std::vector<uint16_t> ids;
+            ids.reserve(storage.getPaletteSize());
+            for (const Voxel& voxel : storage.getPalette()) {
+                ids.push_back(voxel.getId());
+            }
+
+            const Chunk::LightStorage& sky = chunk.getLightStorage(LightType::Sky);
+            const Chunk::LightStorage& block = chunk.getLightStorage(LightType::Block);
+
+            // A uniform chunk is a single palette entry, no need to decode every voxel
+            if (storage.isUniform()) {
+                const uint16_t id = ids[storage.getIndex(0)];
+                for (int32_t z = 0; z < length; ++z) {
+                    for (int32_t y = 0; y < length; ++y) {
+                        std::fill_n(blocks_.begin() + getIndex(0, y, z), length, id);
+                    }
+                }
+            }
+            else {
+                size_t index = 0;
+                for (int32_t z = 0; z < length; ++z) {
+                    for (int32_t y = 0; y < length; ++y) {
+                        uint16_t* row = blocks_.data() + getIndex(0, y, z);
+                        for (int32_t x = 0; x < length; ++x, ++index) {
+                            row[x] = ids[storage.getIndex(index)];
+                        }
+                    }
+                }
+            }
+
+            size_t index = 0;
+            for (int32_t z = 0; z < length; ++z) {
+                for (int32_t y = 0; y < length; ++y) {
+                    uint8_t* row = light_.data() + getIndex(0, y, z);
+                    for (int32_t x = 0; x < length; ++x, ++index) {
+                        row[x] = static_cast<uint8_t>((sky.get(index) << 4) | block.get(index));
+                    }
+                }
+            }
+        }
+
+    } // namespace Voxel
+} // namespace Gem
@@ -0,0 +1,49 @@
+#include <Gem/Voxel/chunk_pool.h>
+
+namespace Gem {
+    namespace Voxel {
+
+        ChunkPool::ChunkPool(size_t chunksPerBlock)
+            : chunksPerBlock_(chunksPerBlock > 0 ? chunksPerBlock : 1) {
+        }
+
+        Chunk* ChunkPool::acquire() {
+            if (free_.empty()) {
+                blocks_.push_back(std::make_unique<Chunk[]>(chunksPerBlock_));
+
+                Chunk* block = blocks_.back().get();
+                free_.reserve(free_.size() + chunksPerBlock_);
+
+                // Push in reverse so chunks are handed out in address order
+                for (size_t i = chunksPerBlock_; i > 0; --i) {
+                    free_.push_back(&block[i - 1]);
+                }
+            }
+
+            Chunk* chunk = free_.back();
+            free_.pop_back();
+
+            chunk->fill(Voxel());
+            return chunk;
+        }
+
+        void ChunkPool::release(Chunk* chunk) {
+            if (!chunk) {
+                return;
+            }
+
+            // Drop the voxel data now rather than when the chunk is reused
+            chunk->fill(Voxel());
+            free_.push_back(chunk);
+        }
+
+        size_t ChunkPool::getUsedCount() const noexcept {
+            return getCapacity() - free_.size();
+        }
+
+        size_t ChunkPool::getCapacity() const noexcept {
+            return blocks_.size() * chunksPerBlock_;
+        }
+
+    } // namespace Voxel
+} // namespace Gem
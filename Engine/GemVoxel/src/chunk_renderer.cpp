@@ -0,0 +1,109 @@
+#include <Gem/Voxel/chunk_renderer.h>
+
+namespace Gem {
+    namespace Voxel {
+
+        ChunkRenderer::ChunkRenderer()
+            : VAO_(),
+            shapeVAO_(),
+            VBO_(GL_ARRAY_BUFFER),
+            IBO_(GL_ELEMENT_ARRAY_BUFFER),
+            shapeVBO_(GL_ARRAY_BUFFER),
+            shapeIBO_(GL_ELEMENT_ARRAY_BUFFER) {
+        }
+
+        ChunkRenderer::~ChunkRenderer() {
+            cleanup();
+        }
+
+        void ChunkRenderer::initialize() {
+            VAO_.generate();
+            VBO_.generate();
+            IBO_.generate();
+            shapeVAO_.generate();
+            shapeVBO_.generate();
+            shapeIBO_.generate();
+
+            // Allocate empty storage so the attributes can be linked before the first upload
+            VAO_.bind();
+            VBO_.set_data(0, nullptr, GL_DYNAMIC_DRAW);
+            IBO_.set_data(0, nullptr, GL_DYNAMIC_DRAW);
+
+            // Packed cube vertex (location = 0), decoded by chunk.vert, see ChunkVertex
+            VAO_.link_attrib_integer(VBO_, 0, 1, GL_UNSIGNED_INT, sizeof(uint32_t), (void*)0);
+            VAO_.unbind();
+
+            shapeVAO_.bind();
+            shapeVBO_.set_data(0, nullptr, GL_DYNAMIC_DRAW);
+            shapeIBO_.set_data(0, nullptr, GL_DYNAMIC_DRAW);
+
+            // Packed shape vertex (location = 0), decoded by chunk_shape.vert, see ShapeVertex
+            shapeVAO_.link_attrib_integer(shapeVBO_, 0, 2, GL_UNSIGNED_INT, sizeof(ShapeVertex), (void*)0);
+            shapeVAO_.unbind();
+
+            is_initialized_ = true;
+        }
+
+        void ChunkRenderer::upload(const ChunkMesh& mesh) {
+            if (!is_initialized_) {
+                initialize();
+            }
+
+            // The element buffer binding is part of the VAO state
+            VAO_.bind();
+            VBO_.set_data(mesh.vertices.size() * sizeof(uint32_t), mesh.vertices.data(), GL_DYNAMIC_DRAW);
+            IBO_.set_data(mesh.indices.size() * sizeof(GLuint), mesh.indices.data(), GL_DYNAMIC_DRAW);
+            VAO_.unbind();
+
+            shapeVAO_.bind();
+            shapeVBO_.set_data(mesh.shapeVertices.size() * sizeof(ShapeVertex), mesh.shapeVertices.data(), GL_DYNAMIC_DRAW);
+            shapeIBO_.set_data(mesh.shapeIndices.size() * sizeof(GLuint), mesh.shapeIndices.data(), GL_DYNAMIC_DRAW);
+            shapeVAO_.unbind();
+
+            indexCount_ = static_cast<GLsizei>(mesh.indices.size());
+            shapeIndexCount_ = static_cast<GLsizei>(mesh.shapeIndices.size());
+        }
+
+        void ChunkRenderer::render() const {
+            if (indexCount_ == 0) {
+                return;
+            }
+
+            VAO_.bind();
+            Gem::GL::draw_elements(GL_TRIANGLES, indexCount_, GL_UNSIGNED_INT, 0);
+            VAO_.unbind();
+        }
+
+        void ChunkRenderer::renderShapes() const {
+            if (shapeIndexCount_ == 0) {
+                return;
+            }
+
+            shapeVAO_.bind();
+            Gem::GL::draw_elements(GL_TRIANGLES, shapeIndexCount_, GL_UNSIGNED_INT, 0);
+            shapeVAO_.unbind();
+        }
+
+        void ChunkRenderer::cleanup() {
+            VAO_.cleanup();
+            VBO_.cleanup();
+            IBO_.cleanup();
+            shapeVAO_.cleanup();
+            shapeVBO_.cleanup();
+            shapeIBO_.cleanup();
+
+            indexCount_ = 0;
+            shapeIndexCount_ = 0;
+            is_initialized_ = false;
+        }
+
+        GLsizei ChunkRenderer::getIndexCount() const noexcept {
+            return indexCount_;
+        }
+
+        GLsizei ChunkRenderer::getShapeIndexCount() const noexcept {
+            return shapeIndexCount_;
+        }
+
+    } // namespace Voxel
+} // namespace Gem
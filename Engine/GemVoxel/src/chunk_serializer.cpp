@@ -0,0 +1,171 @@
+#include <Gem/Voxel/chunk_serializer.h>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+namespace Gem {
+    namespace Voxel {
+
+        static_assert(std::endian::native == std::endian::little, "Chunk payloads are stored little-endian.");
+
+        namespace {
+
+            constexpr size_t HEADER_SIZE = 4;   // Format version, encoding, palette size
+            constexpr size_t RUN_SIZE = 4;      // Palette index, run length
+
+            template<typename T>
+            void append(std::vector<uint8_t>& payload, const T& value) {
+                const size_t offset = payload.size();
+                payload.resize(offset + sizeof(T));
+                std::memcpy(payload.data() + offset, &value, sizeof(T));
+            }
+
+            template<typename T>
+            T read(const uint8_t* data) {
+                T value;
+                std::memcpy(&value, data, sizeof(T));
+                return value;
+            }
+
+        } // namespace
+
+        void ChunkSerializer::encode(const Chunk& chunk, std::vector<uint8_t>& payload) {
+            const PaletteStorage<Voxel>& storage = chunk.getStorage();
+            const std::vector<Voxel>& palette = storage.getPalette();
+            const std::vector<uint64_t> words = storage.getPackedIndices();
+            const uint32_t volume = Chunk::getVolume();
+
+            // Count the runs first to pick the smaller encoding
+            size_t runs = 0;
+            if (!storage.isUniform()) {
+                uint32_t previous = UINT32_MAX;
+                for (uint32_t i = 0; i < volume; ++i) {
+                    const uint32_t entry = storage.getIndex(i);
+                    runs += (entry != previous) ? 1 : 0;
+                    previous = entry;
+                }
+            }
+
+            const size_t packedBytes = words.size() * sizeof(uint64_t);
+            const size_t runBytes = runs * RUN_SIZE;
+
+            Encoding encoding = Encoding::Uniform;
+            if (!storage.isUniform()) {
+                encoding = (runBytes < packedBytes) ? Encoding::Runs : Encoding::Packed;
+            }
+
+            payload.clear();
+            payload.reserve(HEADER_SIZE + palette.size() * sizeof(uint16_t) + ((encoding == Encoding::Runs) ? runBytes : packedBytes));
+
+            append(payload, FORMAT_VERSION);
+            append(payload, static_cast<uint8_t>(encoding));
+            append(payload, static_cast<uint16_t>(palette.size()));
+
+            for (const Voxel& voxel : palette) {
+                append(payload, voxel.getId());
+            }
+
+            if (encoding == Encoding::Packed) {
+                const size_t offset = payload.size();
+                payload.resize(offset + packedBytes);
+                std::memcpy(payload.data() + offset, words.data(), packedBytes);
+            }
+            else if (encoding == Encoding::Runs) {
+                uint32_t start = 0;
+                while (start < volume) {
+                    const uint32_t entry = storage.getIndex(start);
+
+                    uint32_t end = start + 1;
+                    while (end < volume && storage.getIndex(end) == entry) {
+                        ++end;
+                    }
+
+                    // A run never exceeds the volume, so the length fits 16 bits once offset by one
+                    append(payload, static_cast<uint16_t>(entry));
+                    append(payload, static_cast<uint16_t>(end - start - 1));
+                    start = end;
+                }
+            }
+        }
+
+        bool ChunkSerializer::decode(const uint8_t* data, size_t size, Chunk& chunk) {
+            if (size < HEADER_SIZE || data[0] != FORMAT_VERSION) {
+                return false;
+            }
+
+            const Encoding encoding = static_cast<Encoding>(data[1]);
+            const size_t paletteSize = read<uint16_t>(data + 2);
+            const uint32_t volume = Chunk::getVolume();
+
+            if (paletteSize == 0 || size < HEADER_SIZE + paletteSize * sizeof(uint16_t)) {
+                return false;
+            }
+
+            std::vector<Voxel> palette(paletteSize);
+            for (size_t entry = 0; entry < paletteSize; ++entry) {
+                palette[entry] = Voxel(read<uint16_t>(data + HEADER_SIZE + entry * sizeof(uint16_t)));
+            }
+
+            const uint8_t* body = data + HEADER_SIZE + paletteSize * sizeof(uint16_t);
+            const size_t bodySize = size - (body - data);
+
+            const uint8_t bits = PaletteStorage<Voxel>::bitsFor(paletteSize);
+            const size_t wordCount = (bits > 0) ? (size_t(volume) * bits + 63) / 64 : 0;
+            std::vector<uint64_t> words(wordCount, 0);
+
+            switch (encoding) {
+            case Encoding::Uniform:
+                if (paletteSize != 1 || bodySize != 0) {
+                    return false;
+                }
+                break;
+
+            case Encoding::Packed:
+                if (bodySize != wordCount * sizeof(uint64_t)) {
+                    return false;
+                }
+                std::memcpy(words.data(), body, bodySize);
+                break;
+
+            case Encoding::Runs: {
+                if (bits == 0 || bodySize % RUN_SIZE != 0) {
+                    return false;
+                }
+
+                size_t index = 0;
+                for (size_t offset = 0; offset < bodySize; offset += RUN_SIZE) {
+                    const uint64_t entry = read<uint16_t>(body + offset);
+                    const size_t length = size_t(read<uint16_t>(body + offset + 2)) + 1;
+
+                    if (entry >= paletteSize || index + length > volume) {
+                        return false;
+                    }
+
+                    for (const size_t end = index + length; index < end; ++index) {
+                        const size_t bit = index * bits;
+                        words[bit >> 6] |= entry << (bit & 63);
+                    }
+                }
+
+                if (index != volume) {
+                    return false;
+                }
+                break;
+            }
+
+            default:
+                return false;
+            }
+
+            try {
+                chunk.assign(std::move(palette), std::move(words));
+            }
+            catch (const std::invalid_argument&) {
+                return false;
+            }
+
+            return true;
+        }
+
+    } // namespace Voxel
+} // namespace Gem
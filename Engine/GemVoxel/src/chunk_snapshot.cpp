@@ -0,0 +1,121 @@
+#include <Gem/Voxel/chunk_snapshot.h>
+
+namespace Gem {
+    namespace Voxel {
+
+        namespace {
+
+            constexpr int32_t length = static_cast<int32_t>(CHUNK_BOUNDARY);
+            constexpr int32_t padded = length + 2;
+
+            /**
+             * @brief Maps a face and two in-layer coordinates, from -1 to length, to chunk-local coordinates.
+             */
+            void layerToLocal(Face face, int32_t a, int32_t b, int32_t& x, int32_t& y, int32_t& z) {
+                switch (face) {
+                case Face::PosX: x = length; y = a; z = b; break;
+                case Face::NegX: x = -1;     y = a; z = b; break;
+                case Face::PosY: x = a; y = length; z = b; break;
+                case Face::NegY: x = a; y = -1;     z = b; break;
+                case Face::PosZ: x = a; y = b; z = length; break;
+                case Face::NegZ: x = a; y = b; z = -1;     break;
+                }
+            }
+
+            /**
+             * @brief Gets the chunk offset of a chunk-local coordinate, from -1 to 1.
+             */
+            inline int32_t chunkOffset(int32_t value) noexcept {
+                return (value < 0) ? -1 : (value >= length) ? 1 : 0;
+            }
+
+        } // namespace
+
+        ChunkSnapshot::ChunkSnapshot(const ChunkCoord& coord, const Chunk& chunk, const Neighbours& neighbours)
+            : coord_(coord), chunk_(chunk) {
+
+            for (size_t f = 0; f < FACE_COUNT; ++f) {
+                std::vector<Voxel>& layer = layers_[f];
+                std::vector<uint8_t>& lightLayer = lightLayers_[f];
+                layer.assign(padded * padded, Voxel());
+                lightLayer.assign(padded * padded, static_cast<uint8_t>(MAX_LIGHT << 4));
+
+                for (int32_t b = -1; b <= length; ++b) {
+                    for (int32_t a = -1; a <= length; ++a) {
+                        int32_t x, y, z;
+                        layerToLocal(static_cast<Face>(f), a, b, x, y, z);
+
+                        // Edges and corners come from the diagonal neighbours
+                        const int32_t dx = chunkOffset(x);
+                        const int32_t dy = chunkOffset(y);
+                        const int32_t dz = chunkOffset(z);
+
+                        const Chunk* neighbour = neighbours[getNeighbourIndex(dx, dy, dz)];
+                        if (!neighbour) {
+                            continue;
+                        }
+
+                        const uint32_t lx = static_cast<uint32_t>(x - dx * length);
+                        const uint32_t ly = static_cast<uint32_t>(y - dy * length);
+                        const uint32_t lz = static_cast<uint32_t>(z - dz * length);
+
+                        const size_t cell = (a + 1) + (b + 1) * padded;
+                        layer[cell] = neighbour->getVoxelUnchecked(lx, ly, lz);
+                        lightLayer[cell] = static_cast<uint8_t>((neighbour->getLightUnchecked(LightType::Sky, lx, ly, lz) << 4) | neighbour->getLightUnchecked(LightType::Block, lx, ly, lz));
+                    }
+                }
+            }
+        }
+
+        Voxel ChunkSnapshot::getVoxel(int32_t x, int32_t y, int32_t z) const {
+            size_t layer, cell;
+            if (!locate(x, y, z, layer, cell)) {
+                return chunk_.getVoxel(x, y, z);
+            }
+            return layers_[layer][cell];
+        }
+
+        uint8_t ChunkSnapshot::getLight(LightType type, int32_t x, int32_t y, int32_t z) const {
+            size_t layer, cell;
+            if (!locate(x, y, z, layer, cell)) {
+                return chunk_.getLight(type, x, y, z);
+            }
+
+            const uint8_t packed = lightLayers_[layer][cell];
+            return (type == LightType::Sky) ? packed >> 4 : packed & 0x0F;
+        }
+
+        const Chunk& ChunkSnapshot::getChunk() const noexcept {
+            return chunk_;
+        }
+
+        const ChunkCoord& ChunkSnapshot::getCoord() const noexcept {
+            return coord_;
+        }
+
+        uint64_t ChunkSnapshot::getVersion() const noexcept {
+            return chunk_.getVersion();
+        }
+
+        bool ChunkSnapshot::locate(int32_t x, int32_t y, int32_t z, size_t& layer, size_t& cell) noexcept {
+            Face face;
+            int32_t a, b;
+
+            // The first axis outside the chunk picks the layer, layerToLocal() fills them the same way
+            if (x < 0)            { face = Face::NegX; a = y; b = z; }
+            else if (x >= length) { face = Face::PosX; a = y; b = z; }
+            else if (y < 0)       { face = Face::NegY; a = x; b = z; }
+            else if (y >= length) { face = Face::PosY; a = x; b = z; }
+            else if (z < 0)       { face = Face::NegZ; a = x; b = y; }
+            else if (z >= length) { face = Face::PosZ; a = x; b = y; }
+            else {
+                return false;
+            }
+
+            layer = static_cast<size_t>(face);
+            cell = static_cast<size_t>((a + 1) + (b + 1) * padded);
+            return true;
+        }
+
+    } // namespace Voxel
+} // namespace Gem
@@ -0,0 +1,89 @@
+#include <Gem/Voxel/chunk_visibility.h>
+#include <algorithm>
+
+namespace Gem {
+    namespace Voxel {
+
+        void ChunkVisibilityGraph::set(const ChunkCoord& coord, ChunkVisibility visibility) {
+            chunks_[coord] = visibility;
+        }
+
+        void ChunkVisibilityGraph::remove(const ChunkCoord& coord) {
+            chunks_.erase(coord);
+        }
+
+        void ChunkVisibilityGraph::clear() noexcept {
+            chunks_.clear();
+        }
+
+        void ChunkVisibilityGraph::setRadius(int32_t horizontal, int32_t vertical) {
+            horizontalRadius_ = std::max(horizontal, 0);
+            verticalRadius_ = std::max(vertical, 0);
+        }
+
+        const std::vector<ChunkCoord>& ChunkVisibilityGraph::findVisible(const glm::vec3& position, const Filter& filter) {
+            const ChunkCoord center = ChunkCoord::fromWorld(position);
+
+            // Dense visited flags over the walk box, cheaper than hashing every neighbour
+            const int32_t width = 2 * horizontalRadius_ + 1;
+            const int32_t height = 2 * verticalRadius_ + 1;
+            visited_.assign(static_cast<size_t>(width) * height * width, 0);
+
+            const auto visit = [&](const ChunkCoord& coord) {
+                const int32_t x = coord.x - center.x + horizontalRadius_;
+                const int32_t y = coord.y - center.y + verticalRadius_;
+                const int32_t z = coord.z - center.z + horizontalRadius_;
+                if (x < 0 || x >= width || y < 0 || y >= height || z < 0 || z >= width) {
+                    return false;
+                }
+
+                uint8_t& flag = visited_[static_cast<size_t>(x) + (static_cast<size_t>(y) + static_cast<size_t>(z) * height) * width];
+                if (flag) {
+                    return false;
+                }
+                flag = 1;
+                return true;
+            };
+
+            queue_.clear();
+            visible_.clear();
+
+            visit(center);
+            queue_.push_back({ center, static_cast<uint8_t>(FACE_COUNT), 0 });
+
+            // The queue only grows, so a read index walks it breadth first
+            for (size_t next = 0; next < queue_.size(); ++next) {
+                const Node node = queue_[next];
+
+                auto it = chunks_.find(node.coord);
+                if (it != chunks_.end()) {
+                    visible_.push_back(node.coord);
+                }
+                const ChunkVisibility visibility = (it != chunks_.end()) ? it->second : ChunkVisibility::all();
+
+                for (uint8_t exit = 0; exit < FACE_COUNT; ++exit) {
+                    // Never come back towards the camera
+                    if (node.directions & (1u << (exit ^ 1))) {
+                        continue;
+                    }
+                    if (node.entry != FACE_COUNT && !visibility.canSee(static_cast<Face>(node.entry), static_cast<Face>(exit))) {
+                        continue;
+                    }
+
+                    const ChunkCoord neighbour = node.coord.neighbour(static_cast<Face>(exit));
+                    if (!visit(neighbour)) {
+                        continue;
+                    }
+                    if (filter && !filter(neighbour)) {
+                        continue;
+                    }
+
+                    queue_.push_back({ neighbour, static_cast<uint8_t>(exit ^ 1), static_cast<uint8_t>(node.directions | (1u << exit)) });
+                }
+            }
+
+            return visible_;
+        }
+
+    } // namespace Voxel
+} // namespace Gem
@@ -0,0 +1,279 @@
+#include <Gem/Voxel/fluid_simulation.h>
+#include <Gem/Voxel/world_view.h>
+#include <algorithm>
+
+namespace Gem {
+    namespace Voxel {
+
+        namespace {
+
+            constexpr int32_t length = CHUNK_BOUNDARY;
+
+            // Read in place of the voxels of chunks that are not loaded, an ID no block has
+            constexpr uint16_t UNLOADED = 0xFFFF;
+
+            // The four horizontal faces, in Face order
+            constexpr size_t SIDES[4] = { 0, 1, 4, 5 };
+
+            inline glm::ivec3 toLocal(uint16_t index) noexcept {
+                const auto [x, y, z] = Chunk::delinearizeUnchecked(index);
+                return glm::ivec3(x, y, z);
+            }
+
+        } // namespace
+
+        FluidSimulation::FluidSimulation(ChunkManager& world, const BlockRegistry& blocks, Gem::Core::JobSystem* jobs)
+            : world_(world), blocks_(blocks), jobs_(jobs) {
+        }
+
+        void FluidSimulation::onChunkLoaded(const ChunkCoord& coord) {
+            activateFluids(coord, glm::ivec3(0), glm::ivec3(length - 1));
+
+            // Fluid held back by the missing chunk can flow now
+            for (size_t f = 0; f < FACE_COUNT; ++f) {
+                const int axis = static_cast<int>(f / 2);
+                glm::ivec3 min(0);
+                glm::ivec3 max(length - 1);
+                min[axis] = max[axis] = (FACE_OFFSETS[f][axis] > 0) ? 0 : length - 1;
+
+                activateFluids(coord.neighbour(static_cast<Face>(f)), min, max);
+            }
+        }
+
+        void FluidSimulation::onVoxelChanged(const glm::ivec3& voxel, const Voxel&, const Voxel&) {
+            if (applying_) {
+                return;
+            }
+
+            // Any edit can open or close a way for the fluid around it
+            activateAround(voxel);
+        }
+
+        size_t FluidSimulation::tick() {
+            const uint64_t tick = ++stats_.totalTicks;
+
+            // Move the active cells into the change buffers, one region per loaded chunk
+            size_t count = 0;
+            for (auto& [coord, active] : active_) {
+                if (!world_.getChunk(coord)) {
+                    continue;
+                }
+
+                if (count == regions_.size()) {
+                    regions_.emplace_back();
+                }
+                Region& region = regions_[count++];
+                region.coord = coord;
+                region.cells.swap(active.cells);
+                region.changes.clear();
+                region.deferred.clear();
+            }
+            active_.clear();
+
+            // Evaluate every cell against the world as it is now, nothing is written yet
+            if (jobs_ && count > 1) {
+                jobs_->wait(jobs_->parallelFor(count, 1, [this, tick](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i) {
+                        evaluate(regions_[i], tick);
+                    }
+                }));
+            }
+            else {
+                for (size_t i = 0; i < count; ++i) {
+                    evaluate(regions_[i], tick);
+                }
+            }
+
+            // Then swap the new states in, waking up the cells that read them
+            size_t updates = 0;
+            size_t changes = 0;
+
+            applying_ = true;
+            for (size_t i = 0; i < count; ++i) {
+                Region& region = regions_[i];
+                const glm::ivec3 origin = region.coord.getOrigin();
+                updates += region.cells.size();
+
+                for (const auto& [cell, id] : region.changes) {
+                    const glm::ivec3 voxel = origin + toLocal(cell);
+                    if (world_.setVoxel(voxel, Voxel(id))) {
+                        activateAround(voxel);
+                        changed_.insert(region.coord);
+                        ++changes;
+                    }
+                }
+
+                for (uint16_t cell : region.deferred) {
+                    activate(origin + toLocal(cell));
+                }
+            }
+            applying_ = false;
+
+            stats_.totalUpdates += updates;
+            stats_.totalChanges += changes;
+            stats_.lastUpdates = updates;
+            stats_.lastChanges = changes;
+
+            return changes;
+        }
+
+        std::vector<ChunkCoord> FluidSimulation::takeChangedChunks() {
+            std::vector<ChunkCoord> chunks(changed_.begin(), changed_.end());
+            changed_.clear();
+            return chunks;
+        }
+
+        FluidSimulationStats FluidSimulation::getStats() const noexcept {
+            FluidSimulationStats stats = stats_;
+            stats.activeCells = 0;
+            for (const auto& [coord, active] : active_) {
+                stats.activeCells += active.cells.size();
+            }
+            return stats;
+        }
+
+        void FluidSimulation::activate(const glm::ivec3& voxel) {
+            const ChunkCoord coord = ChunkCoord::fromVoxel(voxel);
+            if (!world_.getChunk(coord)) {
+                return;
+            }
+
+            const glm::ivec3 local = voxel - coord.getOrigin();
+            const size_t index = Chunk::linearizeUnchecked(local.x, local.y, local.z);
+
+            ActiveChunk& active = active_[coord];
+            if (!active.flags.test(index)) {
+                active.flags.set(index);
+                active.cells.push_back(static_cast<uint16_t>(index));
+            }
+        }
+
+        void FluidSimulation::activateAround(const glm::ivec3& voxel) {
+            activate(voxel);
+
+            // The cells reading the voxel as a neighbour
+            for (size_t f = 0; f < FACE_COUNT; ++f) {
+                activate(voxel + glm::ivec3(FACE_OFFSETS[f][0], FACE_OFFSETS[f][1], FACE_OFFSETS[f][2]));
+            }
+
+            // and those reading it as the ground under a side neighbour, which decides whether it spreads
+            const glm::ivec3 above = voxel + glm::ivec3(0, 1, 0);
+            for (size_t side : SIDES) {
+                activate(above + glm::ivec3(FACE_OFFSETS[side][0], FACE_OFFSETS[side][1], FACE_OFFSETS[side][2]));
+            }
+        }
+
+        void FluidSimulation::activateFluids(const ChunkCoord& coord, const glm::ivec3& min, const glm::ivec3& max) {
+            const Chunk* chunk = world_.getChunk(coord);
+            if (!chunk) {
+                return;
+            }
+
+            // Most chunks hold no fluid at all, the palette tells without decoding a voxel
+            const std::vector<Voxel>& palette = chunk->getStorage().getPalette();
+            const bool hasFluid = std::any_of(palette.begin(), palette.end(), [this](const Voxel& voxel) {
+                return voxel.getId() < blocks_.getCount() && blocks_.getFluid(voxel.getId()) != BlockRegistry::AIR;
+            });
+            if (!hasFluid) {
+                return;
+            }
+
+            const glm::ivec3 origin = coord.getOrigin();
+            for (int32_t z = min.z; z <= max.z; ++z) {
+                for (int32_t y = min.y; y <= max.y; ++y) {
+                    for (int32_t x = min.x; x <= max.x; ++x) {
+                        const uint16_t id = chunk->getVoxelUnchecked(x, y, z).getId();
+                        if (id < blocks_.getCount() && blocks_.getFluid(id) != BlockRegistry::AIR) {
+                            activateAround(origin + glm::ivec3(x, y, z));
+                        }
+                    }
+                }
+            }
+        }
+
+        void FluidSimulation::evaluate(Region& region, uint64_t tick) const {
+            // Cells read one voxel around them, and the voxel below their sides, so never past the
+            // chunks around theirs, which the view keeps at hand
+            WorldView view(world_);
+            const glm::ivec3 origin = region.coord.getOrigin();
+
+            const auto read = [&view, &origin](const glm::ivec3& local) -> uint16_t {
+                const glm::ivec3 voxel = origin + local;
+                const Chunk* chunk = view.getChunk(WorldView::toChunk(voxel));
+                if (!chunk) {
+                    return UNLOADED;
+                }
+                return chunk->getStorage().get(WorldView::toIndex(voxel)).getId();
+            };
+
+            const size_t count = blocks_.getCount();
+            const auto fluidOf = [this, count](uint16_t id) -> uint16_t {
+                return (id < count) ? blocks_.getFluid(id) : BlockRegistry::AIR;
+            };
+
+            const glm::ivec3 up(0, 1, 0);
+
+            for (uint16_t cell : region.cells) {
+                const glm::ivec3 local = toLocal(cell);
+                const uint16_t id = read(local);
+                const uint16_t fluid = fluidOf(id);
+
+                // Fluids only flow into air and into their own flowing states, sources stay put
+                if ((id != BlockRegistry::AIR && fluid == BlockRegistry::AIR) || (fluid != BlockRegistry::AIR && blocks_.isFluidSource(id))) {
+                    continue;
+                }
+
+                uint16_t next = BlockRegistry::AIR;
+                uint16_t driver = fluid;
+
+                const uint16_t aboveFluid = fluidOf(read(local + up));
+                if (aboveFluid != BlockRegistry::AIR && (fluid == BlockRegistry::AIR || aboveFluid == fluid)) {
+                    next = BlockRegistry::getFluidBlock(aboveFluid, MAX_FLUID_LEVEL, true);
+                    driver = aboveFluid;
+                }
+                else {
+                    int32_t best = 0;
+                    for (size_t side : SIDES) {
+                        const glm::ivec3 offset(FACE_OFFSETS[side][0], FACE_OFFSETS[side][1], FACE_OFFSETS[side][2]);
+                        const uint16_t neighbour = read(local + offset);
+                        const uint16_t neighbourFluid = fluidOf(neighbour);
+                        if (neighbourFluid == BlockRegistry::AIR || (fluid != BlockRegistry::AIR && neighbourFluid != fluid)) {
+                            continue;
+                        }
+
+                        // Fluid over air or over itself falls rather than spreads
+                        if (!blocks_.isFluidSource(neighbour)) {
+                            const uint16_t ground = read(local + offset - up);
+                            if (ground == BlockRegistry::AIR || fluidOf(ground) == neighbourFluid) {
+                                continue;
+                            }
+                        }
+
+                        const int32_t level = int32_t(blocks_.getFluidLevel(neighbour)) - blocks_.getFluidDecay(neighbour);
+                        if (level > best) {
+                            best = level;
+                            driver = neighbourFluid;
+                        }
+                    }
+
+                    if (best > 0) {
+                        next = BlockRegistry::getFluidBlock(driver, static_cast<uint8_t>(best), false);
+                    }
+                }
+
+                if (next == id) {
+                    continue;
+                }
+
+                // Slower fluids only move every few ticks
+                if (driver != BlockRegistry::AIR && tick % blocks_.getFluidInterval(driver) != 0) {
+                    region.deferred.push_back(cell);
+                    continue;
+                }
+
+                region.changes.emplace_back(cell, next);
+            }
+        }
+
+    } // namespace Voxel
+} // namespace Gem
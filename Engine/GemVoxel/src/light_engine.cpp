@@ -0,0 +1,399 @@
+#include <Gem/Voxel/light_engine.h>
+#include <algorithm>
+#include <utility>
+
+namespace Gem {
+    namespace Voxel {
+
+        namespace {
+
+            // Neighbours are found by adding constant strides to storage indices
+            static_assert(Chunk::LayoutType::IS_LINEAR, "The light engine relies on the linear chunk layout.");
+
+            constexpr int32_t length = static_cast<int32_t>(CHUNK_BOUNDARY);
+            constexpr int32_t area = length * length;
+            constexpr int32_t top = length - 1;
+            constexpr int32_t STRIDES[3] = { 1, length, area };     // Index offset between neighbours along each axis
+
+            constexpr size_t NEG_Y = static_cast<size_t>(Face::NegY);
+
+            constexpr LightType LIGHT_TYPES[LIGHT_TYPE_COUNT] = { LightType::Sky, LightType::Block };
+
+            inline uint16_t toIndex(int32_t x, int32_t y, int32_t z) noexcept {
+                return static_cast<uint16_t>(x + y * length + z * area);
+            }
+
+            inline glm::ivec3 toLocal(uint16_t index) noexcept {
+                return { index % length, (index / length) % length, index / area };
+            }
+
+        } // namespace
+
+        LightEngine::LightEngine(ChunkManager& world)
+            : world_(world) {
+        }
+
+        void LightEngine::setBlockRegistry(const BlockRegistry* registry) noexcept {
+            registry_ = registry;
+        }
+
+        uint8_t LightEngine::getEmission(uint16_t id) const noexcept {
+            return (registry_ && id < registry_->getCount()) ? registry_->getEmissionTable()[id] : 0;
+        }
+
+        bool LightEngine::isOpaque(uint16_t id) const noexcept {
+            if (id == 0) {
+                return false;
+            }
+            return !registry_ || id >= registry_->getCount() || registry_->getOpaqueTable()[id] != 0;
+        }
+
+        bool LightEngine::isOpaque(const Chunk& chunk, uint16_t index) const {
+            // Storage and occupancy indices agree in the linear layout, so air is a single bit test
+            if (!chunk.getOccupancy().test(static_cast<size_t>(index))) {
+                return false;
+            }
+            return !registry_ || isOpaque(chunk.getStorage().get(index).getId());
+        }
+
+        bool LightEngine::isSealed(const Chunk& chunk) const {
+            if (!chunk.getOccupancy().isFull()) {
+                return false;
+            }
+
+            // The palette may still list blocks that are gone, which only costs the shortcut
+            const std::vector<Voxel>& palette = chunk.getStorage().getPalette();
+            return std::all_of(palette.begin(), palette.end(), [this](const Voxel& voxel) {
+                return voxel.isAir() || isOpaque(voxel.getId());
+            });
+        }
+
+        void LightEngine::onChunkLoaded(const ChunkCoord& coord) {
+            Chunk* chunk = world_.getChunk(coord);
+            if (!chunk) {
+                return;
+            }
+
+            for (LightType type : LIGHT_TYPES) {
+                chunk->getLightStorage(type).fill(0);
+            }
+
+            // The whole chunk is meshed after a load anyway
+            chunk->markSectionsDirty(Chunk::getAllSections());
+            changed_.insert(coord);
+
+            Chunk::LightStorage& sky = chunk->getLightStorage(LightType::Sky);
+            Chunk::LightStorage& block = chunk->getLightStorage(LightType::Block);
+
+            // Sky light falls straight down the columns open to the sky, or lit by the sky in the chunk above
+            const Chunk* above = world_.getChunk(coord.neighbour(Face::PosY));
+            const bool solid = isSealed(*chunk);
+
+            for (int32_t z = 0; z < length && !solid; ++z) {
+                for (int32_t x = 0; x < length; ++x) {
+                    if (above && above->getLightStorage(LightType::Sky).get(toIndex(x, 0, z)) != MAX_LIGHT) {
+                        continue;
+                    }
+
+                    for (int32_t y = top; y >= 0; --y) {
+                        const uint16_t index = toIndex(x, y, z);
+                        if (isOpaque(*chunk, index)) {
+                            break;
+                        }
+
+                        sky.set(index, MAX_LIGHT);
+                    }
+                }
+            }
+
+            // Only the lit voxels next to something darker have anything to spread
+            for (int32_t z = 0; z < length && !solid; ++z) {
+                for (int32_t y = 0; y < length; ++y) {
+                    for (int32_t x = 0; x < length; ++x) {
+                        const uint16_t index = toIndex(x, y, z);
+                        if (sky.get(index) != MAX_LIGHT) {
+                            continue;
+                        }
+
+                        const bool border = x == 0 || x == top || y == 0 || z == 0 || z == top;
+                        if (border || sky.get(index - 1) != MAX_LIGHT || sky.get(index + 1) != MAX_LIGHT
+                            || sky.get(index - area) != MAX_LIGHT || sky.get(index + area) != MAX_LIGHT) {
+                            addQueue_.push_back({ chunk, coord, index, 0 });
+                        }
+                    }
+                }
+            }
+
+            // Columns of the chunk below that were open to the sky may now be covered
+            if (Chunk* below = world_.getChunk(coord.neighbour(Face::NegY))) {
+                const ChunkCoord belowCoord = coord.neighbour(Face::NegY);
+                const Chunk::LightStorage& belowSky = below->getLightStorage(LightType::Sky);
+
+                for (int32_t z = 0; z < length; ++z) {
+                    for (int32_t x = 0; x < length; ++x) {
+                        const uint16_t index = toIndex(x, top, z);
+                        if (belowSky.get(index) == MAX_LIGHT && sky.get(toIndex(x, 0, z)) != MAX_LIGHT) {
+                            const Node node{ below, belowCoord, index, MAX_LIGHT };
+                            setLevel(LightType::Sky, node, 0);
+                            removeQueue_.push_back(node);
+                        }
+                    }
+                }
+            }
+
+            // Only scan for emitters if the palette holds any
+            const std::vector<Voxel>& palette = chunk->getStorage().getPalette();
+            const bool emits = std::any_of(palette.begin(), palette.end(), [this](const Voxel& voxel) {
+                return getEmission(voxel.getId()) > 0;
+            });
+
+            for (uint16_t index = 0; emits && index < Chunk::getVolume(); ++index) {
+                const uint8_t level = getEmission(chunk->getStorage().get(index).getId());
+                if (level > 0) {
+                    block.set(index, level);
+                    blockQueue_.push_back({ chunk, coord, index, 0 });
+                }
+            }
+
+            removeLight(LightType::Sky);
+
+            // Light of the neighbours flows in through the shared borders
+            for (size_t f = 0; f < FACE_COUNT; ++f) {
+                const ChunkCoord neighbourCoord = coord.neighbour(static_cast<Face>(f));
+                Chunk* neighbour = world_.getChunk(neighbourCoord);
+                if (!neighbour) {
+                    continue;
+                }
+
+                const int axis = static_cast<int>(f / 2);
+                const int u = (axis + 1) % 3;
+                const int v = (axis + 2) % 3;
+
+                glm::ivec3 local(0);
+                local[axis] = (FACE_OFFSETS[f][axis] > 0) ? 0 : top;
+
+                for (local[v] = 0; local[v] < length; ++local[v]) {
+                    for (local[u] = 0; local[u] < length; ++local[u]) {
+                        const uint16_t index = toIndex(local.x, local.y, local.z);
+                        if (neighbour->getLightStorage(LightType::Sky).get(index) > 1) {
+                            addQueue_.push_back({ neighbour, neighbourCoord, index, 0 });
+                        }
+                        if (neighbour->getLightStorage(LightType::Block).get(index) > 1) {
+                            blockQueue_.push_back({ neighbour, neighbourCoord, index, 0 });
+                        }
+                    }
+                }
+            }
+
+            propagate(LightType::Sky);
+
+            std::swap(addQueue_, blockQueue_);
+            propagate(LightType::Block);
+
+            ++stats_.totalChunksLit;
+        }
+
+        void LightEngine::onVoxelChanged(const glm::ivec3& voxel, const Voxel& previous, const Voxel& value) {
+            const ChunkCoord coord = ChunkCoord::fromVoxel(voxel);
+            Chunk* chunk = world_.getChunk(coord);
+            if (!chunk) {
+                return;
+            }
+
+            // Light only depends on which voxels stop it and which glow, so a swap keeping both changes nothing
+            if (isOpaque(previous.getId()) == isOpaque(value.getId()) && getEmission(previous.getId()) == getEmission(value.getId())) {
+                return;
+            }
+
+            const glm::ivec3 local = voxel - coord.getOrigin();
+            const Node node{ chunk, coord, toIndex(local.x, local.y, local.z), 0 };
+
+            for (LightType type : LIGHT_TYPES) {
+                // Remove the light the voxel had, and everything it lit
+                const uint8_t level = chunk->getLightStorage(type).get(node.index);
+                if (level > 0) {
+                    setLevel(type, node, 0);
+                    removeQueue_.push_back({ chunk, coord, node.index, level });
+                    removeLight(type);
+                }
+
+                // Then let the voxel glow, and the light around it flow back in
+                const uint8_t source = getSourceLevel(type, node);
+                if (source > 0) {
+                    setLevel(type, node, source);
+                    addQueue_.push_back(node);
+                }
+
+                if (!isOpaque(value.getId())) {
+                    for (size_t f = 0; f < FACE_COUNT; ++f) {
+                        Node neighbour;
+                        if (step(node, f, neighbour) && neighbour.chunk->getLightStorage(type).get(neighbour.index) > 0) {
+                            addQueue_.push_back(neighbour);
+                        }
+                    }
+                }
+
+                propagate(type);
+            }
+
+            ++stats_.totalEdits;
+        }
+
+        uint8_t LightEngine::getLight(LightType type, const glm::ivec3& voxel) const {
+            const ChunkCoord coord = ChunkCoord::fromVoxel(voxel);
+            const Chunk* chunk = world_.getChunk(coord);
+            if (!chunk) {
+                return (type == LightType::Sky) ? MAX_LIGHT : 0;
+            }
+
+            const glm::ivec3 local = voxel - coord.getOrigin();
+            return chunk->getLightStorage(type).get(toIndex(local.x, local.y, local.z));
+        }
+
+        std::vector<ChunkCoord> LightEngine::takeChangedChunks() {
+            std::vector<ChunkCoord> chunks(changed_.begin(), changed_.end());
+            changed_.clear();
+            return chunks;
+        }
+
+        LightEngineStats LightEngine::getStats() const noexcept {
+            return stats_;
+        }
+
+        bool LightEngine::step(const Node& from, size_t face, Node& to) const {
+            // Walk the index directly, it is only split into coordinates along the axis of the face
+            const int32_t stride = STRIDES[face / 2];
+            const int32_t position = (from.index / stride) % length;
+            const bool positive = (face & 1) == 0;
+
+            if (positive ? position < top : position > 0) {
+                to.chunk = from.chunk;
+                to.coord = from.coord;
+                to.index = static_cast<uint16_t>(positive ? from.index + stride : from.index - stride);
+            }
+            else {
+                to.coord = from.coord.neighbour(static_cast<Face>(face));
+                to.chunk = world_.getChunk(to.coord);
+                if (!to.chunk) {
+                    return false;
+                }
+                to.index = static_cast<uint16_t>(positive ? from.index - stride * top : from.index + stride * top);
+            }
+
+            to.level = 0;
+            return true;
+        }
+
+        uint8_t LightEngine::getSourceLevel(LightType type, const Node& node) const {
+            const Voxel voxel = node.chunk->getStorage().get(node.index);
+
+            if (type == LightType::Block) {
+                return getEmission(voxel.getId());
+            }
+
+            // Voxels letting light through on top of a chunk with nothing loaded above are under the open sky
+            if (!isOpaque(voxel.getId()) && node.index / length % length == top && !world_.getChunk(node.coord.neighbour(Face::PosY))) {
+                return MAX_LIGHT;
+            }
+            return 0;
+        }
+
+        void LightEngine::markChanged(const Node& node) {
+            // The faces showing this light belong to the solid voxels around it
+            const glm::ivec3 local = toLocal(node.index);
+            node.chunk->markRegionDirty(local - 1, local + 1);
+            changed_.insert(node.coord);
+
+            for (size_t f = 0; f < FACE_COUNT; ++f) {
+                const int axis = static_cast<int>(f / 2);
+                const int32_t border = (FACE_OFFSETS[f][axis] > 0) ? top : 0;
+                if (local[axis] != border) {
+                    continue;
+                }
+
+                const ChunkCoord coord = node.coord.neighbour(static_cast<Face>(f));
+                if (Chunk* neighbour = world_.getChunk(coord)) {
+                    glm::ivec3 facing = local;
+                    facing[axis] = top - border;
+                    neighbour->markRegionDirty(facing, facing);
+                    changed_.insert(coord);
+                }
+            }
+        }
+
+        void LightEngine::setLevel(LightType type, const Node& node, uint8_t level) {
+            node.chunk->getLightStorage(type).set(node.index, level);
+            markChanged(node);
+        }
+
+        void LightEngine::removeLight(LightType type) {
+            for (size_t head = 0; head < removeQueue_.size(); ++head) {
+                const Node node = removeQueue_[head];
+
+                for (size_t f = 0; f < FACE_COUNT; ++f) {
+                    Node neighbour;
+                    if (!step(node, f, neighbour)) {
+                        continue;
+                    }
+
+                    const uint8_t level = neighbour.chunk->getLightStorage(type).get(neighbour.index);
+                    if (level == 0) {
+                        continue;
+                    }
+
+                    // Dimmer voxels, and sky light falling straight down, were lit by the removed voxel
+                    const bool fell = type == LightType::Sky && f == NEG_Y && node.level == MAX_LIGHT && level == MAX_LIGHT;
+                    if (level < node.level || fell) {
+                        setLevel(type, neighbour, 0);
+                        neighbour.level = level;
+                        removeQueue_.push_back(neighbour);
+                        ++stats_.totalRemoved;
+
+                        // A voxel producing light by itself lights up again
+                        const uint8_t source = getSourceLevel(type, neighbour);
+                        if (source > 0) {
+                            setLevel(type, neighbour, source);
+                            addQueue_.push_back(neighbour);
+                        }
+                    }
+                    else {
+                        // Lit from elsewhere, it spreads back into the darkened area
+                        addQueue_.push_back(neighbour);
+                    }
+                }
+            }
+
+            removeQueue_.clear();
+        }
+
+        void LightEngine::propagate(LightType type) {
+            for (size_t head = 0; head < addQueue_.size(); ++head) {
+                const Node node = addQueue_[head];
+                ++stats_.totalAdded;
+
+                // Read the level now, it may have been raised or removed since the voxel was queued
+                const uint8_t level = node.chunk->getLightStorage(type).get(node.index);
+                if (level <= 1) {
+                    continue;
+                }
+
+                for (size_t f = 0; f < FACE_COUNT; ++f) {
+                    Node neighbour;
+                    if (!step(node, f, neighbour)) {
+                        continue;
+                    }
+
+                    // Compare the levels first, they are cheaper to read than the voxel
+                    const uint8_t target = (type == LightType::Sky && f == NEG_Y && level == MAX_LIGHT) ? MAX_LIGHT : level - 1;
+                    if (neighbour.chunk->getLightStorage(type).get(neighbour.index) < target && !isOpaque(*neighbour.chunk, neighbour.index)) {
+                        setLevel(type, neighbour, target);
+                        addQueue_.push_back(neighbour);
+                    }
+                }
+            }
+
+            addQueue_.clear();
+        }
+
+    } // namespace Voxel
+} // namespace Gem
@@ -0,0 +1,266 @@
+#include <Gem/Voxel/physics.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+
+namespace Gem {
+    namespace Voxel {
+
+        namespace {
+
+            // Positions reached by a clipped move are only as exact as float arithmetic, so a box is
+            // considered touching a face, rather than crossing it, within this distance
+            constexpr float EPSILON = 1e-3f;
+
+            // How far below a box ground is looked for
+            constexpr float GROUND_PROBE = 1.0f / 64.0f;
+
+            // Bodies per job in Physics::step()
+            constexpr size_t STEP_BATCH = 64;
+
+            inline int32_t floorToInt(float value) noexcept {
+                return static_cast<int32_t>(std::floor(value));
+            }
+
+            inline int32_t ceilToInt(float value) noexcept {
+                return static_cast<int32_t>(std::ceil(value));
+            }
+
+        } // namespace
+
+        Physics::Physics(const ChunkManager& world, const BlockRegistry* blocks)
+            : world_(world), blocks_(blocks) {
+
+            // Full cubes, and voxels of unknown or unloaded blocks, use the first box
+            boxes_.push_back({ glm::vec3(0.0f), glm::vec3(1.0f) });
+
+            if (!blocks_) {
+                return;
+            }
+
+            const size_t count = blocks_->getCount();
+            firstBox_.resize(count + 1);
+
+            for (size_t id = 0; id < count; ++id) {
+                firstBox_[id] = static_cast<uint32_t>(boxes_.size());
+                if (id == BlockRegistry::AIR || !blocks_->isSolid(static_cast<uint16_t>(id))) {
+                    continue;
+                }
+
+                for (const ShapeBox& box : blocks_->getShape(static_cast<uint16_t>(id)).getBoxes()) {
+                    boxes_.push_back({ glm::vec3(box.min) / float(SHAPE_RESOLUTION), glm::vec3(box.max) / float(SHAPE_RESOLUTION) });
+                }
+            }
+            firstBox_[count] = static_cast<uint32_t>(boxes_.size());
+        }
+
+        glm::vec3 Physics::move(PhysicsBody& body, const glm::vec3& displacement) const {
+            WorldView view(world_);
+
+            const glm::vec3 half(body.size.x * 0.5f, 0.0f, body.size.z * 0.5f);
+            const glm::vec3 startMin = body.position - half;
+            const glm::vec3 startMax = body.position + glm::vec3(half.x, body.size.y, half.z);
+
+            glm::vec3 min = startMin;
+            glm::vec3 max = startMax;
+            glm::vec3 moved = sweepAll(min, max, displacement, view);
+
+            // Stopped sideways while walking: try again from a step higher, and keep whichever went further
+            const bool landed = displacement.y < 0.0f && moved.y != displacement.y;
+            const bool blocked = moved.x != displacement.x || moved.z != displacement.z;
+            if (body.stepHeight > 0.0f && blocked && (body.onGround || landed)) {
+                glm::vec3 stepMin = startMin;
+                glm::vec3 stepMax = startMax;
+
+                const float up = sweep(1, stepMin, stepMax, body.stepHeight, view);
+                stepMin.y += up;
+                stepMax.y += up;
+
+                for (int axis : { 0, 2 }) {
+                    const float delta = sweep(axis, stepMin, stepMax, displacement[axis], view);
+                    stepMin[axis] += delta;
+                    stepMax[axis] += delta;
+                }
+
+                const float down = sweep(1, stepMin, stepMax, std::min(displacement.y, 0.0f) - up, view);
+                stepMin.y += down;
+                stepMax.y += down;
+
+                const glm::vec3 stepped = stepMin - startMin;
+                if (stepped.x * stepped.x + stepped.z * stepped.z > moved.x * moved.x + moved.z * moved.z) {
+                    min = stepMin;
+                    max = stepMax;
+                    moved = stepped;
+                }
+            }
+
+            body.position += moved;
+            body.collided = glm::notEqual(moved, displacement);
+            body.onGround = displacement.y <= 0.0f && sweep(1, min, max, -GROUND_PROBE, view) > -GROUND_PROBE;
+
+            return moved;
+        }
+
+        void Physics::step(std::vector<PhysicsBody>& bodies, float seconds, Gem::Core::JobSystem* jobs) {
+            const auto start = std::chrono::steady_clock::now();
+
+            std::atomic<size_t> skipped{ 0 };
+            const auto stepRange = [this, &bodies, &skipped, seconds](size_t begin, size_t end) {
+                size_t frozen = 0;
+                for (size_t i = begin; i < end; ++i) {
+                    PhysicsBody& body = bodies[i];
+                    if (!world_.getChunk(ChunkCoord::fromWorld(body.position))) {
+                        ++frozen;
+                        continue;
+                    }
+
+                    body.velocity += gravity_ * seconds;
+                    move(body, body.velocity * seconds);
+
+                    for (int axis = 0; axis < 3; ++axis) {
+                        if (body.collided[axis]) {
+                            body.velocity[axis] = 0.0f;
+                        }
+                    }
+                }
+                skipped += frozen;
+            };
+
+            if (jobs && bodies.size() > STEP_BATCH) {
+                jobs->wait(jobs->parallelFor(bodies.size(), STEP_BATCH, stepRange));
+            }
+            else {
+                stepRange(0, bodies.size());
+            }
+
+            const double millis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            ++stats_.totalSteps;
+            stats_.totalBodies += bodies.size();
+            stats_.lastBodies = bodies.size();
+            stats_.lastSkipped = skipped;
+            stats_.lastMillis = millis;
+            stats_.bodiesPerMillisecond = (millis > 0.0) ? bodies.size() / millis : 0.0;
+        }
+
+        bool Physics::overlaps(const glm::vec3& min, const glm::vec3& max) const {
+            WorldView view(world_);
+
+            const glm::ivec3 first(floorToInt(min.x + EPSILON), floorToInt(min.y + EPSILON), floorToInt(min.z + EPSILON));
+            const glm::ivec3 last(ceilToInt(max.x - EPSILON) - 1, ceilToInt(max.y - EPSILON) - 1, ceilToInt(max.z - EPSILON) - 1);
+
+            for (int32_t z = first.z; z <= last.z; ++z) {
+                for (int32_t y = first.y; y <= last.y; ++y) {
+                    for (int32_t x = first.x; x <= last.x; ++x) {
+                        const glm::vec3 origin(x, y, z);
+                        const auto [boxes, count] = getBoxes(glm::ivec3(x, y, z), view);
+
+                        for (size_t b = 0; b < count; ++b) {
+                            const glm::vec3 boxMin = origin + boxes[b].min;
+                            const glm::vec3 boxMax = origin + boxes[b].max;
+                            if (glm::all(glm::lessThan(boxMin, max - EPSILON)) && glm::all(glm::greaterThan(boxMax, min + EPSILON))) {
+                                return true;
+                            }
+                        }
+                    }
+                }
+            }
+
+            return false;
+        }
+
+        std::pair<const Physics::Box*, size_t> Physics::getBoxes(const glm::ivec3& voxel, WorldView& view) const {
+            const Chunk* chunk = view.getChunk(WorldView::toChunk(voxel));
+            if (!chunk) {
+                return { boxes_.data(), 1 };
+            }
+
+            // Most voxels around a body are air, which the occupancy tells without decoding the palette.
+            // Both are indexed x first with the linear layout.
+            const size_t index = WorldView::toIndex(voxel);
+            if (!chunk->getOccupancy().test(index)) {
+                return { nullptr, 0 };
+            }
+
+            const uint16_t id = chunk->getStorage().get(index).getId();
+            if (id + size_t(1) >= firstBox_.size()) {
+                return { boxes_.data(), 1 };
+            }
+            return { boxes_.data() + firstBox_[id], firstBox_[id + 1] - firstBox_[id] };
+        }
+
+        float Physics::sweep(int axis, const glm::vec3& min, const glm::vec3& max, float delta, WorldView& view) const {
+            if (delta == 0.0f) {
+                return 0.0f;
+            }
+
+            const int u = (axis + 1) % 3;
+            const int v = (axis + 2) % 3;
+
+            // Voxels beside the box along the other axes, faces merely touching them excluded
+            const int32_t firstU = floorToInt(min[u] + EPSILON);
+            const int32_t lastU = ceilToInt(max[u] - EPSILON) - 1;
+            const int32_t firstV = floorToInt(min[v] + EPSILON);
+            const int32_t lastV = ceilToInt(max[v] - EPSILON) - 1;
+
+            // Layers of voxels ahead of the leading face, nearest first
+            const bool positive = delta > 0.0f;
+            const int32_t direction = positive ? 1 : -1;
+            const float face = positive ? max[axis] : min[axis];
+            const int32_t firstLayer = positive ? floorToInt(face) : ceilToInt(face) - 1;
+            const int32_t lastLayer = positive ? ceilToInt(face + delta) - 1 : floorToInt(face + delta);
+
+            glm::ivec3 voxel;
+            for (int32_t layer = firstLayer; positive ? layer <= lastLayer : layer >= lastLayer; layer += direction) {
+                // Nothing in this layer or past it can be nearer than what is left of the move
+                const float distance = positive ? float(layer) - face : face - float(layer + 1);
+                if (distance >= std::abs(delta)) {
+                    break;
+                }
+
+                voxel[axis] = layer;
+                for (voxel[v] = firstV; voxel[v] <= lastV; ++voxel[v]) {
+                    for (voxel[u] = firstU; voxel[u] <= lastU; ++voxel[u]) {
+                        const auto [boxes, count] = getBoxes(voxel, view);
+                        const glm::vec3 origin(voxel);
+
+                        for (size_t b = 0; b < count; ++b) {
+                            const glm::vec3 boxMin = origin + boxes[b].min;
+                            const glm::vec3 boxMax = origin + boxes[b].max;
+
+                            if (boxMin[u] >= max[u] - EPSILON || boxMax[u] <= min[u] + EPSILON
+                                || boxMin[v] >= max[v] - EPSILON || boxMax[v] <= min[v] + EPSILON) {
+                                continue;
+                            }
+
+                            // Boxes the body already overlaps along the axis never stop it, so it can get out
+                            if (positive && boxMin[axis] >= max[axis] - EPSILON) {
+                                delta = std::min(delta, std::max(boxMin[axis] - max[axis], 0.0f));
+                            }
+                            else if (!positive && boxMax[axis] <= min[axis] + EPSILON) {
+                                delta = std::max(delta, std::min(boxMax[axis] - min[axis], 0.0f));
+                            }
+                        }
+                    }
+                }
+            }
+
+            return delta;
+        }
+
+        glm::vec3 Physics::sweepAll(glm::vec3& min, glm::vec3& max, const glm::vec3& displacement, WorldView& view) const {
+            glm::vec3 moved(0.0f);
+
+            for (int axis : { 1, 0, 2 }) {
+                const float delta = sweep(axis, min, max, displacement[axis], view);
+                min[axis] += delta;
+                max[axis] += delta;
+                moved[axis] = delta;
+            }
+
+            return moved;
+        }
+
+    } // namespace Voxel
+} // namespace Gem
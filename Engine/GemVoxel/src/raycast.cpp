@@ -0,0 +1,226 @@
+#include <Gem/Voxel/raycast.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace Gem {
+    namespace Voxel {
+
+        namespace {
+
+            constexpr size_t BATCH_SIZE = 64;       // Rays per job
+            constexpr size_t CACHE_SIZE = 64;       // Chunks remembered by a batch, power of two
+
+            /**
+             * @brief Remembers the last chunk looked up, enough for a single ray.
+             */
+            class LastChunkLookup {
+            public:
+                explicit LastChunkLookup(const ChunkManager& world) noexcept : world_(world) {}
+
+                const Chunk* operator()(const ChunkCoord& coord) {
+                    if (!valid_ || coord != coord_) {
+                        coord_ = coord;
+                        chunk_ = world_.getChunk(coord);
+                        valid_ = true;
+                    }
+                    return chunk_;
+                }
+
+            private:
+                const ChunkManager& world_;
+                ChunkCoord coord_;
+                const Chunk* chunk_ = nullptr;
+                bool valid_ = false;
+            };
+
+            /**
+             * @brief Direct-mapped cache of chunk lookups, shared by the rays of a batch.
+             */
+            class CachedChunkLookup {
+            public:
+                explicit CachedChunkLookup(const ChunkManager& world) noexcept : world_(world) {}
+
+                const Chunk* operator()(const ChunkCoord& coord) {
+                    Slot& slot = slots_[ChunkCoordHash()(coord) & (CACHE_SIZE - 1)];
+                    if (!slot.valid || slot.coord != coord) {
+                        slot.coord = coord;
+                        slot.chunk = world_.getChunk(coord);
+                        slot.valid = true;
+                    }
+                    return slot.chunk;
+                }
+
+            private:
+                struct Slot {
+                    ChunkCoord coord;
+                    const Chunk* chunk = nullptr;
+                    bool valid = false;
+                };
+
+                const ChunkManager& world_;
+                std::array<Slot, CACHE_SIZE> slots_{};
+            };
+
+            /**
+             * @brief Picks the axis with the smallest value, the highest axis winning ties.
+             */
+            inline int smallestAxis(const glm::vec3& t) noexcept {
+                return (t.x < t.y) ? ((t.x < t.z) ? 0 : 2) : ((t.y < t.z) ? 1 : 2);
+            }
+
+            template<typename Lookup>
+            RaycastHit cast(Lookup& lookup, const glm::vec3& origin, const glm::vec3& direction, float maxDistance) {
+                RaycastHit result;
+
+                const float length = glm::length(direction);
+                if (!(length > 0.0f) || !(maxDistance >= 0.0f) || !std::isfinite(maxDistance)) {
+                    return result;
+                }
+
+                const glm::vec3 dir = direction / length;
+                constexpr float infinity = std::numeric_limits<float>::infinity();
+
+                const glm::ivec3 start = glm::ivec3(glm::floor(origin));
+                glm::ivec3 step(0);
+                glm::vec3 first(infinity);
+                glm::vec3 delta(infinity);
+
+                // Distance along the ray to the first voxel boundary, and between boundaries, on each axis
+                for (int a = 0; a < 3; ++a) {
+                    if (dir[a] > 0.0f) {
+                        step[a] = 1;
+                        delta[a] = 1.0f / dir[a];
+                        first[a] = (static_cast<float>(start[a] + 1) - origin[a]) * delta[a];
+                    }
+                    else if (dir[a] < 0.0f) {
+                        step[a] = -1;
+                        delta[a] = -1.0f / dir[a];
+                        first[a] = (origin[a] - static_cast<float>(start[a])) * delta[a];
+                    }
+                }
+
+                // Distance to the n-th boundary of an axis. Always computed the same way, so stepping
+                // one voxel at a time and jumping over empty boxes cross boundaries in the same order.
+                auto boundary = [&first, &delta](int a, int32_t n) noexcept {
+                    return (delta[a] == infinity) ? infinity : first[a] + static_cast<float>(n) * delta[a];
+                };
+
+                const int32_t chunkLength = static_cast<int32_t>(Chunk::getLength());
+
+                glm::ivec3 crossed(0);          // Boundaries crossed on each axis
+                glm::ivec3 voxel = start;
+                glm::vec3 tMax = first;
+                float t = 0.0f;
+                int axis = -1;
+
+                ChunkCoord coord = ChunkCoord::fromVoxel(voxel);
+                glm::ivec3 chunkOrigin = coord.getOrigin();
+                const Chunk* chunk = lookup(coord);
+
+                while (t <= maxDistance) {
+                    glm::ivec3 local = voxel - chunkOrigin;
+
+                    // Only look the chunk up again when crossing a chunk border
+                    if (glm::any(glm::lessThan(local, glm::ivec3(0))) || glm::any(glm::greaterThanEqual(local, glm::ivec3(chunkLength)))) {
+                        coord = ChunkCoord::fromVoxel(voxel);
+                        chunkOrigin = coord.getOrigin();
+                        chunk = lookup(coord);
+                        local = voxel - chunkOrigin;
+                    }
+
+                    // Size of the empty box around the voxel the ray can jump over without reading voxels,
+                    // the whole chunk when it is missing or empty, else the largest empty occupancy cell
+                    const int32_t box = chunk
+                        ? static_cast<int32_t>(chunk->getOccupancy().getEmptyLength(local.x, local.y, local.z))
+                        : chunkLength;
+
+                    if (box == 0) {
+                        result.hit = true;
+                        result.voxel = voxel;
+                        result.distance = t;
+                        result.block = chunk->getVoxelUnchecked(local.x, local.y, local.z);
+                        if (axis >= 0) {
+                            result.normal[axis] = -step[axis];
+                        }
+                        return result;
+                    }
+
+                    if (box == 1) {
+                        axis = smallestAxis(tMax);
+                        t = tMax[axis];
+                        voxel[axis] += step[axis];
+                        tMax[axis] = boundary(axis, ++crossed[axis]);
+                        continue;
+                    }
+
+                    // Boundaries left to cross on each axis before leaving the box, and when the last one is met
+                    const glm::ivec3 boxMin = chunkOrigin + (local / box) * box;
+                    glm::ivec3 remaining(0);
+                    glm::vec3 exit(infinity);
+                    for (int a = 0; a < 3; ++a) {
+                        if (step[a] != 0) {
+                            remaining[a] = (step[a] > 0) ? boxMin[a] + box - voxel[a] : voxel[a] - boxMin[a] + 1;
+                            exit[a] = boundary(a, crossed[a] + remaining[a] - 1);
+                        }
+                    }
+
+                    axis = smallestAxis(exit);
+                    t = exit[axis];
+
+                    // Cross every boundary of the other axes met before the exit, ties going to the higher axis
+                    for (int a = 0; a < 3; ++a) {
+                        if (a == axis || step[a] == 0) {
+                            continue;
+                        }
+
+                        auto before = [&](int32_t n) {
+                            const float time = boundary(a, n);
+                            return time < t || (time == t && a > axis);
+                        };
+
+                        int32_t n = crossed[a] + std::max(0, static_cast<int32_t>(std::ceil((t - tMax[a]) / delta[a])));
+                        n = std::min(n, crossed[a] + remaining[a] - 1);
+                        while (n > crossed[a] && !before(n - 1)) {
+                            --n;
+                        }
+                        while (before(n)) {
+                            ++n;
+                        }
+
+                        voxel[a] += step[a] * (n - crossed[a]);
+                        crossed[a] = n;
+                        tMax[a] = boundary(a, n);
+                    }
+
+                    voxel[axis] += step[axis] * remaining[axis];
+                    crossed[axis] += remaining[axis];
+                    tMax[axis] = boundary(axis, crossed[axis]);
+                }
+
+                return result;
+            }
+
+        } // namespace
+
+        RaycastHit raycast(const ChunkManager& world, const glm::vec3& origin, const glm::vec3& direction, float maxDistance) {
+            LastChunkLookup lookup(world);
+            return cast(lookup, origin, direction, maxDistance);
+        }
+
+        void raycast(const ChunkManager& world, const Ray* rays, size_t count, RaycastHit* hits) {
+            CachedChunkLookup lookup(world);
+            for (size_t i = 0; i < count; ++i) {
+                hits[i] = cast(lookup, rays[i].origin, rays[i].direction, rays[i].maxDistance);
+            }
+        }
+
+        Gem::Core::JobHandle raycast(Gem::Core::JobSystem& jobs, const ChunkManager& world, const Ray* rays, size_t count, RaycastHit* hits) {
+            return jobs.parallelFor(count, BATCH_SIZE, [&world, rays, hits](size_t begin, size_t end) {
+                raycast(world, rays + begin, end - begin, hits + begin);
+            });
+        }
+
+    } // namespace Voxel
+} // namespace Gem
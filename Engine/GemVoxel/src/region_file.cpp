@@ -0,0 +1,433 @@
+// Platform headers come first so they define APIENTRY before GLAD does
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <Gem/Voxel/region_file.h>
+#include <Gem/Voxel/chunk_serializer.h>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+
+namespace Gem {
+    namespace Voxel {
+
+        namespace {
+
+            constexpr uint32_t MAGIC = 0x524D4547;      // "GEMR"
+            constexpr uint32_t VERSION = 1;
+
+            constexpr uint64_t HEADER_SIZE = 16;        // Magic, version, reserved
+            constexpr uint64_t TABLE_SIZE = uint64_t(RegionFile::CHUNK_COUNT) * 16;
+            constexpr uint64_t DATA_OFFSET = HEADER_SIZE + TABLE_SIZE;
+
+            constexpr uint64_t MIN_COMPACTION_BYTES = 256 * 1024;
+            constexpr uint64_t MIN_GROWTH = 1024 * 1024;    // Smallest step the file grows by
+
+            void writeHeader(std::ostream& stream) {
+                uint8_t header[HEADER_SIZE] = {};
+                std::memcpy(header, &MAGIC, sizeof(MAGIC));
+                std::memcpy(header + 4, &VERSION, sizeof(VERSION));
+                stream.write(reinterpret_cast<const char*>(header), HEADER_SIZE);
+            }
+
+        } // namespace
+
+        // Mapping
+
+        class RegionFile::Mapping {
+        public:
+            explicit Mapping(const std::filesystem::path& path) {
+#ifdef _WIN32
+                file_ = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                    nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+                if (file_ == INVALID_HANDLE_VALUE) {
+                    return;
+                }
+
+                LARGE_INTEGER size;
+                if (!GetFileSizeEx(file_, &size) || size.QuadPart == 0) {
+                    return;
+                }
+
+                mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (!mapping_) {
+                    return;
+                }
+
+                data_ = static_cast<const uint8_t*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+                size_ = data_ ? static_cast<size_t>(size.QuadPart) : 0;
+#else
+                fd_ = ::open(path.c_str(), O_RDONLY);
+                if (fd_ < 0) {
+                    return;
+                }
+
+                struct stat info;
+                if (fstat(fd_, &info) != 0 || info.st_size == 0) {
+                    return;
+                }
+
+                void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd_, 0);
+                if (data != MAP_FAILED) {
+                    data_ = static_cast<const uint8_t*>(data);
+                    size_ = static_cast<size_t>(info.st_size);
+                }
+#endif
+            }
+
+            ~Mapping() {
+#ifdef _WIN32
+                if (data_) {
+                    UnmapViewOfFile(data_);
+                }
+                if (mapping_) {
+                    CloseHandle(mapping_);
+                }
+                if (file_ != INVALID_HANDLE_VALUE) {
+                    CloseHandle(file_);
+                }
+#else
+                if (data_) {
+                    munmap(const_cast<uint8_t*>(data_), size_);
+                }
+                if (fd_ >= 0) {
+                    ::close(fd_);
+                }
+#endif
+            }
+
+            Mapping(const Mapping&) = delete;
+            Mapping& operator=(const Mapping&) = delete;
+
+            [[nodiscard]] const uint8_t* data() const noexcept { return data_; }
+            [[nodiscard]] size_t size() const noexcept { return size_; }
+
+        private:
+#ifdef _WIN32
+            HANDLE file_ = INVALID_HANDLE_VALUE;    ///< File handle.
+            HANDLE mapping_ = nullptr;              ///< File mapping object.
+#else
+            int fd_ = -1;                           ///< File descriptor.
+#endif
+            const uint8_t* data_ = nullptr;         ///< First byte of the view.
+            size_t size_ = 0;                       ///< Bytes in the view.
+        };
+
+        // RegionFile
+
+        RegionFile::RegionFile(std::filesystem::path path)
+            : path_(std::move(path)) {
+            if (!std::filesystem::exists(path_) && !create(path_)) {
+                throw std::runtime_error("RegionFile: cannot create " + path_.string());
+            }
+
+            if (!open()) {
+                throw std::runtime_error("RegionFile: cannot open " + path_.string());
+            }
+        }
+
+        RegionFile::~RegionFile() = default;
+
+        ChunkCoord RegionFile::getRegion(const ChunkCoord& chunk) noexcept {
+            // Arithmetic shifts round towards negative infinity
+            return { chunk.x >> LENGTH_BITS, chunk.y >> LENGTH_BITS, chunk.z >> LENGTH_BITS };
+        }
+
+        uint32_t RegionFile::getSlot(const ChunkCoord& chunk) noexcept {
+            const uint32_t mask = LENGTH - 1;
+            return (uint32_t(chunk.x) & mask)
+                | ((uint32_t(chunk.y) & mask) << LENGTH_BITS)
+                | ((uint32_t(chunk.z) & mask) << (2 * LENGTH_BITS));
+        }
+
+        bool RegionFile::contains(const ChunkCoord& chunk) const {
+            std::shared_lock lock(mutex_);
+            return entries_[getSlot(chunk)].size > 0;
+        }
+
+        bool RegionFile::read(const ChunkCoord& coord, Chunk& chunk) const {
+            const uint32_t slot = getSlot(coord);
+            std::shared_lock lock(mutex_);
+
+            if (entries_[slot].size == 0) {
+                return false;
+            }
+
+            if (!isMapped(entries_[slot].offset + entries_[slot].size)) {
+                // The file grew past the mapping since it was made, map it again without readers
+                lock.unlock();
+                {
+                    std::unique_lock exclusive(mutex_);
+                    const Entry& entry = entries_[slot];
+                    if (!isMapped(entry.offset + entry.size) && !remap()) {
+                        std::cerr << "ERROR::RegionFile::read: cannot map " << path_.string() << std::endl;
+                        return false;
+                    }
+                }
+                lock.lock();
+            }
+
+            // The table may have changed while the lock was released
+            const Entry& entry = entries_[slot];
+            if (entry.size == 0) {
+                return false;
+            }
+
+            if (!isMapped(entry.offset + entry.size)) {
+                std::cerr << "ERROR::RegionFile::read: payload outside the mapping of " << path_.string() << std::endl;
+                return false;
+            }
+
+            // Decode straight out of the mapping, no intermediate copy
+            const uint8_t* data = mapping_->data() + entry.offset;
+            if (checksum(data, entry.size) != entry.checksum) {
+                std::cerr << "ERROR::RegionFile::read: checksum mismatch in " << path_.string() << std::endl;
+                return false;
+            }
+
+            if (!ChunkSerializer::decode(data, entry.size, chunk)) {
+                std::cerr << "ERROR::RegionFile::read: invalid payload in " << path_.string() << std::endl;
+                return false;
+            }
+
+            return true;
+        }
+
+        bool RegionFile::write(const ChunkCoord& coord, const std::vector<uint8_t>& payload) {
+            if (payload.empty() || payload.size() > UINT32_MAX) {
+                return false;
+            }
+
+            const uint32_t slot = getSlot(coord);
+
+            Entry entry;
+            entry.offset = fileSize_;
+            entry.size = static_cast<uint32_t>(payload.size());
+            entry.checksum = checksum(payload.data(), payload.size());
+
+            // Readers only look at the mapping, so the payload is appended without blocking them
+            stream_.clear();
+            stream_.seekp(static_cast<std::streamoff>(entry.offset));
+            stream_.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+
+            // Grow the file ahead in a large step, so the next payloads land inside the mapping
+            const uint64_t end = entry.offset + entry.size;
+            uint64_t capacity = capacity_;
+            if (end > capacity) {
+                capacity = std::max(end, capacity + std::max(MIN_GROWTH, capacity / 2));
+
+                const char zero = 0;
+                stream_.seekp(static_cast<std::streamoff>(capacity - 1));
+                stream_.write(&zero, 1);
+            }
+            stream_.flush();
+
+            if (!stream_) {
+                std::cerr << "ERROR::RegionFile::write: cannot append to " << path_.string() << std::endl;
+                return false;
+            }
+
+            {
+                std::unique_lock lock(mutex_);
+
+                Entry& previous = entries_[slot];
+                liveBytes_ -= previous.size;
+                deadBytes_ += previous.size;
+                liveBytes_ += entry.size;
+
+                previous = entry;
+                fileSize_ = end;
+                capacity_ = capacity;
+            }
+
+            // The table entry goes last, so an interrupted write keeps pointing to the previous payload
+            stream_.seekp(static_cast<std::streamoff>(HEADER_SIZE + slot * sizeof(Entry)));
+            stream_.write(reinterpret_cast<const char*>(&entry), sizeof(Entry));
+            stream_.flush();
+
+            if (!stream_) {
+                std::cerr << "ERROR::RegionFile::write: cannot update the offset table of " << path_.string() << std::endl;
+                return false;
+            }
+
+            return true;
+        }
+
+        bool RegionFile::compact() {
+            std::filesystem::path temporary = path_;
+            temporary += ".tmp";
+
+            {
+                std::unique_lock lock(mutex_);
+                if (!isMapped(fileSize_) && !remap()) {
+                    std::cerr << "ERROR::RegionFile::compact: cannot map " << path_.string() << std::endl;
+                    return false;
+                }
+            }
+
+            {
+                // Writes come from this thread, so the table and the mapping stay still while reads go on
+                std::shared_lock lock(mutex_);
+
+                std::vector<Entry> entries(CHUNK_COUNT);
+                uint64_t offset = DATA_OFFSET;
+                for (uint32_t slot = 0; slot < CHUNK_COUNT; ++slot) {
+                    if (entries_[slot].size > 0) {
+                        entries[slot] = entries_[slot];
+                        entries[slot].offset = offset;
+                        offset += entries_[slot].size;
+                    }
+                }
+
+                std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+                writeHeader(out);
+                out.write(reinterpret_cast<const char*>(entries.data()), TABLE_SIZE);
+
+                for (const Entry& entry : entries_) {
+                    if (entry.size > 0) {
+                        out.write(reinterpret_cast<const char*>(mapping_->data() + entry.offset), entry.size);
+                    }
+                }
+
+                out.close();
+                if (!out) {
+                    std::cerr << "ERROR::RegionFile::compact: cannot write " << temporary.string() << std::endl;
+                    std::error_code error;
+                    std::filesystem::remove(temporary, error);
+                    return false;
+                }
+            }
+
+            std::unique_lock lock(mutex_);
+
+            // Handles must be closed before the file can be replaced
+            mapping_.reset();
+            stream_.close();
+
+            std::error_code error;
+            std::filesystem::rename(temporary, path_, error);
+            if (error) {
+                std::cerr << "ERROR::RegionFile::compact: cannot replace " << path_.string() << ": " << error.message() << std::endl;
+                std::filesystem::remove(temporary, error);
+            }
+
+            if (!open()) {
+                std::cerr << "ERROR::RegionFile::compact: cannot reopen " << path_.string() << std::endl;
+                return false;
+            }
+
+            return !error;
+        }
+
+        bool RegionFile::needsCompaction() const {
+            std::shared_lock lock(mutex_);
+            return deadBytes_ > liveBytes_ && deadBytes_ >= MIN_COMPACTION_BYTES;
+        }
+
+        RegionFileStats RegionFile::getStats() const {
+            std::shared_lock lock(mutex_);
+
+            RegionFileStats stats;
+            for (const Entry& entry : entries_) {
+                stats.chunkCount += (entry.size > 0) ? 1 : 0;
+            }
+            stats.fileSize = fileSize_;
+            stats.liveBytes = liveBytes_;
+            stats.deadBytes = deadBytes_;
+
+            return stats;
+        }
+
+        const std::filesystem::path& RegionFile::getPath() const noexcept {
+            return path_;
+        }
+
+        bool RegionFile::open() {
+            stream_.open(path_, std::ios::in | std::ios::out | std::ios::binary);
+            if (!stream_) {
+                return false;
+            }
+
+            uint8_t header[HEADER_SIZE];
+            stream_.read(reinterpret_cast<char*>(header), HEADER_SIZE);
+
+            uint32_t magic = 0;
+            uint32_t version = 0;
+            std::memcpy(&magic, header, sizeof(magic));
+            std::memcpy(&version, header + 4, sizeof(version));
+
+            entries_.assign(CHUNK_COUNT, Entry());
+            stream_.read(reinterpret_cast<char*>(entries_.data()), TABLE_SIZE);
+
+            if (!stream_ || magic != MAGIC || version != VERSION) {
+                stream_.close();
+                return false;
+            }
+
+            stream_.seekg(0, std::ios::end);
+            capacity_ = static_cast<uint64_t>(stream_.tellg());
+
+            // Drop entries pointing past the end, left by a truncated file. The bytes in use end with
+            // the last payload, anything after it is spare room or a payload whose entry was never written.
+            liveBytes_ = 0;
+            fileSize_ = DATA_OFFSET;
+            for (Entry& entry : entries_) {
+                if (entry.size > 0 && (entry.offset < DATA_OFFSET || entry.offset + entry.size > capacity_)) {
+                    std::cerr << "ERROR::RegionFile::open: dropping a truncated payload in " << path_.string() << std::endl;
+                    entry = Entry();
+                }
+                liveBytes_ += entry.size;
+                fileSize_ = std::max(fileSize_, entry.offset + entry.size);
+            }
+            deadBytes_ = fileSize_ - DATA_OFFSET - liveBytes_;
+
+            return remap();
+        }
+
+        bool RegionFile::remap() const {
+            mapping_.reset();
+            mapping_ = std::make_unique<Mapping>(path_);
+
+            if (!mapping_->data() || mapping_->size() < fileSize_) {
+                mapping_.reset();
+                return false;
+            }
+
+            return true;
+        }
+
+        bool RegionFile::isMapped(uint64_t end) const noexcept {
+            return mapping_ && end <= mapping_->size();
+        }
+
+        bool RegionFile::create(const std::filesystem::path& path) {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            writeHeader(out);
+
+            const std::vector<Entry> entries(CHUNK_COUNT);
+            out.write(reinterpret_cast<const char*>(entries.data()), TABLE_SIZE);
+
+            out.close();
+            return static_cast<bool>(out);
+        }
+
+        uint32_t RegionFile::checksum(const uint8_t* data, size_t size) noexcept {
+            uint32_t hash = 2166136261u;
+            for (size_t i = 0; i < size; ++i) {
+                hash = (hash ^ data[i]) * 16777619u;
+            }
+            return hash;
+        }
+
+    } // namespace Voxel
+} // namespace Gem
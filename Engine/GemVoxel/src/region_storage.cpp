@@ -0,0 +1,202 @@
+#include <Gem/Voxel/region_storage.h>
+#include <Gem/Voxel/chunk_serializer.h>
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace Gem {
+    namespace Voxel {
+
+        RegionStorage::RegionStorage(std::filesystem::path directory, size_t maxOpenRegions)
+            : directory_(std::move(directory)), maxOpenRegions_(std::max<size_t>(maxOpenRegions, 1)) {
+            std::filesystem::create_directories(directory_);
+            writer_ = std::thread(&RegionStorage::writerLoop, this);
+        }
+
+        RegionStorage::~RegionStorage() {
+            {
+                std::lock_guard<std::mutex> lock(queueMutex_);
+                running_ = false;
+            }
+            queueCondition_.notify_all();
+
+            // The writer drains the queue before returning
+            if (writer_.joinable()) {
+                writer_.join();
+            }
+        }
+
+        bool RegionStorage::load(const ChunkCoord& coord, Chunk& chunk) {
+            {
+                // A queued snapshot is newer than anything on disk
+                std::lock_guard<std::mutex> lock(queueMutex_);
+
+                auto it = pending_.find(coord);
+                if (it != pending_.end()) {
+                    // Restore the voxels like decoding would, the light is computed again
+                    const PaletteStorage<Voxel>& storage = it->second.chunk->getStorage();
+                    chunk.assign(storage.getPalette(), storage.getPackedIndices());
+
+                    ++totalReads_;
+                    return true;
+                }
+            }
+
+            std::shared_ptr<RegionFile> region = getRegion(RegionFile::getRegion(coord), false);
+            if (!region || !region->read(coord, chunk)) {
+                return false;
+            }
+
+            ++totalReads_;
+            return true;
+        }
+
+        void RegionStorage::save(const ChunkCoord& coord, const Chunk& chunk) {
+            std::shared_ptr<const Chunk> snapshot = chunk.snapshot();
+
+            {
+                std::lock_guard<std::mutex> lock(queueMutex_);
+
+                auto [it, inserted] = pending_.try_emplace(coord);
+                it->second.chunk = std::move(snapshot);
+                it->second.sequence = ++nextSequence_;
+
+                // A chunk already pending keeps its place, the writer picks the latest snapshot
+                if (inserted) {
+                    queue_.push_back(coord);
+                }
+            }
+
+            queueCondition_.notify_one();
+        }
+
+        void RegionStorage::flush() {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            idleCondition_.wait(lock, [this] { return pending_.empty(); });
+        }
+
+        RegionStorageStats RegionStorage::getStats() const {
+            RegionStorageStats stats;
+
+            {
+                std::lock_guard<std::mutex> lock(regionsMutex_);
+                for (const auto& [coord, region] : regions_) {
+                    stats.openRegions += region ? 1 : 0;
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(queueMutex_);
+                stats.pendingWrites = pending_.size();
+            }
+
+            stats.totalReads = totalReads_.load();
+            stats.totalWrites = totalWrites_.load();
+            stats.totalCompactions = totalCompactions_.load();
+
+            return stats;
+        }
+
+        const std::filesystem::path& RegionStorage::getDirectory() const noexcept {
+            return directory_;
+        }
+
+        std::shared_ptr<RegionFile> RegionStorage::getRegion(const ChunkCoord& region, bool create) {
+            std::lock_guard<std::mutex> lock(regionsMutex_);
+
+            auto it = regions_.find(region);
+            if (it != regions_.end() && (it->second || !create)) {
+                return it->second;
+            }
+
+            const std::filesystem::path path = directory_ / ("r." + std::to_string(region.x) + "." + std::to_string(region.y) + "." + std::to_string(region.z) + ".gemr");
+
+            std::shared_ptr<RegionFile> file;
+            std::error_code error;
+            if (create || std::filesystem::exists(path, error)) {
+                try {
+                    file = std::make_shared<RegionFile>(path);
+                }
+                catch (const std::runtime_error& e) {
+                    std::cerr << "ERROR::RegionStorage::getRegion: " << e.what() << std::endl;
+                }
+            }
+
+            // Missing regions are remembered too, so loading an unexplored area does not hit the disk
+            if (it == regions_.end()) {
+                regions_.emplace(region, file);
+                regionOrder_.push_back(region);
+            }
+            else {
+                it->second = file;
+            }
+
+            closeRegions();
+            return file;
+        }
+
+        void RegionStorage::closeRegions() {
+            for (auto it = regionOrder_.begin(); it != regionOrder_.end() && regions_.size() > maxOpenRegions_;) {
+                auto region = regions_.find(*it);
+
+                // Only the map holds it, so no read or write is in progress
+                if (region->second.use_count() <= 1) {
+                    regions_.erase(region);
+                    it = regionOrder_.erase(it);
+                }
+                else {
+                    ++it;
+                }
+            }
+        }
+
+        void RegionStorage::writerLoop() {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+
+            while (true) {
+                queueCondition_.wait(lock, [this] { return !queue_.empty() || !running_; });
+                if (queue_.empty()) {
+                    break;
+                }
+
+                const ChunkCoord coord = queue_.front();
+                queue_.pop_front();
+
+                // Keep the snapshot pending while it is written, so load() still finds it
+                PendingWrite write = pending_.at(coord);
+                lock.unlock();
+
+                std::vector<uint8_t> payload;
+                ChunkSerializer::encode(*write.chunk, payload);
+                write.chunk.reset();
+
+                std::shared_ptr<RegionFile> region = getRegion(RegionFile::getRegion(coord), true);
+                if (region && region->write(coord, payload)) {
+                    ++totalWrites_;
+
+                    if (region->needsCompaction() && region->compact()) {
+                        ++totalCompactions_;
+                    }
+                }
+                region.reset();
+
+                lock.lock();
+
+                // Saved again while being written: write the newer snapshot too
+                auto it = pending_.find(coord);
+                if (it->second.sequence == write.sequence) {
+                    pending_.erase(it);
+                }
+                else {
+                    queue_.push_back(coord);
+                }
+
+                if (pending_.empty()) {
+                    idleCondition_.notify_all();
+                }
+            }
+        }
+
+    } // namespace Voxel
+} // namespace Gem
@@ -0,0 +1,381 @@
+#include <Gem/Voxel/world_generator.h>
+#include <algorithm>
+#include <cmath>
+
+namespace Gem {
+    namespace Voxel {
+
+        namespace {
+
+            constexpr int32_t SEA_LEVEL = 40;           // Height of flat land
+            constexpr int32_t SNOW_LINE = 64;           // Mountains above this height stay bare stone
+            constexpr int32_t CAVE_ROOF = 5;            // Caves stay this many voxels below the surface
+            constexpr int32_t SOIL_DEPTH = 3;           // Depth of dirt and sand layers
+            constexpr int32_t TREE_CELL = 6;            // At most one tree per cell of TREE_CELL^2 columns
+            constexpr int32_t TREE_RADIUS = 2;          // Horizontal reach of a canopy
+
+            constexpr int32_t LENGTH = static_cast<int32_t>(Chunk::getLength());
+
+            uint64_t columnKey(int32_t x, int32_t z) noexcept {
+                return (uint64_t(uint32_t(x)) << 32) | uint32_t(z);
+            }
+
+            float smoothstep(float edge0, float edge1, float x) noexcept {
+                const float t = std::clamp((x - edge0) / (edge1 - edge0), 0.0f, 1.0f);
+                return t * t * (3.0f - 2.0f * t);
+            }
+
+        } // namespace
+
+        WorldGenerator::WorldGenerator(uint32_t seed, const WorldBlocks& blocks)
+            : seed_(seed),
+            blocks_(blocks),
+            heightNoise_(seed),
+            mountainNoise_(seed * 31u + 1u),
+            temperatureNoise_(seed * 31u + 2u),
+            moistureNoise_(seed * 31u + 3u),
+            caveNoise_(seed * 31u + 4u),
+            tunnelNoise_(seed * 31u + 5u) {
+        }
+
+        void WorldGenerator::generate(const ChunkCoord& coord, Chunk& chunk) const {
+            generateTerrain(coord, chunk);
+            decorateSurface(coord, chunk);
+            placeFeatures(coord, chunk);
+        }
+
+        Gem::Core::JobHandle WorldGenerator::generate(Gem::Core::JobSystem& jobs, const ChunkBatch& chunks) const {
+            auto batch = std::make_shared<ChunkBatch>(chunks);
+
+            // Stage 1, once per distinct column
+            auto columns = std::make_shared<std::vector<std::pair<int32_t, int32_t>>>();
+            for (const auto& [coord, chunk] : *batch) {
+                columns->emplace_back(coord.x, coord.z);
+            }
+            std::sort(columns->begin(), columns->end());
+            columns->erase(std::unique(columns->begin(), columns->end()), columns->end());
+
+            Gem::Core::JobHandle columnsDone = jobs.parallelFor(columns->size(), 1, [this, columns](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    getColumn((*columns)[i].first, (*columns)[i].second);
+                }
+            });
+
+            // Stages 2 to 4, one chunk per job, each stage waiting for the previous one
+            auto stage = [this, batch](void (WorldGenerator::*function)(const ChunkCoord&, Chunk&) const) {
+                return [this, batch, function](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i) {
+                        (this->*function)((*batch)[i].first, *(*batch)[i].second);
+                    }
+                };
+            };
+
+            Gem::Core::JobHandle terrainDone = jobs.parallelFor(batch->size(), 1, stage(&WorldGenerator::generateTerrain), columnsDone);
+            Gem::Core::JobHandle surfaceDone = jobs.parallelFor(batch->size(), 1, stage(&WorldGenerator::decorateSurface), terrainDone);
+            return jobs.parallelFor(batch->size(), 1, stage(&WorldGenerator::placeFeatures), surfaceDone);
+        }
+
+        std::shared_ptr<const ColumnData> WorldGenerator::getColumn(int32_t x, int32_t z) const {
+            const uint64_t key = columnKey(x, z);
+
+            {
+                std::lock_guard<std::mutex> lock(columnsMutex_);
+                auto it = columns_.find(key);
+                if (it != columns_.end()) {
+                    return it->second;
+                }
+            }
+
+            // Computed outside the lock; if two threads race, both results are identical
+            std::shared_ptr<const ColumnData> column = computeColumn(x, z);
+
+            std::lock_guard<std::mutex> lock(columnsMutex_);
+            auto [it, inserted] = columns_.emplace(key, column);
+            if (inserted) {
+                columnOrder_.push_back(key);
+
+                while (columnOrder_.size() > columnCapacity_) {
+                    columns_.erase(columnOrder_.front());
+                    columnOrder_.pop_front();
+                }
+            }
+
+            return column;
+        }
+
+        void WorldGenerator::generateTerrain(const ChunkCoord& coord, Chunk& chunk) const {
+            const std::shared_ptr<const ColumnData> column = getColumn(coord.x, coord.z);
+            const glm::ivec3 origin = coord.getOrigin();
+
+            // Entirely above the ground
+            if (origin.y > column->maxHeight) {
+                chunk.fill(Voxel());
+                return;
+            }
+
+            // Caves are only carved well below the surface
+            const bool hasCaves = origin.y <= column->maxHeight - CAVE_ROOF;
+
+            std::vector<float> caves;
+            std::vector<float> tunnels;
+            if (hasCaves) {
+                Gem::Math::FractalSettings settings;
+                settings.type = Gem::Math::NoiseType::Simplex;
+                settings.octaves = 2;
+                settings.frequency = 1.0f / 32.0f;
+
+                caves.resize(Chunk::getVolume());
+                tunnels.resize(Chunk::getVolume());
+                caveNoise_.fillGrid(glm::vec3(origin), glm::vec3(1.0f), glm::uvec3(Chunk::getLength()), settings, caves.data());
+                tunnelNoise_.fillGrid(glm::vec3(origin), glm::vec3(1.0f), glm::uvec3(Chunk::getLength()), settings, tunnels.data());
+            }
+
+            // Entirely below the ground and no cave to carve
+            if (origin.y + LENGTH - 1 <= column->minHeight && !hasCaves) {
+                chunk.fill(blocks_.stone);
+                return;
+            }
+
+            chunk.fill(Voxel());
+
+            for (int32_t z = 0; z < LENGTH; ++z) {
+                for (int32_t x = 0; x < LENGTH; ++x) {
+                    const int32_t height = column->heights[x + z * LENGTH];
+
+                    for (int32_t y = 0; y < LENGTH; ++y) {
+                        const int32_t worldY = origin.y + y;
+                        if (worldY > height) {
+                            break;
+                        }
+
+                        // Worm-like caves where both noises are close to zero
+                        if (hasCaves && worldY <= height - CAVE_ROOF) {
+                            const size_t index = x + y * LENGTH + z * LENGTH * LENGTH;
+                            const float a = caves[index];
+                            const float b = tunnels[index];
+                            if (a * a + b * b < 0.006f) {
+                                continue;
+                            }
+                        }
+
+                        chunk.setVoxelUnchecked(x, y, z, blocks_.stone);
+                    }
+                }
+            }
+        }
+
+        void WorldGenerator::decorateSurface(const ChunkCoord& coord, Chunk& chunk) const {
+            const std::shared_ptr<const ColumnData> column = getColumn(coord.x, coord.z);
+            const glm::ivec3 origin = coord.getOrigin();
+
+            // No surface within this chunk
+            if (origin.y > column->maxHeight || origin.y + LENGTH - 1 < column->minHeight - SOIL_DEPTH) {
+                return;
+            }
+
+            for (int32_t z = 0; z < LENGTH; ++z) {
+                for (int32_t x = 0; x < LENGTH; ++x) {
+                    const int32_t height = column->heights[x + z * LENGTH];
+                    const Biome biome = column->biomes[x + z * LENGTH];
+
+                    if (biome == Biome::Mountains && height >= SNOW_LINE) {
+                        continue;
+                    }
+
+                    const int32_t top = std::min(height - origin.y, LENGTH - 1);
+                    const int32_t bottom = std::max(height - SOIL_DEPTH - origin.y, 0);
+
+                    for (int32_t y = bottom; y <= top; ++y) {
+                        if (chunk.getVoxelUnchecked(x, y, z) != blocks_.stone) {
+                            continue;
+                        }
+
+                        Voxel voxel = blocks_.dirt;
+                        if (biome == Biome::Desert) {
+                            voxel = blocks_.sand;
+                        }
+                        else if (origin.y + y == height) {
+                            voxel = blocks_.grass;
+                        }
+
+                        chunk.setVoxelUnchecked(x, y, z, voxel);
+                    }
+                }
+            }
+        }
+
+        void WorldGenerator::placeFeatures(const ChunkCoord& coord, Chunk& chunk) const {
+            const glm::ivec3 origin = coord.getOrigin();
+
+            std::vector<Tree> trees;
+            findTrees(glm::ivec2(origin.x, origin.z) - TREE_RADIUS, glm::ivec2(origin.x, origin.z) + (LENGTH - 1 + TREE_RADIUS), trees);
+
+            auto place = [&](const glm::ivec3& world, const Voxel& voxel, bool onlyAir) {
+                const glm::ivec3 local = world - origin;
+                if (local.x < 0 || local.y < 0 || local.z < 0 || local.x >= LENGTH || local.y >= LENGTH || local.z >= LENGTH) {
+                    return;
+                }
+                if (onlyAir && !chunk.getVoxelUnchecked(local.x, local.y, local.z).isAir()) {
+                    return;
+                }
+                chunk.setVoxelUnchecked(local.x, local.y, local.z, voxel);
+            };
+
+            // Leaves only fill air and logs overwrite leaves, so overlapping trees give the same
+            // result whatever the order they are placed in
+            for (const Tree& tree : trees) {
+                const int32_t top = tree.base.y + tree.trunkHeight - 1;
+
+                if (top + 1 < origin.y || tree.base.y > origin.y + LENGTH - 1) {
+                    continue;
+                }
+
+                for (int32_t dy = -2; dy <= 1; ++dy) {
+                    const int32_t radius = (dy < 0) ? TREE_RADIUS : 1;
+
+                    for (int32_t dz = -radius; dz <= radius; ++dz) {
+                        for (int32_t dx = -radius; dx <= radius; ++dx) {
+                            // Round the canopy off
+                            if (std::abs(dx) == radius && std::abs(dz) == radius && (dy == 1 || radius == TREE_RADIUS)) {
+                                continue;
+                            }
+                            place(glm::ivec3(tree.base.x + dx, top + dy, tree.base.z + dz), blocks_.leaves, true);
+                        }
+                    }
+                }
+
+                for (int32_t y = 0; y < tree.trunkHeight; ++y) {
+                    place(tree.base + glm::ivec3(0, y, 0), blocks_.log, false);
+                }
+            }
+        }
+
+        void WorldGenerator::setColumnCacheCapacity(size_t capacity) {
+            std::lock_guard<std::mutex> lock(columnsMutex_);
+            columnCapacity_ = std::max<size_t>(capacity, 1);
+        }
+
+        uint32_t WorldGenerator::getSeed() const noexcept {
+            return seed_;
+        }
+
+        std::shared_ptr<ColumnData> WorldGenerator::computeColumn(int32_t x, int32_t z) const {
+            auto column = std::make_shared<ColumnData>();
+            computeSurface(glm::ivec2(x * LENGTH, z * LENGTH), *column);
+
+            const auto [low, high] = std::minmax_element(column->heights.begin(), column->heights.end());
+            column->minHeight = *low;
+            column->maxHeight = *high;
+
+            return column;
+        }
+
+        void WorldGenerator::computeSurface(const glm::ivec2& origin, ColumnData& column) const {
+            constexpr uint32_t AREA = ColumnData::AREA;
+
+            const glm::vec2 start(origin);
+            const glm::vec2 step(1.0f);
+            const glm::uvec2 size(Chunk::getLength());
+
+            Gem::Math::FractalSettings hills;
+            hills.octaves = 4;
+            hills.frequency = 1.0f / 128.0f;
+
+            Gem::Math::FractalSettings mountains;
+            mountains.octaves = 2;
+            mountains.frequency = 1.0f / 512.0f;
+
+            Gem::Math::FractalSettings climate;
+            climate.octaves = 2;
+            climate.frequency = 1.0f / 384.0f;
+
+            std::array<float, AREA> hillValues;
+            std::array<float, AREA> mountainValues;
+            std::array<float, AREA> temperatures;
+            std::array<float, AREA> moistures;
+
+            heightNoise_.fillGrid(start, step, size, hills, hillValues.data());
+            mountainNoise_.fillGrid(start, step, size, mountains, mountainValues.data());
+            temperatureNoise_.fillGrid(start, step, size, climate, temperatures.data());
+            moistureNoise_.fillGrid(start, step, size, climate, moistures.data());
+
+            for (uint32_t i = 0; i < AREA; ++i) {
+                const float mountain = smoothstep(0.1f, 0.5f, mountainValues[i]);
+                const float height = SEA_LEVEL + hillValues[i] * 12.0f + mountain * 48.0f * (0.75f + 0.25f * hillValues[i]);
+
+                column.heights[i] = static_cast<int32_t>(std::floor(height));
+
+                if (mountain > 0.4f) {
+                    column.biomes[i] = Biome::Mountains;
+                }
+                else if (temperatures[i] > 0.2f && moistures[i] < 0.1f) {
+                    column.biomes[i] = Biome::Desert;
+                }
+                else if (moistures[i] > 0.1f) {
+                    column.biomes[i] = Biome::Forest;
+                }
+                else {
+                    column.biomes[i] = Biome::Plains;
+                }
+            }
+        }
+
+        std::pair<int32_t, Biome> WorldGenerator::getSurface(int32_t x, int32_t z) const {
+            const int32_t chunkX = ChunkCoord::floorDiv(x, LENGTH);
+            const int32_t chunkZ = ChunkCoord::floorDiv(z, LENGTH);
+            const std::shared_ptr<const ColumnData> column = getColumn(chunkX, chunkZ);
+
+            const size_t index = (x - chunkX * LENGTH) + (z - chunkZ * LENGTH) * LENGTH;
+            return { column->heights[index], column->biomes[index] };
+        }
+
+        void WorldGenerator::findTrees(const glm::ivec2& min, const glm::ivec2& max, std::vector<Tree>& trees) const {
+            const int32_t firstX = ChunkCoord::floorDiv(min.x, TREE_CELL);
+            const int32_t firstZ = ChunkCoord::floorDiv(min.y, TREE_CELL);
+            const int32_t lastX = ChunkCoord::floorDiv(max.x, TREE_CELL);
+            const int32_t lastZ = ChunkCoord::floorDiv(max.y, TREE_CELL);
+
+            for (int32_t cellZ = firstZ; cellZ <= lastZ; ++cellZ) {
+                for (int32_t cellX = firstX; cellX <= lastX; ++cellX) {
+                    const uint32_t h = hash(cellX, 0, cellZ);
+
+                    // One candidate column per cell, kept off the cell border so canopies rarely merge
+                    const int32_t x = cellX * TREE_CELL + 1 + static_cast<int32_t>(h % (TREE_CELL - 2));
+                    const int32_t z = cellZ * TREE_CELL + 1 + static_cast<int32_t>((h >> 8) % (TREE_CELL - 2));
+                    if (x < min.x || x > max.x || z < min.y || z > max.y) {
+                        continue;
+                    }
+
+                    const auto [height, biome] = getSurface(x, z);
+
+                    uint32_t chance = 0;
+                    switch (biome) {
+                    case Biome::Forest: chance = 60; break;
+                    case Biome::Plains: chance = 8; break;
+                    case Biome::Mountains: chance = (height < SNOW_LINE) ? 4 : 0; break;
+                    case Biome::Desert: chance = 0; break;
+                    }
+
+                    if ((h >> 16) % 100 >= chance) {
+                        continue;
+                    }
+
+                    trees.push_back({ glm::ivec3(x, height + 1, z), 4 + static_cast<int32_t>((h >> 24) % 3) });
+                }
+            }
+        }
+
+        uint32_t WorldGenerator::hash(int32_t x, int32_t y, int32_t z) const noexcept {
+            uint32_t h = seed_ ^ (uint32_t(x) * 0x8da6b343u) ^ (uint32_t(y) * 0xd8163841u) ^ (uint32_t(z) * 0xcb1ab31fu);
+
+            // Avalanche the bits (murmur3 finaliser)
+            h ^= h >> 16;
+            h *= 0x85ebca6bu;
+            h ^= h >> 13;
+            h *= 0xc2b2ae35u;
+            h ^= h >> 16;
+            return h;
+        }
+
+    } // namespace Voxel
+} // namespace Gem
@@ -0,0 +1,40 @@
+#include <Gem/Voxel/world_view.h>
+
+namespace Gem {
+    namespace Voxel {
+
+        WorldView::WorldView(const ChunkManager& world) noexcept
+            : world_(world) {
+        }
+
+        void WorldView::getVoxels(const glm::ivec3* voxels, size_t count, Voxel* out) {
+            ChunkCoord coord{ 0, 0, 0 };
+            const Chunk* chunk = nullptr;
+            bool valid = false;
+
+            for (size_t i = 0; i < count; ++i) {
+                const ChunkCoord next = toChunk(voxels[i]);
+                if (!valid || next != coord) {
+                    coord = next;
+                    chunk = getChunk(coord);
+                    valid = true;
+                }
+
+                out[i] = chunk ? chunk->getStorage().get(toIndex(voxels[i])) : Voxel();
+            }
+        }
+
+        Chunk* WorldView::resolve(uint32_t slot, const ChunkCoord& coord) {
+            Slot& entry = slots_[slot];
+            entry.x = coord.x;
+            entry.y = coord.y;
+            entry.z = coord.z;
+            entry.chunk = world_.getChunk(coord);
+
+            resolved_ |= uint64_t(1) << slot;
+            ++lookups_;
+            return entry.chunk;
+        }
+
+    } // namespace Voxel
+} // namespace Gem
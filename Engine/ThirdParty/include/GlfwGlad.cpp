@@ -437,6 +437,10 @@ namespace Gem {
 			glVertexAttribPointer(index, size, type, normalized, stride, pointer);
 		}
 
+		void vertex_attrib_i_pointer(GLuint index, GLint size, GLenum type, GLsizei stride, const void* pointer) {
+			glVertexAttribIPointer(index, size, type, stride, pointer);
+		}
+
 		void enable_vertex_attrib_array(GLuint index) {
 			glEnableVertexAttribArray(index);
 		}
@@ -938,6 +938,19 @@ namespace Gem {
          */
         void vertex_attrib_pointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer);
 
+        /**
+         * @brief Defines an array of generic integer vertex attribute data.
+         *
+         * Like vertex_attrib_pointer(), but the values reach the shader as integers instead of being converted to floats.
+         *
+         * @param index Specifies the index of the generic vertex attribute to be modified.
+         * @param size Specifies the number of components per generic vertex attribute.
+         * @param type Specifies the data type of each component in the array (e.g., GL_UNSIGNED_INT).
+         * @param stride Specifies the byte offset between consecutive generic vertex attributes.
+         * @param pointer Specifies a pointer to the first component of the first generic vertex attribute in the array.
+         */
+        void vertex_attrib_i_pointer(GLuint index, GLint size, GLenum type, GLsizei stride, const void* pointer);
+
         /**
          * @brief Enables a generic vertex attribute array.
          *
@@ -0,0 +1,30 @@
+#version 330 core
+// Variant of default.frag for chunk meshes, sampling the texture layer of each face
+
+// Output color
+out vec4 fragment_colour;
+
+// Input from vertex shader
+in vec2 TexCoord;  // Texture coordinates passed from vertex shader
+in vec3 Normals;   // Normal vector passed from vertex shader
+flat in float Layer;  // Texture layer of the block
+in float Brightness;  // Baked light, computed per vertex
+
+// Uniforms
+uniform sampler2DArray texture_array;
+
+void main(void) {
+    vec4 textureColor = texture(texture_array, vec3(TexCoord, Layer));
+
+    // Cut-out textures such as leaves let the faces behind them show through
+    if (textureColor.a < 0.5) {
+        discard;
+    }
+
+    // Map the normal components from [-1, 1] to [0, 1] and blend a little of it in, like default.frag
+    vec3 normalColor = (normalize(Normals) + 1.0) / 2.0;
+    vec3 finalColor = mix(textureColor.rgb, normalColor, 0.3);
+
+    // Set the fragment color with alpha = 1 (fully opaque), darkened by the baked light
+    fragment_colour = vec4(finalColor * Brightness, 1.0);
+}
@@ -0,0 +1,42 @@
+#version 330
+// Variant of default.vert for the cube faces of chunk meshes, whose vertices are packed into a single integer (see ChunkVertex)
+
+layout(location = 0) in uint aPacked; // position, face, occlusion, light and texture layer
+
+uniform mat4 viewMatrix;
+uniform mat4 projectionMatrix;
+uniform mat4 modelMatrix;
+
+out vec2 TexCoord; // Pass texture coordinates to fragment shader
+out vec3 Normals;
+flat out float Layer; // Texture layer, the same for the whole face
+out float Brightness; // Light level turned into a colour multiplier, interpolated across the face
+
+// Indexed by face: +x, -x, +y, -y, +z, -z
+const vec3 NORMALS[6] = vec3[6](
+	vec3(1.0, 0.0, 0.0), vec3(-1.0, 0.0, 0.0),
+	vec3(0.0, 1.0, 0.0), vec3(0.0, -1.0, 0.0),
+	vec3(0.0, 0.0, 1.0), vec3(0.0, 0.0, -1.0)
+);
+
+void main(void) {
+	vec3 position = vec3(aPacked & 31u, (aPacked >> 5u) & 31u, (aPacked >> 10u) & 31u);
+	uint face = (aPacked >> 15u) & 7u;
+	float occlusion = float((aPacked >> 18u) & 3u) / 3.0;
+	vec2 light = vec2((aPacked >> 20u) & 15u, (aPacked >> 24u) & 15u) / 15.0;
+
+	// Texture coordinates follow world axes so merged quads tile the texture (GL_REPEAT)
+	uint axis = face / 2u;
+	TexCoord = (axis == 0u) ? position.zy : ((axis == 1u) ? position.xz : position.xy);
+	Normals = NORMALS[face];
+	Layer = float(aPacked >> 28u);
+
+	// Each level is 80% as bright as the one above, with a little ambient light so caves are not pitch black
+	float level = max(light.x, light.y);
+	Brightness = mix(0.05, 1.0, pow(0.8, 15.0 * (1.0 - level)));
+
+	// Fully occluded corners keep 40% of the light
+	Brightness *= 1.0 - 0.6 * occlusion;
+
+	gl_Position = projectionMatrix * viewMatrix * modelMatrix * vec4(position, 1.0); // set vertex position
+}
@@ -0,0 +1,43 @@
+#version 330
+// Variant of chunk.vert for the block shape quads of chunk meshes, whose vertices are packed into two integers (see ShapeVertex)
+
+layout(location = 0) in uvec2 aPacked; // position, face and occlusion, then light and texture layer
+
+uniform mat4 viewMatrix;
+uniform mat4 projectionMatrix;
+uniform mat4 modelMatrix;
+
+out vec2 TexCoord; // Pass texture coordinates to fragment shader
+out vec3 Normals;
+flat out float Layer; // Texture layer, the same for the whole face
+out float Brightness; // Light level turned into a colour multiplier, interpolated across the face
+
+// Indexed by face: +x, -x, +y, -y, +z, -z
+const vec3 NORMALS[6] = vec3[6](
+	vec3(1.0, 0.0, 0.0), vec3(-1.0, 0.0, 0.0),
+	vec3(0.0, 1.0, 0.0), vec3(0.0, -1.0, 0.0),
+	vec3(0.0, 0.0, 1.0), vec3(0.0, 0.0, -1.0)
+);
+
+void main(void) {
+	// Positions are stored in 1/16 of a voxel, so block shapes can be smaller than a voxel
+	vec3 position = vec3(aPacked.x & 511u, (aPacked.x >> 9u) & 511u, (aPacked.x >> 18u) & 511u) / 16.0;
+	uint face = (aPacked.x >> 27u) & 7u;
+	float occlusion = float(aPacked.x >> 30u) / 3.0;
+	vec2 light = vec2(aPacked.y & 15u, (aPacked.y >> 4u) & 15u) / 15.0;
+
+	// Texture coordinates follow world axes so merged quads tile the texture (GL_REPEAT)
+	uint axis = face / 2u;
+	TexCoord = (axis == 0u) ? position.zy : ((axis == 1u) ? position.xz : position.xy);
+	Normals = NORMALS[face];
+	Layer = float((aPacked.y >> 8u) & 255u);
+
+	// Each level is 80% as bright as the one above, with a little ambient light so caves are not pitch black
+	float level = max(light.x, light.y);
+	Brightness = mix(0.05, 1.0, pow(0.8, 15.0 * (1.0 - level)));
+
+	// Fully occluded corners keep 40% of the light
+	Brightness *= 1.0 - 0.6 * occlusion;
+
+	gl_Position = projectionMatrix * viewMatrix * modelMatrix * vec4(position, 1.0); // set vertex position
+}
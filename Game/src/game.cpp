@@ -95,14 +95,33 @@ Game::Game() {
 		exit(EXIT_FAILURE);
 	}
 
-	textureManager_ = std::make_unique<Gem::Graphics::Texture2DArray>(16, 16, 10);
+	// Chunk meshes use packed vertices, decoded by their own shader variants: one for cube faces, one for block shapes
+	chunkShader_ = std::make_unique<Gem::Graphics::Shader>();
+	chunkShapeShader_ = std::make_unique<Gem::Graphics::Shader>();
+	try {
+		chunkShader_->add_shader(GL_VERTEX_SHADER, "chunk.vert");
+		chunkShader_->add_shader(GL_FRAGMENT_SHADER, "chunk.frag");
+		chunkShader_->link_program();
+
+		chunkShapeShader_->add_shader(GL_VERTEX_SHADER, "chunk_shape.vert");
+		chunkShapeShader_->add_shader(GL_FRAGMENT_SHADER, "chunk.frag");
+		chunkShapeShader_->link_program();
+	}
+	catch (const std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		exit(EXIT_FAILURE);
+	}
+
+	textureManager_ = std::make_unique<Gem::Graphics::Texture2DArray>(16, 16, static_cast<GLuint>(blocks_.getTextures().size()));
 
 	textureManager_->set_wrap(GL_REPEAT);
 	textureManager_->set_min_filter(GL_NEAREST_MIPMAP_LINEAR);
 	textureManager_->set_mag_filter(GL_NEAREST);
 
-	textureManager_->add_texture("dirt.png");
-	textureManager_->add_texture("grass.png");
+	// Chunk meshes take their texture layers from the block registry, so add its textures in layer order
+	for (const std::string& texture : blocks_.getTextures()) {
+		textureManager_->add_texture(texture);
+	}
 
 	textureManager_->generate_mipmaps();
 
@@ -132,8 +151,10 @@ Game::Game() {
 	playerPosition_ = glm::vec3(0.0f, 0.0f, 2.0f);
 
 	camera_ = std::make_unique<Gem::Graphics::Camera>();
-	camera_->set_position(glm::vec3(20, 20, 20));
+	camera_->set_position(glm::vec3(20, 70, 20));
 	camera_->set_matrix_location(shader_.get());
+	camera_->set_matrix_location(chunkShader_.get());
+	camera_->set_matrix_location(chunkShapeShader_.get());
 
 	// Dont forget to set the camera to the window
 	window_->set_camera(camera_.get());
@@ -150,13 +171,76 @@ void Game::run() {
 
 	shader_->add_uniform_location("texture_array");
 	shader_->add_uniform_location("modelMatrix");
+	chunkShader_->add_uniform_location("texture_array");
+	chunkShader_->add_uniform_location("modelMatrix");
+	chunkShapeShader_->add_uniform_location("texture_array");
+	chunkShapeShader_->add_uniform_location("modelMatrix");
 
 	playerPosition_ = oldPosition_ = camera_->get_position();
 
 	networkClient_->SendPosition(playerPosition_);
 	float movementThreshold = 0.125f;
 
-	Gem::Voxel::Chunk chunk;
+	// Stream chunks around the camera and keep one renderer per resident chunk.
+	// Far chunks are drawn from 2x, 4x and 8x downsampled copies, which keeps the view distance affordable.
+	chunkManager_.setLoadRadius(12, 3);
+	chunkManager_.setMaxLoadsPerFrame(8);
+	chunkManager_.setLodDistances({ 4, 7, 10 });
+	visibilityGraph_.setRadius(12, 3);
+
+	// Generate and mesh chunks on worker threads, only the GPU upload stays on this thread
+	jobSystem_ = std::make_unique<Gem::Core::JobSystem>();
+	meshPipeline_ = std::make_unique<Gem::Voxel::ChunkMeshPipeline>(*jobSystem_, chunkManager_, &blocks_);
+	fluids_ = std::make_unique<Gem::Voxel::FluidSimulation>(chunkManager_, blocks_, jobSystem_.get());
+
+	// Light is stopped by the opaque blocks only, leaves and fluids let it through, and glowing blocks light their surroundings
+	lightEngine_.setBlockRegistry(&blocks_);
+
+	// Saved chunks are read back from the region files, the others are generated
+	chunkManager_.setBatchGenerator([this](const Gem::Voxel::ChunkManager::ChunkBatch& batch) {
+		Gem::Voxel::ChunkManager::ChunkBatch missing;
+		for (const auto& entry : batch) {
+			if (!regionStorage_.load(entry.first, *entry.second)) {
+				missing.push_back(entry);
+			}
+		}
+
+		if (!missing.empty()) {
+			jobSystem_->wait(worldGenerator_.generate(*jobSystem_, missing));
+		}
+	});
+
+	// Lighting runs on this thread, the chunks it touched are meshed once the update is done
+	chunkManager_.setLoadCallback([this](const Gem::Voxel::ChunkCoord& coord, Gem::Voxel::Chunk& chunk) {
+		storedVersions_[coord] = chunk.getVersion();
+		lightEngine_.onChunkLoaded(coord);
+		fluids_->onChunkLoaded(coord);
+	});
+
+	chunkManager_.setEditCallback([this](const glm::ivec3& voxel, const Gem::Voxel::Voxel& previous, const Gem::Voxel::Voxel& value) {
+		lightEngine_.onVoxelChanged(voxel, previous, value);
+		fluids_->onVoxelChanged(voxel, previous, value);
+	});
+
+	chunkManager_.setUnloadCallback([this](const Gem::Voxel::ChunkCoord& coord, Gem::Voxel::Chunk& chunk) {
+		// Generation is deterministic, only edited chunks need to be written
+		auto stored = storedVersions_.find(coord);
+		if (stored != storedVersions_.end()) {
+			if (stored->second != chunk.getVersion()) {
+				regionStorage_.save(coord, chunk);
+			}
+			storedVersions_.erase(stored);
+		}
+
+		meshPipeline_->remove(coord);
+		chunkRenderers_.erase(coord);
+		visibilityGraph_.remove(coord);
+	});
+
+	// The camera sits at the eyes of the player box
+	constexpr float playerEyeHeight = 1.6f;
+	playerBody_.position = camera_->get_position() - glm::vec3(0.0f, playerEyeHeight, 0.0f);
+
 	glm::mat4 model = glm::mat4(1.0f);
 
 	// Main game loop
@@ -170,6 +254,18 @@ void Game::run() {
 
 		// Update camera
 		camera_->process_inputs(window_->get_window_ptr(), window_->get_inputs(), gameTimer_.getDeltaMillis());
+
+		// Replay the camera move as a sweep of the player box so it stops against the terrain.
+		// Until the chunk around it is loaded the box follows the camera freely.
+		const glm::vec3 wanted = camera_->get_position() - glm::vec3(0.0f, playerEyeHeight, 0.0f);
+		if (chunkManager_.getChunk(Gem::Voxel::ChunkCoord::fromWorld(playerBody_.position))) {
+			physics_.move(playerBody_, wanted - playerBody_.position);
+			camera_->set_position(playerBody_.position + glm::vec3(0.0f, playerEyeHeight, 0.0f));
+		}
+		else {
+			playerBody_.position = wanted;
+		}
+
 		camera_->update_matrices();
 
 		// Get other players' positions
@@ -185,29 +281,86 @@ void Game::run() {
 		// Bind texture
 		shader_->set_uniform("texture_array", 0);
 
-		// Bind VAO
-		VAO_.bind();
+		// Load and unload chunks around the camera
+		chunkManager_.update(camera_->get_position());
 
-		// Set model matrix for player's cube
-
-		// Render chunk
-		for (size_t i = 0; i < chunk.getVolume(); i++) {
-			// Set model matrix for player's cube
-			model = glm::mat4(1.0f);
+		// Let the fluids flow at a fixed rate, catching up at most a few steps after a slow frame
+		constexpr double fluidTickMillis = 100.0;
+		fluidMillis_ = std::min(fluidMillis_ + gameTimer_.getDeltaMillis(), 4 * fluidTickMillis);
+		while (fluidMillis_ >= fluidTickMillis) {
+			fluids_->tick();
+			fluidMillis_ -= fluidTickMillis;
+		}
 
-			// Call the static function correctly
-			auto pos = Gem::Voxel::Chunk::delinearize(i);
+		// Mesh the loaded, relit and flooded chunks, the border sections of their neighbours were marked dirty as well
+		for (const Gem::Voxel::ChunkCoord& coord : lightEngine_.takeChangedChunks()) {
+			meshPipeline_->requestWithNeighbours(coord);
+		}
+		for (const Gem::Voxel::ChunkCoord& coord : fluids_->takeChangedChunks()) {
+			meshPipeline_->requestWithNeighbours(coord);
+		}
 
-			// Translate the cube to the voxel's position
-			model = glm::translate(model, glm::vec3(std::get<0>(pos), std::get<1>(pos), std::get<2>(pos)));
+		// Remesh the chunks whose level of detail changed with the camera
+		meshPipeline_->updateLod();
+
+		// Upload the meshes finished by the workers
+		meshPipeline_->processResults([this](const Gem::Voxel::ChunkCoord& coord, const Gem::Voxel::ChunkMesh& chunkMesh) {
+			auto& renderer = chunkRenderers_[coord];
+			if (!renderer) {
+				renderer = std::make_unique<Gem::Voxel::ChunkRenderer>();
+			}
+			renderer->upload(chunkMesh);
+			visibilityGraph_.set(coord, chunkMesh.visibility);
+		}, 8);
+
+		// Cull the chunks hidden behind solid rock, then those outside the view, before touching any GL state
+		chunkBounds_.clear();
+		chunkDrawList_.clear();
+		for (const Gem::Voxel::ChunkCoord& coord : visibilityGraph_.findVisible(camera_->get_position())) {
+			auto it = chunkRenderers_.find(coord);
+			if (it == chunkRenderers_.end() || (it->second->getIndexCount() == 0 && it->second->getShapeIndexCount() == 0)) {
+				continue;
+			}
+			const Gem::Voxel::ChunkRenderer* renderer = it->second.get();
+			const glm::vec3 origin(coord.getOrigin());
+			chunkBounds_.add(origin, origin + glm::vec3(static_cast<float>(Gem::Voxel::CHUNK_BOUNDARY)));
+			chunkDrawList_.emplace_back(coord, renderer);
+		}
 
-			// Set the model matrix in the shader
-			shader_->set_uniform_matrix("modelMatrix", glm::value_ptr(model), 1, GL_FALSE, GL_FLOAT_MAT4);
+		chunkVisible_.resize(chunkDrawList_.size());
+		camera_->get_frustum().cull_boxes(chunkBounds_, chunkVisible_.data());
+
+		// Render chunks, one draw call each for the cube faces, then one for the block shapes of the chunks having any
+		chunkShader_->activate();
+		chunkShader_->set_uniform("texture_array", 0);
+		for (size_t i = 0; i < chunkDrawList_.size(); ++i) {
+			if (!chunkVisible_[i]) {
+				continue;
+			}
+			const auto& [coord, renderer] = chunkDrawList_[i];
+			model = glm::translate(glm::mat4(1.0f), glm::vec3(coord.getOrigin()));
+			chunkShader_->set_uniform_matrix("modelMatrix", glm::value_ptr(model), 1, GL_FALSE, GL_FLOAT_MAT4);
+			renderer->render();
+		}
 
-			// Draw elements
-			Gem::GL::draw_elements(GL_TRIANGLES, sizeof(indices) / sizeof(GLuint), GL_UNSIGNED_INT, 0);
+		chunkShapeShader_->activate();
+		chunkShapeShader_->set_uniform("texture_array", 0);
+		for (size_t i = 0; i < chunkDrawList_.size(); ++i) {
+			const auto& [coord, renderer] = chunkDrawList_[i];
+			if (!chunkVisible_[i] || renderer->getShapeIndexCount() == 0) {
+				continue;
+			}
+			model = glm::translate(glm::mat4(1.0f), glm::vec3(coord.getOrigin()));
+			chunkShapeShader_->set_uniform_matrix("modelMatrix", glm::value_ptr(model), 1, GL_FALSE, GL_FLOAT_MAT4);
+			renderer->renderShapes();
 		}
 
+		// Back to the default shader for the player cubes
+		shader_->activate();
+
+		// Bind VAO
+		VAO_.bind();
+
 		// Render other players
 		for (const auto& player : otherPlayersPositions_) {
 			// Set model matrix for other player's cube
@@ -231,6 +384,8 @@ void Game::run() {
 Game::~Game() {
 
 	shader_->cleanup();
+	chunkShader_->cleanup();
+	chunkShapeShader_->cleanup();
 	
 	networkClient_->Stop();
 	delete networkClient_;
@@ -239,5 +394,14 @@ Game::~Game() {
 	VBO_.cleanup();
 	IBO_.cleanup();
 
+	// Release chunk GPU buffers while the context is still alive, edited chunks are queued for saving
+	chunkManager_.clear();
+	chunkRenderers_.clear();
+	regionStorage_.flush();
+
+	// Meshing jobs only read snapshots, finish them once the chunks are gone
+	meshPipeline_.reset();
+	jobSystem_.reset();
+
 	Gem::GLFW::terminate();  // GLFW cleanup is still required
 }
\ No newline at end of file
@@ -20,10 +20,22 @@
 #include <Gem/Core/timer.h>
 #include <Gem/Core/scoped_timer.h>
 
+#include <Gem/Voxel/block_registry.h>
 #include <Gem/Voxel/chunk.h>
+#include <Gem/Voxel/chunk_mesher.h>
+#include <Gem/Voxel/chunk_renderer.h>
+#include <Gem/Voxel/chunk_manager.h>
+#include <Gem/Voxel/chunk_mesh_pipeline.h>
+#include <Gem/Voxel/chunk_visibility.h>
+#include <Gem/Voxel/fluid_simulation.h>
+#include <Gem/Voxel/physics.h>
+#include <Gem/Voxel/world_generator.h>
+#include <Gem/Voxel/region_storage.h>
+#include <Gem/Voxel/light_engine.h>
 #include <Gem/Graphics/shapes/sphere.h>
 
 #include <Gem/Core/texture_binder.h>
+#include <Gem/Core/job_system.h>
 
 class Game
 {
@@ -43,11 +55,33 @@ private:
 	std::unique_ptr<Gem::Graphics::Texture2DArray> textureManager_;
 	std::unique_ptr<Gem::Core::TextureBinder> textureBinder_;
 	std::unique_ptr<Gem::Graphics::Shader> shader_;
+	std::unique_ptr<Gem::Graphics::Shader> chunkShader_;
+	std::unique_ptr<Gem::Graphics::Shader> chunkShapeShader_;
 
 	Gem::Graphics::VAO VAO_;
 	Gem::Graphics::Buffer VBO_;
 	Gem::Graphics::Buffer IBO_;
 
+	Gem::Voxel::BlockRegistry blocks_ = Gem::Voxel::BlockRegistry::createDefault();
+	Gem::Voxel::WorldGenerator worldGenerator_{ 1337 };
+	Gem::Voxel::RegionStorage regionStorage_{ "saves/world" };
+	std::unordered_map<Gem::Voxel::ChunkCoord, uint64_t, Gem::Voxel::ChunkCoordHash> storedVersions_;
+	Gem::Voxel::ChunkManager chunkManager_;
+	Gem::Voxel::LightEngine lightEngine_{ chunkManager_ };
+	std::unique_ptr<Gem::Core::JobSystem> jobSystem_;
+	std::unique_ptr<Gem::Voxel::ChunkMeshPipeline> meshPipeline_;
+	std::unique_ptr<Gem::Voxel::FluidSimulation> fluids_;
+	double fluidMillis_ = 0.0;
+	std::unordered_map<Gem::Voxel::ChunkCoord, std::unique_ptr<Gem::Voxel::ChunkRenderer>, Gem::Voxel::ChunkCoordHash> chunkRenderers_;
+	Gem::Voxel::ChunkVisibilityGraph visibilityGraph_;
+	Gem::Voxel::Physics physics_{ chunkManager_, &blocks_ };
+	Gem::Voxel::PhysicsBody playerBody_;
+
+	// Frustum culling scratch, rebuilt every frame
+	Gem::Graphics::BoundingBoxes chunkBounds_;
+	std::vector<std::pair<Gem::Voxel::ChunkCoord, const Gem::Voxel::ChunkRenderer*>> chunkDrawList_;
+	std::vector<uint8_t> chunkVisible_;
+
 	Gem::Core::Timer gameTimer_;
 
 	Network::Client* networkClient_;
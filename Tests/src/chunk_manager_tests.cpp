@@ -0,0 +1,136 @@
+#include "test.h"
+
+#include <iostream>
+#include <Gem/Voxel/chunk_manager.h>
+
+using namespace Gem::Voxel;
+
+namespace {
+
+    constexpr int32_t HORIZONTAL_RADIUS = 4;
+    constexpr int32_t VERTICAL_RADIUS = 1;
+    constexpr int32_t UNLOAD_MARGIN = 1;
+    constexpr size_t MAX_LOADS_PER_FRAME = 16;
+
+    /**
+     * Fills the chunks below y = 0 with rolling stone and leaves the others empty,
+     * so resident chunks mix uniform, surface and air chunks like real terrain.
+     */
+    void generateTerrain(const ChunkCoord& coord, Chunk& chunk) {
+        const glm::ivec3 origin = coord.getOrigin();
+
+        for (uint32_t z = 0; z < CHUNK_BOUNDARY; ++z) {
+            for (uint32_t x = 0; x < CHUNK_BOUNDARY; ++x) {
+                const int32_t wx = origin.x + static_cast<int32_t>(x);
+                const int32_t wz = origin.z + static_cast<int32_t>(z);
+                const int32_t height = ((wx * 7 + wz * 3) & 15) - 8;
+
+                for (uint32_t y = 0; y < CHUNK_BOUNDARY; ++y) {
+                    if (origin.y + static_cast<int32_t>(y) < height) {
+                        chunk.setVoxelUnchecked(x, y, z, Voxel(1));
+                    }
+                }
+            }
+        }
+    }
+
+    void setUpStreaming(ChunkManager& manager) {
+        manager.setGenerator(generateTerrain);
+        manager.setLoadRadius(HORIZONTAL_RADIUS, VERTICAL_RADIUS);
+        manager.setUnloadMargin(UNLOAD_MARGIN);
+        manager.setMaxLoadsPerFrame(MAX_LOADS_PER_FRAME);
+    }
+
+    /**
+     * Counts the chunks within a radius, the most chunks a manager may keep before unloading.
+     */
+    size_t countChunksWithin(int32_t horizontal, int32_t vertical) {
+        size_t count = 0;
+        for (int32_t dz = -horizontal; dz <= horizontal; ++dz) {
+            for (int32_t dx = -horizontal; dx <= horizontal; ++dx) {
+                if (dx * dx + dz * dz <= horizontal * horizontal) {
+                    count += 2 * vertical + 1;
+                }
+            }
+        }
+        return count;
+    }
+
+    /**
+     * Moves the camera along x one voxel per frame.
+     */
+    void walk(ChunkManager& manager, float& x, int32_t chunks) {
+        for (int32_t frame = 0; frame < chunks * CHUNK_BOUNDARY; ++frame) {
+            x += 1.0f;
+            manager.update(glm::vec3(x, 8.0f, 8.0f));
+        }
+    }
+
+} // namespace
+
+GEM_TEST(StreamingReachesASteadyStateAlongACameraPath) {
+    ChunkManager manager;
+    setUpStreaming(manager);
+
+    float x = 8.0f;
+    walk(manager, x, 2 * (HORIZONTAL_RADIUS + UNLOAD_MARGIN) + 1);
+    const ChunkManagerStats warm = manager.getStats();
+
+    walk(manager, x, 64);
+    const ChunkManagerStats steady = manager.getStats();
+
+    std::cout << "  steady state: " << steady.loadedChunks << " resident, " << steady.pooledChunks << " pooled, "
+        << steady.memoryUsage / 1024 << " KiB, " << steady.totalLoads << " loads, " << steady.totalUnloads << " unloads"
+        << std::endl;
+
+    const size_t maxResident = countChunksWithin(HORIZONTAL_RADIUS + UNLOAD_MARGIN, VERTICAL_RADIUS + UNLOAD_MARGIN);
+    GEM_CHECK(steady.loadedChunks <= maxResident);
+    GEM_CHECK_EQUAL(steady.totalLoads - steady.totalUnloads, steady.loadedChunks);
+
+    // Every frame keeps up with the walk, and the pool stops growing once the first chunks are recycled
+    GEM_CHECK_EQUAL(steady.pendingLoads, 0);
+    GEM_CHECK_EQUAL(steady.pooledChunks, warm.pooledChunks);
+    GEM_CHECK(steady.memoryUsage <= warm.memoryUsage + warm.memoryUsage / 4);
+
+    // Each chunk stepped over loads one slice of the load radius
+    const size_t slice = static_cast<size_t>(2 * HORIZONTAL_RADIUS + 1) * (2 * VERTICAL_RADIUS + 1);
+    GEM_CHECK(steady.totalLoads - warm.totalLoads <= 64 * slice);
+}
+
+GEM_TEST(StreamingDoesNotThrashAcrossAChunkBorder) {
+    ChunkManager manager;
+    setUpStreaming(manager);
+
+    for (int frame = 0; frame < 64; ++frame) {
+        manager.update(glm::vec3(8.0f, 8.0f, 8.0f));
+    }
+    manager.update(glm::vec3(-1.0f, 8.0f, 8.0f));
+    for (int frame = 0; frame < 64; ++frame) {
+        manager.update(glm::vec3(-1.0f, 8.0f, 8.0f));
+    }
+    const ChunkManagerStats settled = manager.getStats();
+
+    for (int frame = 0; frame < 256; ++frame) {
+        manager.update(glm::vec3((frame & 1) ? -1.0f : 1.0f, 8.0f, 8.0f));
+    }
+    const ChunkManagerStats after = manager.getStats();
+
+    GEM_CHECK_EQUAL(after.totalLoads, settled.totalLoads);
+    GEM_CHECK_EQUAL(after.totalUnloads, 0);
+}
+
+GEM_TEST(StreamingReleasesEveryChunkOnClear) {
+    ChunkManager manager;
+    setUpStreaming(manager);
+
+    for (int frame = 0; frame < 64; ++frame) {
+        manager.update(glm::vec3(8.0f, 8.0f, 8.0f));
+    }
+    GEM_CHECK(manager.getStats().loadedChunks > 0);
+
+    manager.clear();
+    const ChunkManagerStats stats = manager.getStats();
+    GEM_CHECK_EQUAL(stats.loadedChunks, 0);
+    GEM_CHECK_EQUAL(stats.memoryUsage, 0);
+    GEM_CHECK_EQUAL(stats.totalUnloads, stats.totalLoads);
+}
@@ -0,0 +1,157 @@
+#include "test.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <Gem/Voxel/block_registry.h>
+#include <Gem/Voxel/chunk.h>
+#include <Gem/Voxel/chunk_mesher.h>
+
+using namespace Gem::Voxel;
+
+namespace {
+
+    /**
+     * Meshes a chunk on its own, with every block drawn as an opaque cube, and returns its quad count.
+     */
+    size_t countQuads(const Chunk& chunk) {
+        ChunkMesher mesher;
+        ChunkMesh mesh;
+        mesher.mesh(chunk, mesh);
+
+        size_t quads = 0;
+        for (const ChunkMeshSection& section : mesh.sections) {
+            quads += section.getQuadCount();
+        }
+
+        GEM_CHECK_EQUAL(mesh.getTriangleCount(), 2 * quads);
+        GEM_CHECK_EQUAL(mesh.getVertexCount(), 4 * quads);
+        return quads;
+    }
+
+    void fillBox(Chunk& chunk, uint32_t x0, uint32_t y0, uint32_t z0, uint32_t x1, uint32_t y1, uint32_t z1, Voxel voxel) {
+        for (uint32_t y = y0; y < y1; ++y) {
+            for (uint32_t z = z0; z < z1; ++z) {
+                for (uint32_t x = x0; x < x1; ++x) {
+                    chunk.setVoxel(x, y, z, voxel);
+                }
+            }
+        }
+    }
+
+    constexpr uint32_t N = CHUNK_BOUNDARY;
+    constexpr uint32_t SECTIONS_PER_FACE = (N / Chunk::getSectionLength()) * (N / Chunk::getSectionLength());
+
+} // namespace
+
+GEM_TEST(MesherEmptyChunkHasNoQuads) {
+    Chunk chunk;
+    GEM_CHECK_EQUAL(countQuads(chunk), 0);
+}
+
+GEM_TEST(MesherSingleVoxelHasSixQuads) {
+    Chunk chunk;
+    chunk.setVoxel(5, 6, 7, Voxel(1));
+    GEM_CHECK_EQUAL(countQuads(chunk), 6);
+}
+
+GEM_TEST(MesherMergesFacesOfTheSameBlock) {
+    Chunk chunk;
+    fillBox(chunk, 1, 1, 1, 4, 4, 4, Voxel(1));
+    GEM_CHECK_EQUAL(countQuads(chunk), 6);
+}
+
+GEM_TEST(MesherKeepsFacesOfDifferentBlocksApart) {
+    Chunk chunk;
+    chunk.setVoxel(2, 2, 2, Voxel(1));
+    chunk.setVoxel(3, 2, 2, Voxel(2));
+
+    // The shared face is hidden, the four sides along x cannot merge across block types
+    GEM_CHECK_EQUAL(countQuads(chunk), 10);
+}
+
+GEM_TEST(MesherFullChunkHasOneQuadPerSectionFace) {
+    Chunk chunk;
+    chunk.fill(Voxel(1));
+
+    // Faces are only merged within a section, so each side of the chunk is one quad per section
+    GEM_CHECK_EQUAL(countQuads(chunk), 6 * SECTIONS_PER_FACE);
+}
+
+GEM_TEST(MesherCheckerboardIsTheWorstCase) {
+    Chunk chunk;
+    for (uint32_t y = 0; y < N; ++y) {
+        for (uint32_t z = 0; z < N; ++z) {
+            for (uint32_t x = 0; x < N; ++x) {
+                if ((x + y + z) % 2 == 0) {
+                    chunk.setVoxel(x, y, z, Voxel(1));
+                }
+            }
+        }
+    }
+
+    // No two faces of a slice touch, so every face of every voxel is its own quad
+    GEM_CHECK_EQUAL(countQuads(chunk), 6 * (N * N * N / 2));
+}
+
+GEM_TEST(MesherSlabIsMergedPerSection) {
+    Chunk chunk;
+    fillBox(chunk, 0, 0, 0, N, 1, N, Voxel(1));
+
+    // Top and bottom: one quad per section; each side: one quad per section along it
+    const uint32_t sectionsPerAxis = N / Chunk::getSectionLength();
+    GEM_CHECK_EQUAL(countQuads(chunk), 2 * SECTIONS_PER_FACE + 4 * sectionsPerAxis);
+}
+
+GEM_TEST(MesherKeepsCubesOnOneWordVertices) {
+    const BlockRegistry blocks = BlockRegistry::createDefault();
+    Chunk chunk;
+    chunk.setVoxel(2, 2, 2, Voxel(blocks.getId("stone")));
+    chunk.setVoxel(8, 2, 2, Voxel(blocks.getId("planks_slab")));
+
+    ChunkMesher mesher;
+    mesher.setBlockRegistry(&blocks);
+    ChunkMesh mesh;
+    mesher.mesh(chunk, mesh);
+
+    // The cube stays in the one-integer stream, in whole voxels
+    GEM_CHECK_EQUAL(mesh.vertices.size(), 4 * 6);
+    GEM_CHECK_EQUAL(mesh.indices.size(), 6 * 6);
+    for (uint32_t vertex : mesh.vertices) {
+        GEM_CHECK(ChunkVertex::getPosition(vertex, 0) == 2 || ChunkVertex::getPosition(vertex, 0) == 3);
+        GEM_CHECK(ChunkVertex::getPosition(vertex, 1) == 2 || ChunkVertex::getPosition(vertex, 1) == 3);
+    }
+
+    // The slab needs half-voxel positions, so it goes to the shape stream
+    GEM_CHECK(!mesh.shapeVertices.empty());
+    GEM_CHECK_EQUAL(mesh.shapeIndices.size() * 4, mesh.shapeVertices.size() * 6);
+    uint32_t top = 0;
+    for (const ShapeVertex& vertex : mesh.shapeVertices) {
+        top = std::max(top, ShapeVertex::getPosition(vertex, 1));
+    }
+    GEM_CHECK_EQUAL(top, 2 * SHAPE_RESOLUTION + SHAPE_RESOLUTION / 2);
+}
+
+GEM_TEST(MesherRefusesMoreTexturesThanCubeVerticesHold) {
+    BlockRegistry blocks = BlockRegistry::createDefault();
+    ChunkMesher mesher;
+    mesher.setBlockRegistry(&blocks);
+
+    // Fill the remaining layers, then go one past them
+    size_t extra = 0;
+    while (blocks.getTextures().size() < ChunkMesher::MAX_TEXTURES) {
+        blocks.add(BlockDefinition::cube("extra_" + std::to_string(extra), "extra_" + std::to_string(extra) + ".png"));
+        ++extra;
+    }
+    mesher.setBlockRegistry(&blocks);
+
+    blocks.add(BlockDefinition::cube("one_too_many", "one_too_many.png"));
+    bool refused = false;
+    try {
+        mesher.setBlockRegistry(&blocks);
+    }
+    catch (const std::length_error&) {
+        refused = true;
+    }
+    GEM_CHECK(refused);
+}
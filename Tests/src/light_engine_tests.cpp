@@ -0,0 +1,95 @@
+#include "test.h"
+
+#include <Gem/Voxel/block_registry.h>
+#include <Gem/Voxel/light_engine.h>
+
+using namespace Gem::Voxel;
+
+namespace {
+
+    /**
+     * Loads a column of chunks, the top one filled with a single block and the two below with air,
+     * and lights them as they load.
+     */
+    void loadColumn(ChunkManager& world, LightEngine& light, uint16_t roof) {
+        world.setGenerator([=](const ChunkCoord& coord, Chunk& chunk) {
+            if (coord.y == 0) {
+                chunk.fill(Voxel(roof));
+            }
+        });
+        world.setLoadCallback([&light](const ChunkCoord& coord, Chunk&) {
+            light.onChunkLoaded(coord);
+        });
+        world.setEditCallback([&light](const glm::ivec3& voxel, const Voxel& previous, const Voxel& value) {
+            light.onVoxelChanged(voxel, previous, value);
+        });
+        world.setLoadRadius(0, 1);
+        world.setMaxLoadsPerFrame(1000);
+        world.update(glm::vec3(8.0f, -8.0f, 8.0f));
+    }
+
+} // namespace
+
+GEM_TEST(LightPassesThroughBlocksThatAreNotOpaque) {
+    const BlockRegistry blocks = BlockRegistry::createDefault();
+
+    for (const char* name : { "leaves", "water" }) {
+        ChunkManager world;
+        LightEngine light(world);
+        light.setBlockRegistry(&blocks);
+        loadColumn(world, light, blocks.getId(name));
+
+        // A chunk full of them is not sealed, the sky shines through it
+        GEM_CHECK_EQUAL(light.getLight(LightType::Sky, glm::ivec3(8, 15, 8)), MAX_LIGHT);
+        GEM_CHECK_EQUAL(light.getLight(LightType::Sky, glm::ivec3(8, 0, 8)), MAX_LIGHT);
+        GEM_CHECK_EQUAL(light.getLight(LightType::Sky, glm::ivec3(8, -8, 8)), MAX_LIGHT);
+    }
+}
+
+GEM_TEST(LightIsStoppedByOpaqueBlocks) {
+    const BlockRegistry blocks = BlockRegistry::createDefault();
+
+    ChunkManager world;
+    LightEngine light(world);
+    light.setBlockRegistry(&blocks);
+    loadColumn(world, light, blocks.getId("stone"));
+    GEM_CHECK_EQUAL(light.getLight(LightType::Sky, glm::ivec3(8, -8, 8)), 0);
+
+    // Swapping a stone for leaves opens a shaft, swapping it back closes it
+    for (int y = 0; y < static_cast<int>(CHUNK_BOUNDARY); ++y) {
+        world.setVoxel(glm::ivec3(8, y, 8), Voxel(blocks.getId("leaves")));
+    }
+    GEM_CHECK_EQUAL(light.getLight(LightType::Sky, glm::ivec3(8, -8, 8)), MAX_LIGHT);
+    GEM_CHECK_EQUAL(light.getLight(LightType::Sky, glm::ivec3(9, -8, 8)), MAX_LIGHT - 1);
+
+    world.setVoxel(glm::ivec3(8, 0, 8), Voxel(blocks.getId("stone")));
+    GEM_CHECK_EQUAL(light.getLight(LightType::Sky, glm::ivec3(8, -8, 8)), 0);
+}
+
+GEM_TEST(LightTreatsEveryBlockAsOpaqueWithoutRegistry) {
+    const BlockRegistry blocks = BlockRegistry::createDefault();
+
+    ChunkManager world;
+    LightEngine light(world);
+    loadColumn(world, light, blocks.getId("leaves"));
+    GEM_CHECK_EQUAL(light.getLight(LightType::Sky, glm::ivec3(8, -8, 8)), 0);
+}
+
+GEM_TEST(LightGlowsFromTheRegistryEmission) {
+    const BlockRegistry blocks = BlockRegistry::createDefault();
+    const uint16_t lava = blocks.getId("lava");
+
+    ChunkManager world;
+    LightEngine light(world);
+    light.setBlockRegistry(&blocks);
+    loadColumn(world, light, blocks.getId("stone"));
+
+    // The air under the stone roof is dark until the lava lights it
+    world.setVoxel(glm::ivec3(8, -8, 8), Voxel(lava));
+    GEM_CHECK_EQUAL(light.getLight(LightType::Block, glm::ivec3(8, -8, 8)), blocks.getEmission(lava));
+    GEM_CHECK_EQUAL(light.getLight(LightType::Block, glm::ivec3(10, -8, 8)), blocks.getEmission(lava) - 2);
+    GEM_CHECK_EQUAL(light.getLight(LightType::Sky, glm::ivec3(10, -8, 8)), 0);
+
+    world.setVoxel(glm::ivec3(8, -8, 8), Voxel());
+    GEM_CHECK_EQUAL(light.getLight(LightType::Block, glm::ivec3(10, -8, 8)), 0);
+}
@@ -0,0 +1,66 @@
+#include "test.h"
+
+#include <cstring>
+#include <exception>
+#include <iostream>
+
+namespace Gem {
+    namespace Test {
+
+        namespace {
+            bool failed = false;    ///< Whether a check of the running test failed.
+        }
+
+        std::vector<TestCase>& getTests() {
+            static std::vector<TestCase> tests;
+            return tests;
+        }
+
+        void reportFailure(const char* expression, const char* file, int line) {
+            std::cerr << file << "(" << line << "): check failed: " << expression << std::endl;
+            failed = true;
+        }
+
+        void reportMismatch(const char* expression, long long actual, long long expected, const char* file, int line) {
+            std::cerr << file << "(" << line << "): check failed: " << expression
+                << " (got " << actual << ", expected " << expected << ")" << std::endl;
+            failed = true;
+        }
+
+    } // namespace Test
+} // namespace Gem
+
+/**
+ * Runs every registered test, or only those whose name contains the first argument.
+ * Returns 0 when all of them pass, 1 otherwise.
+ */
+int main(int argc, char* argv[]) {
+    const char* filter = (argc > 1) ? argv[1] : nullptr;
+
+    size_t run = 0;
+    size_t failures = 0;
+
+    for (const Gem::Test::TestCase& test : Gem::Test::getTests()) {
+        if (filter && !std::strstr(test.name, filter)) {
+            continue;
+        }
+
+        Gem::Test::failed = false;
+        try {
+            test.run();
+        }
+        catch (const std::exception& e) {
+            std::cerr << test.name << ": unexpected exception: " << e.what() << std::endl;
+            Gem::Test::failed = true;
+        }
+
+        std::cout << (Gem::Test::failed ? "[FAIL] " : "[ OK ] ") << test.name << std::endl;
+        ++run;
+        if (Gem::Test::failed) {
+            ++failures;
+        }
+    }
+
+    std::cout << run - failures << "/" << run << " tests passed" << std::endl;
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,88 @@
+#include "test.h"
+
+// The reference must not fuse products either, see Noise. Set before glm is included so its templates get it too
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#elif defined(_MSC_VER)
+#pragma fp_contract(off)
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include <glm/gtc/noise.hpp>
+#include <Gem/Math/noise.h>
+
+using namespace Gem::Math;
+
+namespace {
+
+    constexpr float TOLERANCE = 1e-5f;      ///< Rounding left once both sides keep every product rounded.
+
+    // Not a multiple of any lane width, so the batches end with a scalar tail
+    constexpr uint32_t GRID_X = 61;
+    constexpr uint32_t GRID_Y = 23;
+    constexpr uint32_t GRID_Z = 7;
+
+    /**
+     * A grid of points around the origin, spaced so they fall on and between lattice points.
+     */
+    struct Points {
+        std::vector<float> x, y, z;
+
+        Points() {
+            for (uint32_t k = 0; k < GRID_Z; ++k) {
+                for (uint32_t j = 0; j < GRID_Y; ++j) {
+                    for (uint32_t i = 0; i < GRID_X; ++i) {
+                        x.push_back(-30.0f + 0.75f * static_cast<float>(i));
+                        y.push_back(-11.0f + 0.5f * static_cast<float>(j));
+                        z.push_back(-4.5f + 1.25f * static_cast<float>(k));
+                    }
+                }
+            }
+        }
+
+        [[nodiscard]] size_t size() const noexcept { return x.size(); }
+    };
+
+    float reference(NoiseType type, const glm::vec2& position) {
+        return (type == NoiseType::Perlin) ? glm::perlin(position) : glm::simplex(position);
+    }
+
+    float reference(NoiseType type, const glm::vec3& position) {
+        return (type == NoiseType::Perlin) ? glm::perlin(position) : glm::simplex(position);
+    }
+
+} // namespace
+
+GEM_TEST(NoiseBatchesMatchGlm) {
+    const Noise noise;
+    const Points points;
+    std::vector<float> batch2(points.size());
+    std::vector<float> batch3(points.size());
+
+    std::cout << "  " << Noise::getInstructionSet() << ", " << Noise::getLaneCount() << " lanes" << std::endl;
+
+    for (NoiseType type : { NoiseType::Perlin, NoiseType::Simplex }) {
+        noise.sample(type, points.x.data(), points.y.data(), batch2.data(), points.size());
+        noise.sample(type, points.x.data(), points.y.data(), points.z.data(), batch3.data(), points.size());
+
+        // Single samples run the scalar code, batches the widest lanes then the scalar code for the tail
+        float error = 0.0f;
+        for (size_t i = 0; i < points.size(); ++i) {
+            const glm::vec2 p2(points.x[i], points.y[i]);
+            const glm::vec3 p3(points.x[i], points.y[i], points.z[i]);
+
+            error = std::max(error, std::fabs(batch2[i] - reference(type, p2)));
+            error = std::max(error, std::fabs(batch3[i] - reference(type, p3)));
+            error = std::max(error, std::fabs(noise.sample(type, p2) - reference(type, p2)));
+            error = std::max(error, std::fabs(noise.sample(type, p3) - reference(type, p3)));
+        }
+
+        std::cout << "  " << ((type == NoiseType::Perlin) ? "perlin" : "simplex") << ": max error " << error << std::endl;
+        GEM_CHECK(error <= TOLERANCE);
+    }
+}
@@ -0,0 +1,274 @@
+#include "test.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+#include <Gem/Voxel/physics.h>
+
+using namespace Gem::Voxel;
+
+namespace {
+
+    constexpr float EPSILON = 1e-3f;    ///< Contact tolerance, the same as Physics.
+
+    /**
+     * Sweeps a box along one axis by testing every collision box of every voxel around it,
+     * the brute-force reference of Physics::move().
+     */
+    float sweepBruteForce(const ChunkManager& world, const BlockRegistry* blocks, int axis,
+        const glm::vec3& min, const glm::vec3& max, float delta) {
+        if (delta == 0.0f) {
+            return 0.0f;
+        }
+
+        const int u = (axis + 1) % 3;
+        const int v = (axis + 2) % 3;
+        const glm::ivec3 centre(glm::floor((min + max) * 0.5f));
+
+        for (int z = -8; z <= 8; ++z) {
+            for (int y = -8; y <= 8; ++y) {
+                for (int x = -8; x <= 8; ++x) {
+                    const glm::ivec3 voxel = centre + glm::ivec3(x, y, z);
+
+                    std::vector<std::pair<glm::vec3, glm::vec3>> boxes;
+                    if (!world.getChunk(ChunkCoord::fromVoxel(voxel))) {
+                        boxes.emplace_back(glm::vec3(0.0f), glm::vec3(1.0f));
+                    }
+                    else {
+                        const uint16_t id = world.getVoxel(voxel).getId();
+                        if (id == 0) {
+                            continue;
+                        }
+                        if (!blocks) {
+                            boxes.emplace_back(glm::vec3(0.0f), glm::vec3(1.0f));
+                        }
+                        else if (blocks->isSolid(id)) {
+                            for (const auto& box : blocks->getShape(id).getBoxes()) {
+                                boxes.emplace_back(glm::vec3(box.min) / float(SHAPE_RESOLUTION), glm::vec3(box.max) / float(SHAPE_RESOLUTION));
+                            }
+                        }
+                    }
+
+                    for (const auto& [boxMin, boxMax] : boxes) {
+                        const glm::vec3 low = glm::vec3(voxel) + boxMin;
+                        const glm::vec3 high = glm::vec3(voxel) + boxMax;
+
+                        if (low[u] >= max[u] - EPSILON || high[u] <= min[u] + EPSILON
+                            || low[v] >= max[v] - EPSILON || high[v] <= min[v] + EPSILON) {
+                            continue;
+                        }
+
+                        if (delta > 0.0f && low[axis] >= max[axis] - EPSILON) {
+                            delta = std::min(delta, std::max(low[axis] - max[axis], 0.0f));
+                        }
+                        else if (delta < 0.0f && high[axis] <= min[axis] + EPSILON) {
+                            delta = std::max(delta, std::min(high[axis] - min[axis], 0.0f));
+                        }
+                    }
+                }
+            }
+        }
+        return delta;
+    }
+
+    /**
+     * Loads the chunks around the origin: stone below y = 0, and a layer of scattered stone, slabs,
+     * stairs and water above it.
+     */
+    void loadScatteredWorld(ChunkManager& world, const BlockRegistry& blocks) {
+        const uint16_t stone = blocks.getId("stone");
+        const uint16_t slab = blocks.getId("planks_slab");
+        const uint16_t stairs = blocks.getId("planks_stairs_east");
+        const uint16_t water = blocks.getId("water");
+
+        world.setGenerator([=](const ChunkCoord& coord, Chunk& chunk) {
+            std::mt19937 random(coord.x * 31 + coord.y * 7 + coord.z * 3 + 5);
+
+            for (uint32_t z = 0; z < CHUNK_BOUNDARY; ++z) {
+                for (uint32_t y = 0; y < CHUNK_BOUNDARY; ++y) {
+                    for (uint32_t x = 0; x < CHUNK_BOUNDARY; ++x) {
+                        const int32_t worldY = coord.y * CHUNK_BOUNDARY + static_cast<int32_t>(y);
+
+                        uint16_t id = 0;
+                        if (worldY < 0) {
+                            id = stone;
+                        }
+                        else if (worldY < 6) {
+                            const uint32_t pick = random() % 30;
+                            id = (pick == 0) ? stone : (pick == 1) ? slab : (pick == 2) ? water : (pick == 3) ? stairs : 0;
+                        }
+
+                        if (id != 0) {
+                            chunk.setVoxel(x, y, z, Voxel(id));
+                        }
+                    }
+                }
+            }
+        });
+        world.setLoadRadius(3, 1);
+        world.setMaxLoadsPerFrame(1000);
+        world.update(glm::vec3(8.0f));
+    }
+
+    /**
+     * Loads the chunks around the origin with stone below y = 0 and air above.
+     */
+    void loadFlatWorld(ChunkManager& world, uint16_t stone) {
+        world.setGenerator([=](const ChunkCoord& coord, Chunk& chunk) {
+            if (coord.y < 0) {
+                chunk.fill(Voxel(stone));
+            }
+        });
+        world.setLoadRadius(2, 1);
+        world.setMaxLoadsPerFrame(1000);
+        world.update(glm::vec3(8.0f));
+    }
+
+} // namespace
+
+GEM_TEST(PhysicsMatchesBruteForceOnRandomMoves) {
+    const BlockRegistry blocks = BlockRegistry::createDefault();
+    ChunkManager world;
+    loadScatteredWorld(world, blocks);
+
+    // Once as full cubes, once with the block shapes
+    for (const BlockRegistry* registry : { static_cast<const BlockRegistry*>(nullptr), &blocks }) {
+        const Physics physics(world, registry);
+
+        std::mt19937 random(42);
+        std::uniform_real_distribution<float> horizontal(-20.0f, 20.0f);
+        std::uniform_real_distribution<float> height(0.0f, 5.0f);
+        std::uniform_real_distribution<float> displacement(-3.0f, 3.0f);
+
+        size_t moves = 0;
+        size_t mismatches = 0;
+        for (int i = 0; i < 3000; ++i) {
+            // Draw one value per statement, argument evaluation order is unspecified
+            PhysicsBody body;
+            body.stepHeight = 0.0f;
+            body.position.x = horizontal(random);
+            body.position.y = height(random);
+            body.position.z = horizontal(random);
+
+            const glm::vec3 half(body.size.x * 0.5f, 0.0f, body.size.z * 0.5f);
+            glm::vec3 min = body.position - half;
+            glm::vec3 max = body.position + half + glm::vec3(0.0f, body.size.y, 0.0f);
+            if (physics.overlaps(min, max)) {
+                continue;
+            }
+
+            glm::vec3 delta;
+            delta.x = displacement(random);
+            delta.y = displacement(random);
+            delta.z = displacement(random);
+            if (i % 5 == 0) {
+                delta.y = 0.0f;
+            }
+
+            const glm::vec3 moved = physics.move(body, delta);
+            ++moves;
+
+            // Vertical first, then x and z, like Physics
+            glm::vec3 expected(0.0f);
+            for (int axis : { 1, 0, 2 }) {
+                expected[axis] = sweepBruteForce(world, registry, axis, min, max, delta[axis]);
+                min[axis] += expected[axis];
+                max[axis] += expected[axis];
+            }
+
+            if (!glm::all(glm::equal(moved, expected))) {
+                ++mismatches;
+            }
+            GEM_CHECK(!physics.overlaps(body.position - half, body.position + half + glm::vec3(0.0f, body.size.y, 0.0f)));
+        }
+
+        std::cout << "  " << (registry ? "shapes" : "cubes") << ": " << moves << " moves checked" << std::endl;
+        GEM_CHECK(moves > 1000);
+        GEM_CHECK_EQUAL(mismatches, 0);
+    }
+}
+
+GEM_TEST(PhysicsLandsStepsAndStopsOnWalls) {
+    const BlockRegistry blocks = BlockRegistry::createDefault();
+    const uint16_t stone = blocks.getId("stone");
+
+    ChunkManager world;
+    loadFlatWorld(world, stone);
+    world.setVoxel(glm::ivec3(5, 0, 0), Voxel(blocks.getId("planks_slab")));
+    world.setVoxel(glm::ivec3(5, 0, 3), Voxel(stone));
+
+    Physics physics(world, &blocks);
+
+    std::vector<PhysicsBody> falling(1);
+    falling[0].position = glm::vec3(0.5f, 4.0f, 0.5f);
+    for (int i = 0; i < 60; ++i) {
+        physics.step(falling, 0.05f);
+    }
+    PhysicsBody body = falling[0];
+    GEM_CHECK(body.onGround);
+    GEM_CHECK(std::abs(body.position.y) < 1e-4f);
+    GEM_CHECK(body.velocity.y == 0.0f);
+
+    // Walks up the slab
+    physics.move(body, glm::vec3(5.0f, 0.0f, 0.0f));
+    GEM_CHECK(std::abs(body.position.y - 0.5f) < 1e-4f);
+    GEM_CHECK(body.position.x == 5.5f);
+
+    // A full block is too high to step on
+    PhysicsBody walker;
+    walker.position = glm::vec3(0.5f, 0.0f, 3.5f);
+    walker.onGround = true;
+    physics.move(walker, glm::vec3(10.0f, 0.0f, 0.0f));
+    GEM_CHECK(std::abs(walker.position.x - 4.7f) < 1e-4f);
+    GEM_CHECK(walker.position.y == 0.0f);
+    GEM_CHECK(walker.collided.x);
+
+    PhysicsBody flying;
+    flying.position = glm::vec3(0.5f, 3.0f, 9.5f);
+    physics.move(flying, glm::vec3(1.0f, 0.0f, 0.0f));
+    GEM_CHECK(!flying.onGround);
+
+    // Long moves do not tunnel through the ground
+    PhysicsBody fast;
+    fast.position = glm::vec3(0.5f, 30.0f, 12.5f);
+    physics.move(fast, glm::vec3(0.0f, -100.0f, 0.0f));
+    GEM_CHECK(fast.position.y == 0.0f);
+    GEM_CHECK(fast.onGround);
+}
+
+GEM_TEST(PhysicsStepGivesTheSameResultOnJobs) {
+    const BlockRegistry blocks = BlockRegistry::createDefault();
+    ChunkManager world;
+    loadFlatWorld(world, blocks.getId("stone"));
+    Physics physics(world, &blocks);
+
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> coordinate(-30.0f, 30.0f);
+
+    std::vector<PhysicsBody> serial(2000);
+    for (PhysicsBody& body : serial) {
+        body.position.x = coordinate(random);
+        body.position.y = 2.0f;
+        body.position.z = coordinate(random);
+        body.velocity.x = coordinate(random) * 0.2f;
+        body.velocity.z = coordinate(random) * 0.2f;
+    }
+    std::vector<PhysicsBody> parallel = serial;
+
+    Gem::Core::JobSystem jobs(2);
+    for (int i = 0; i < 20; ++i) {
+        physics.step(serial, 0.05f);
+        physics.step(parallel, 0.05f, &jobs);
+    }
+
+    size_t differences = 0;
+    for (size_t i = 0; i < serial.size(); ++i) {
+        if (!glm::all(glm::equal(serial[i].position, parallel[i].position))) {
+            ++differences;
+        }
+    }
+    GEM_CHECK_EQUAL(differences, 0);
+}
@@ -0,0 +1,124 @@
+#include "test.h"
+
+#include <filesystem>
+#include <random>
+#include <vector>
+#include <Gem/Voxel/chunk_serializer.h>
+#include <Gem/Voxel/region_file.h>
+
+using namespace Gem::Voxel;
+
+namespace {
+
+    /**
+     * A region file path in the temporary directory, removed when the test ends.
+     */
+    class TemporaryRegion {
+    public:
+        explicit TemporaryRegion(const char* name)
+            : path_(std::filesystem::temp_directory_path() / name) {
+            std::filesystem::remove(path_);
+        }
+
+        ~TemporaryRegion() {
+            std::error_code error;
+            std::filesystem::remove(path_, error);
+        }
+
+        [[nodiscard]] const std::filesystem::path& getPath() const noexcept { return path_; }
+
+    private:
+        std::filesystem::path path_;
+    };
+
+    /**
+     * Fills a chunk with noise so its payload is large, and tags it with its slot.
+     */
+    std::vector<uint8_t> makePayload(uint32_t slot, Chunk& chunk) {
+        std::mt19937 random(slot);
+        for (uint32_t i = 0; i < 512; ++i) {
+            chunk.setVoxel(random() % CHUNK_BOUNDARY, random() % CHUNK_BOUNDARY, random() % CHUNK_BOUNDARY, Voxel(static_cast<uint16_t>(1 + random() % 200)));
+        }
+        chunk.setVoxel(0, 0, 0, Voxel(static_cast<uint16_t>(1000 + slot)));
+
+        std::vector<uint8_t> payload;
+        ChunkSerializer::encode(chunk, payload);
+        return payload;
+    }
+
+    ChunkCoord getChunk(uint32_t slot) {
+        const uint32_t mask = RegionFile::LENGTH - 1;
+        return { int32_t(slot & mask), int32_t((slot >> RegionFile::LENGTH_BITS) & mask), int32_t(slot >> (2 * RegionFile::LENGTH_BITS)) };
+    }
+
+} // namespace
+
+GEM_TEST(RegionFileReadsPayloadsWrittenAcrossGrowthSteps) {
+    TemporaryRegion region("gem_region_file_test.gemr");
+    constexpr uint32_t COUNT = 1024;
+
+    uint64_t lastSize = 0;
+    {
+        RegionFile file(region.getPath());
+
+        // Read each payload back right after writing it, the file grows several times meanwhile
+        for (uint32_t slot = 0; slot < COUNT; ++slot) {
+            Chunk chunk;
+            GEM_CHECK(file.write(getChunk(slot), makePayload(slot, chunk)));
+
+            Chunk restored;
+            GEM_CHECK(file.read(getChunk(slot), restored));
+            GEM_CHECK(restored.getVoxel(0, 0, 0) == Voxel(static_cast<uint16_t>(1000 + slot)));
+        }
+
+        const RegionFileStats stats = file.getStats();
+        GEM_CHECK_EQUAL(stats.chunkCount, COUNT);
+        GEM_CHECK_EQUAL(stats.deadBytes, 0);
+        GEM_CHECK(std::filesystem::file_size(region.getPath()) >= stats.fileSize);
+        lastSize = stats.fileSize;
+    }
+
+    // The spare room past the last payload is not counted once the file is opened again
+    RegionFile file(region.getPath());
+    const RegionFileStats stats = file.getStats();
+    GEM_CHECK_EQUAL(stats.chunkCount, COUNT);
+    GEM_CHECK_EQUAL(stats.fileSize, lastSize);
+    GEM_CHECK_EQUAL(stats.deadBytes, 0);
+
+    for (uint32_t slot = 0; slot < COUNT; slot += 37) {
+        Chunk restored;
+        GEM_CHECK(file.read(getChunk(slot), restored));
+        GEM_CHECK(restored.getVoxel(0, 0, 0) == Voxel(static_cast<uint16_t>(1000 + slot)));
+    }
+}
+
+GEM_TEST(RegionFileCompactsAfterRewrites) {
+    TemporaryRegion region("gem_region_compact_test.gemr");
+    RegionFile file(region.getPath());
+
+    for (int pass = 0; pass < 4; ++pass) {
+        for (uint32_t slot = 0; slot < 256; ++slot) {
+            Chunk chunk;
+            GEM_CHECK(file.write(getChunk(slot), makePayload(slot, chunk)));
+        }
+    }
+    GEM_CHECK(file.needsCompaction());
+
+    GEM_CHECK(file.compact());
+    const RegionFileStats stats = file.getStats();
+    GEM_CHECK_EQUAL(stats.deadBytes, 0);
+    GEM_CHECK_EQUAL(std::filesystem::file_size(region.getPath()), stats.fileSize);
+
+    for (uint32_t slot = 0; slot < 256; ++slot) {
+        Chunk restored;
+        GEM_CHECK(file.read(getChunk(slot), restored));
+        GEM_CHECK(restored.getVoxel(0, 0, 0) == Voxel(static_cast<uint16_t>(1000 + slot)));
+    }
+
+    // Writes after a compaction grow the file again
+    Chunk chunk;
+    GEM_CHECK(file.write(getChunk(300), makePayload(300, chunk)));
+    Chunk restored;
+    GEM_CHECK(file.read(getChunk(300), restored));
+    GEM_CHECK(restored.getVoxel(0, 0, 0) == Voxel(1300));
+}
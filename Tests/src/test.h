@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file test.h
+ * @brief Minimal test registry and check macros of the engine tests.
+ *
+ * Tests are free functions declared with GEM_TEST, registered before main() runs. A failed check
+ * reports the expression and its location and marks the running test as failed, but the test goes on,
+ * so one run lists every broken expectation.
+ */
+
+namespace Gem {
+    namespace Test {
+
+        /**
+         * @struct TestCase
+         * @brief A registered test.
+         */
+        struct TestCase {
+            const char* name;   ///< Name printed in the report and matched by the filter.
+            void (*run)();      ///< Test body.
+        };
+
+        /**
+         * @brief Gets every registered test, in registration order.
+         */
+        std::vector<TestCase>& getTests();
+
+        /**
+         * @brief Registers a test from a static initializer, see GEM_TEST.
+         */
+        struct Registrar {
+            Registrar(const char* name, void (*run)()) {
+                getTests().push_back({ name, run });
+            }
+        };
+
+        /**
+         * @brief Reports a failed check and marks the running test as failed.
+         * @param expression The source text of the check.
+         * @param file The source file of the check.
+         * @param line The source line of the check.
+         */
+        void reportFailure(const char* expression, const char* file, int line);
+
+        /**
+         * @brief Reports a failed equality check with the values compared.
+         * @param expression The source text of the check.
+         * @param actual The value computed by the test.
+         * @param expected The value the test expected.
+         * @param file The source file of the check.
+         * @param line The source line of the check.
+         */
+        void reportMismatch(const char* expression, long long actual, long long expected, const char* file, int line);
+
+    } // namespace Test
+} // namespace Gem
+
+#define GEM_TEST(name) \
+    static void name(); \
+    static const ::Gem::Test::Registrar name##Registrar_(#name, &name); \
+    static void name()
+
+#define GEM_CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            ::Gem::Test::reportFailure(#condition, __FILE__, __LINE__); \
+        } \
+    } while (0)
+
+#define GEM_CHECK_EQUAL(actual, expected) \
+    do { \
+        const long long actualValue_ = static_cast<long long>(actual); \
+        const long long expectedValue_ = static_cast<long long>(expected); \
+        if (actualValue_ != expectedValue_) { \
+            ::Gem::Test::reportMismatch(#actual " == " #expected, actualValue_, expectedValue_, __FILE__, __LINE__); \
+        } \
+    } while (0)